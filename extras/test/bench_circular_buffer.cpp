@@ -0,0 +1,95 @@
+/******************************************************************
+    @file       bench_circular_buffer.cpp
+    @brief      Times the bulk CircularBuffer operations against the per-element ones they replaced
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_CircularBuffer.h"
+#include <string.h>
+
+#define BUFFER_SIZE 8192 // As dataASCIIBuffer
+#define MESSAGE_SIZE 80 // About one ASCII inertial message
+#define BLOCK_SIZE 4096 // As a data logger block
+
+#define DRAIN_BUFFERS 16 // Filled before the drains are timed
+
+typedef CircularBuffer<char, BUFFER_SIZE> DrainBuffer;
+
+static CircularBuffer<char, BUFFER_SIZE> buffer;
+static DrainBuffer drainBuffers[DRAIN_BUFFERS];
+
+/**
+ * @brief Leaves one block in each drain buffer, wrapped around the end of the storage as it is in use
+*/
+static void fillBuffers(const char* block) {
+    for (size_t i=0; i<DRAIN_BUFFERS; i++) {
+        drainBuffers[i].clear();
+        drainBuffers[i].push(block, BLOCK_SIZE, CIRCULAR_BUFFER_OVERWRITE);
+        drainBuffers[i].push(block, BLOCK_SIZE / 2, CIRCULAR_BUFFER_OVERWRITE);
+        drainBuffers[i].consume(BLOCK_SIZE + BLOCK_SIZE / 2);
+        drainBuffers[i].push(block, BLOCK_SIZE, CIRCULAR_BUFFER_OVERWRITE);
+    }
+}
+
+int main() {
+    char message[MESSAGE_SIZE];
+    for (size_t i=0; i<sizeof(message); i++) message[i] = 'a' + i % 26;
+    static char block[BLOCK_SIZE];
+    const size_t iterations = 1 << 20;
+    volatile size_t sink = 0;
+
+    // Filling: one message at a time, draining whenever a block is ready, as sendDataMessage() and the data logger do
+    buffer.clear();
+    double pushElements = timeNanoseconds(iterations, [&]() {
+        for (size_t i=0; i<sizeof(message); i++) buffer.push(message[i]);
+        if (buffer.size() >= BLOCK_SIZE) buffer.clear();
+    });
+    buffer.clear();
+    double pushBulk = timeNanoseconds(iterations, [&]() {
+        sink = sink + buffer.push(message, sizeof(message), CIRCULAR_BUFFER_REJECT);
+        if (buffer.size() >= BLOCK_SIZE) buffer.clear();
+    });
+
+    // Draining a block to storage: shift() into a block, or copy the spans out and consume them.
+    // The buffers are filled before each timed pass, so only the drains are timed.
+    const size_t passes = 256;
+    double shiftElements = 0;
+    double spans = 0;
+    for (size_t pass=0; pass<passes; pass++) {
+        fillBuffers(block);
+        size_t k = 0;
+        shiftElements += timeNanoseconds(DRAIN_BUFFERS, [&]() {
+            DrainBuffer& source = drainBuffers[k++];
+            for (size_t i=0; i<BLOCK_SIZE; i++) block[i] = source.shift();
+            sink = sink + block[BLOCK_SIZE - 1];
+        }) / passes;
+
+        fillBuffers(block);
+        k = 0;
+        spans += timeNanoseconds(DRAIN_BUFFERS, [&]() {
+            DrainBuffer& source = drainBuffers[k++];
+            DrainBuffer::Span first, second;
+            source.spans(first, second);
+            memcpy(block, first.data, first.length);
+            memcpy(block + first.length, second.data, second.length);
+            source.consume(first.length + second.length);
+            sink = sink + block[BLOCK_SIZE - 1];
+        }) / passes;
+    }
+
+    printf("bench_circular_buffer: %d B message, push(T) loop %.1f ns, bulk push %.1f ns (%.1fx)\n",
+           MESSAGE_SIZE, pushElements, pushBulk, pushElements / pushBulk);
+    printf("bench_circular_buffer: %d B block, shift() loop %.1f ns, spans and consume %.1f ns (%.1fx)\n",
+           BLOCK_SIZE, shiftElements, spans, shiftElements / spans);
+    return 0;
+}
@@ -0,0 +1,47 @@
+/******************************************************************
+    @file       bench_column_export.cpp
+    @brief      Times exporting data logger files to column files
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "log_files.h"
+#include "xioAPI_ColumnExport.h"
+#include <thread>
+
+#define RECORDS 2000000
+#define THREADS 4
+
+int main() {
+    std::vector<RawRecord> stream = buildRecordStream(RECORDS);
+    const DataLoggerFormat formats[] = {DATA_LOGGER_FORMAT_INDEXED, DATA_LOGGER_FORMAT_COMPRESSED};
+    const char* names[] = {"indexed", "compressed"};
+    for (int f=0; f<2; f++) {
+        LogDirectory directory;
+        std::string path = writeRecordLog(directory, stream, formats[f])[0];
+        LogReader reader;
+        reader.open(path.c_str());
+        std::string prefix = directory.getPath() + "/columns";
+
+        ColumnExportStats stats;
+        exportColumns(reader, prefix.c_str(), 1, &stats); // Warm the page cache and create the files
+        double one = timeNanoseconds(1, [&]() { exportColumns(reader, prefix.c_str(), 1, &stats); });
+        double many = timeNanoseconds(1, [&]() { exportColumns(reader, prefix.c_str(), THREADS, &stats); });
+
+        uint64_t rows = 0;
+        for (size_t t=0; t<xioAPI_Types::NUM_DATA_MESSAGE_TYPES; t++) rows += stats.rows[t];
+        printf("bench_column_export: %s, %llu rows, 1 thread %.2f M rows/s, %d threads %.2f M rows/s (%u CPUs)\n",
+               names[f], (unsigned long long) rows, rows / (one * 1e-3), THREADS, rows / (many * 1e-3),
+               std::thread::hardware_concurrency());
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+/******************************************************************
+    @file       bench_command.cpp
+    @brief      Times the command parser over every API key, and the ArduinoJson path it replaced
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "command_corpus.h"
+#include "xioAPI_Command.h"
+#include <string.h>
+
+#ifdef XIOAPI_BENCH_ARDUINOJSON
+#include <ArduinoJson.h>
+
+/**
+ * @brief The command handling before the parser: deserialise, copy the key and hash it
+*/
+static uint32_t parseArduinoJson(const char* message, size_t size) {
+    StaticJsonDocument<256> doc;
+    if (deserializeJson(doc, message, size)) return 0;
+    char key[64] = {0};
+    JsonVariant value;
+    JsonObject root = doc.as<JsonObject>();
+    for (JsonPair kv : root) {
+        strncpy(key, kv.key().c_str(), sizeof(key) - 1);
+        value = kv.value();
+    }
+    uint32_t hash = 5381;
+    for (const char* c=key; *c; c++) hash = (hash << 5) + hash + (uint8_t) *c;
+    if (value.is<JsonArray>()) hash += value[0].as<float>();
+    return hash;
+}
+#endif // XIOAPI_BENCH_ARDUINOJSON
+
+int main() {
+    std::vector<CorpusEntry> corpus = buildCommandCorpus();
+    const size_t rounds = 2000;
+    char buffer[256];
+    volatile uint32_t sink = 0;
+
+    size_t next = 0;
+    double parser = timeNanoseconds(rounds * corpus.size(), [&]() {
+        const std::string& message = corpus[next++ % corpus.size()].message;
+        memcpy(buffer, message.c_str(), message.size() + 1); // The parser works in place
+        xioAPI_Command::Command command;
+        if (xioAPI_Command::parseCommand(buffer, message.size(), &command)) {
+            sink = sink + command.hash;
+            if (command.value.size() > 0) sink = sink + command.value[0].as<float>();
+        }
+    });
+    printf("bench_command: %zu messages, parseCommand %.1f ns/message\n", corpus.size(), parser);
+
+#ifdef XIOAPI_BENCH_ARDUINOJSON
+    next = 0;
+    double arduinoJson = timeNanoseconds(rounds * corpus.size(), [&]() {
+        const std::string& message = corpus[next++ % corpus.size()].message;
+        sink = sink + parseArduinoJson(message.c_str(), message.size());
+    });
+    printf("bench_command: ArduinoJson %.1f ns/message (%.1fx)\n", arduinoJson, arduinoJson / parser);
+#else
+    printf("bench_command: build with ARDUINOJSON=<path to ArduinoJson/src> to compare with ArduinoJson\n");
+#endif // XIOAPI_BENCH_ARDUINOJSON
+    return 0;
+}
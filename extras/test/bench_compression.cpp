@@ -0,0 +1,44 @@
+/******************************************************************
+    @file       bench_compression.cpp
+    @brief      Measures the compression ratio and the cost of compressing data message records
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "records.h"
+#include "xioAPI_Compression.h"
+
+int main() {
+    std::vector<RawRecord> stream = buildRecordStream(300000);
+    uint8_t block[XIOAPI_LOG_MAX_PAYLOAD_SIZE];
+    size_t rawBytes = 0, compressedBytes = 0;
+
+    xioAPI_Compression::Encoder encoder;
+    size_t used = 0, next = 0;
+    encoder.reset();
+    double encode = timeNanoseconds(stream.size(), [&]() {
+        const RawRecord& record = stream[next++];
+        size_t len = encoder.encode(record.data, record.size, block + used, sizeof(block) - used);
+        if (len == 0) { // A new log block
+            encoder.reset();
+            used = 0;
+            len = encoder.encode(record.data, record.size, block, sizeof(block));
+        }
+        used += len;
+        compressedBytes += len;
+        rawBytes += record.size;
+    });
+
+    printf("bench_compression: %zu records, %zu B raw, %zu B compressed (%.2fx), encode %.1f ns/record\n",
+           stream.size(), rawBytes, compressedBytes, (double) rawBytes / compressedBytes, encode);
+    return 0;
+}
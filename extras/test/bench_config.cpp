@@ -0,0 +1,250 @@
+/******************************************************************
+    @file       bench_config.cpp
+    @brief      Times loading the default configuration from JSON and from a binary snapshot
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_Command.h"
+#include "xioAPI_Snapshot.h"
+#include "xioAPI_SettingJSON.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string.h>
+#include <vector>
+#include <sys/stat.h>
+#ifdef XIOAPI_BENCH_ARDUINOJSON
+#include <ArduinoJson.h>
+#endif // XIOAPI_BENCH_ARDUINOJSON
+
+using namespace xioAPI_Types;
+
+#define CONFIG_PATH "../../config/config_default.json"
+#define CONFIG_CHUNK_SIZE 64 // Bytes - `XIOAPI_CONFIG_CHUNK_SIZE` of xioAPI_Settings.h, which needs the Arduino core
+
+/**
+ * @brief The value of a setting as the library stores it: a bool, a number, a string or an array of floats
+*/
+struct Setting {
+    uint32_t hash;
+    uint8_t type;
+    uint8_t size;
+    uint8_t value[64];
+};
+
+static size_t storeValue(const xioAPI_Command::CommandValue& value, uint8_t* out) {
+    switch (value.getType()) {
+        case JSON_ARRAY:
+            for (size_t i=0; i<value.size(); i++) {
+                float element = value[i].as<float>();
+                memcpy(out + 4*i, &element, 4);
+            }
+            return 4 * value.size();
+        case JSON_STRING: {
+            const char* text = value.as<const char*>();
+            size_t len = strnlen(text, 63);
+            memcpy(out, text, len);
+            out[len] = '\0';
+            return len;
+        }
+        case JSON_BOOL:
+            *out = value.as<bool>();
+            return 1;
+        default: {
+            float number = value.as<float>();
+            memcpy(out, &number, 4);
+            return 4;
+        }
+    }
+}
+
+static size_t loadJSON(const std::string& file, std::vector<Setting>* settings) {
+    xioAPI_Command::ObjectReader reader;
+    xioAPI_Command::Command member;
+    reader.reset();
+    settings->clear();
+    for (char c : file) {
+        if (!reader.read(c, &member)) continue;
+        Setting setting;
+        setting.hash = member.hash;
+        setting.type = member.value.getType();
+        setting.size = storeValue(member.value, setting.value);
+        settings->push_back(setting);
+    }
+    return settings->size();
+}
+
+#ifdef XIOAPI_BENCH_ARDUINOJSON
+static StaticJsonDocument<6144> jsonConfigDoc; // The configuration document, a global as the library kept it
+
+static size_t storeValue(JsonVariant value, uint8_t* out) {
+    if (value.is<JsonArray>()) {
+        JsonArray array = value.as<JsonArray>();
+        for (size_t i=0; i<array.size(); i++) {
+            float element = array[i].as<float>();
+            memcpy(out + 4*i, &element, 4);
+        }
+        return 4 * array.size();
+    }
+    if (value.is<const char*>()) {
+        const char* text = value.as<const char*>();
+        size_t len = strnlen(text, 63);
+        memcpy(out, text, len);
+        out[len] = '\0';
+        return len;
+    }
+    if (value.is<bool>()) {
+        *out = value.as<bool>();
+        return 1;
+    }
+    float number = value.as<float>();
+    memcpy(out, &number, 4);
+    return 4;
+}
+
+/**
+ * @brief The loading before the streaming loader: deserialise the whole file into the document, then
+ * hash each key and find its setting with a linear scan of the table
+*/
+static size_t loadArduinoJson(const std::string& file, std::vector<Setting>* settings) {
+    if (deserializeJson(jsonConfigDoc, file.data(), file.size())) return 0;
+    size_t loaded = 0;
+    JsonObject root = jsonConfigDoc.as<JsonObject>();
+    for (JsonPair kv : root) {
+        uint32_t hash = 5381;
+        for (const char* c=kv.key().c_str(); *c; c++) hash = (hash << 5) + hash + (uint8_t) *c;
+        for (Setting& setting : *settings) { // Check all keys in the table
+            if (setting.hash == hash) {
+                setting.size = storeValue(kv.value(), setting.value);
+                loaded++;
+                break;
+            }
+        }
+    }
+    return loaded;
+}
+#endif // XIOAPI_BENCH_ARDUINOJSON
+
+/**
+ * @brief Finds the size and last write time of a file, as the library checks the configuration file against the snapshot
+*/
+static bool getFileStamp(const char* path, uint32_t* size, uint32_t* stamp) {
+    struct stat info;
+    if (stat(path, &info) != 0) return false;
+    *size = info.st_size;
+    *stamp = info.st_mtime;
+    return true;
+}
+
+static size_t loadSnapshot(const uint8_t* snapshot, size_t size, std::vector<Setting>* settings) {
+    xioAPI_Snapshot::SnapshotReader reader;
+    xioAPI_Snapshot::SnapshotField field;
+    settings->clear();
+    if (!reader.open(snapshot, size)) return 0;
+
+    uint32_t fileSize, fileStamp;
+    if (!getFileStamp(CONFIG_PATH, &fileSize, &fileStamp) || fileSize != reader.getSourceSize() || fileStamp != reader.getSourceStamp()) {
+        return 0; // The snapshot is not of the current configuration file
+    }
+    while (reader.next(&field)) {
+        Setting setting;
+        setting.hash = field.hash;
+        setting.type = field.type;
+        setting.size = field.size;
+        memcpy(setting.value, field.value, field.size);
+        settings->push_back(setting);
+    }
+    return settings->size();
+}
+
+/**
+ * @brief Describes the loaded settings as a setting table, to time writing them back out
+*/
+static std::vector<settingTableEntry> buildSettingTable(std::vector<Setting>& settings) {
+    std::vector<settingTableEntry> table;
+    for (Setting& setting : settings) {
+        settingTableEntry entry = {"setting", setting.hash, setting.value, FLOAT, 0};
+        switch (setting.type) {
+            case JSON_ARRAY:    entry.type = setting.size == 12 ? VECTOR : MATRIX; break;
+            case JSON_STRING:   entry.type = CHAR_ARRAY; entry.len = sizeof(setting.value); break;
+            case JSON_BOOL:     entry.type = BOOL; break;
+            default:            break;
+        }
+        table.push_back(entry);
+    }
+    return table;
+}
+
+static bool countBytes(const char* data, size_t size, void* context) {
+    (void) data;
+    *static_cast<size_t*>(context) += size;
+    return true;
+}
+
+int main() {
+    std::ifstream in(CONFIG_PATH, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    std::string file = contents.str();
+    if (file.empty()) {
+        printf("bench_config: %s not found\n", CONFIG_PATH);
+        return 1;
+    }
+
+    std::vector<Setting> settings;
+    size_t count = loadJSON(file, &settings);
+    uint8_t snapshot[XIOAPI_SNAPSHOT_MAX_SIZE];
+    xioAPI_Snapshot::SnapshotWriter writer(snapshot, sizeof(snapshot));
+    uint32_t fileSize = 0, fileStamp = 0;
+    CHECK(getFileStamp(CONFIG_PATH, &fileSize, &fileStamp));
+    writer.setSource(fileSize, fileStamp);
+    for (const Setting& setting : settings) writer.add(setting.hash, setting.type, setting.value, setting.size);
+    size_t snapshotSize = writer.finish();
+
+    volatile size_t sink = 0;
+    double json = timeNanoseconds(20000, [&]() { sink = sink + loadJSON(file, &settings); });
+    double binary = timeNanoseconds(20000, [&]() { sink = sink + loadSnapshot(snapshot, snapshotSize, &settings); });
+    CHECK(settings.size() == count);
+
+    loadJSON(file, &settings);
+    std::vector<settingTableEntry> table = buildSettingTable(settings);
+    size_t written = 0;
+    double write = timeNanoseconds(20000, [&]() {
+        written = 0;
+        xioAPI_SettingJSON::writeConfigurationJSON(table.data(), table.size(), countBytes, &written);
+    });
+
+    printf("bench_config: %zu settings, JSON %zu B in %.2f us, snapshot %zu B and file stamp in %.2f us (%.1fx)\n",
+           count, file.size(), json / 1000, snapshotSize, binary / 1000, json / binary);
+    printf("bench_config: writing the configuration file, %zu B in %.2f us\n", written, write / 1000);
+
+#ifdef XIOAPI_BENCH_ARDUINOJSON
+    loadJSON(file, &settings);
+    size_t loaded = loadArduinoJson(file, &settings);
+    CHECK(loaded == count);
+    double arduinoJson = timeNanoseconds(20000, [&]() { sink = sink + loadArduinoJson(file, &settings); });
+    printf("bench_config: ArduinoJson document and linear table scan in %.2f us (%.1fx)\n", arduinoJson / 1000, arduinoJson / json);
+#else
+    printf("bench_config: build with ARDUINOJSON=<path to ArduinoJson/src> to compare with ArduinoJson\n");
+#endif // XIOAPI_BENCH_ARDUINOJSON
+
+    // RAM of each path on this host: the streaming loader and the snapshot only take stack while they run
+    size_t streamingStack = CONFIG_CHUNK_SIZE + sizeof(xioAPI_Command::ObjectReader) + sizeof(xioAPI_Command::Command);
+    size_t snapshotStack = XIOAPI_SNAPSHOT_MAX_SIZE + sizeof(xioAPI_Snapshot::SnapshotReader) + sizeof(xioAPI_Snapshot::SnapshotField);
+    printf("bench_config: RAM, streaming loader %zu B stack and 0 B static, snapshot %zu B stack and 0 B static\n",
+           streamingStack, snapshotStack);
+#ifdef XIOAPI_BENCH_ARDUINOJSON
+    printf("bench_config: RAM, ArduinoJson document %zu B static, for a %zu B file\n", sizeof(jsonConfigDoc), file.size());
+#endif // XIOAPI_BENCH_ARDUINOJSON
+    return testFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+/******************************************************************
+    @file       bench_data_logger.cpp
+    @brief      Times the data logger writing text and indexed log files with the POSIX storage
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "log_files.h"
+
+#define TEXT_MESSAGES 500000 // About 30 MB of ASCII inertial messages
+#define RECORDS 1000000
+
+int main() {
+    std::vector<uint8_t> text = joinMessages(buildTextMessages(TEXT_MESSAGES));
+    DataLoggerStats stats;
+    LogDirectory textDirectory;
+    double textTime = timeNanoseconds(1, [&]() {
+        writeLog(textDirectory, text, makeLoggerConfig(DATA_LOGGER_FORMAT_TEXT), &stats);
+    });
+    printf("bench_data_logger: text, %.1f MB in %u blocks, %.0f MB/s\n",
+           text.size() / 1e6, stats.blocksWritten, text.size() / (textTime * 1e-3));
+
+    std::vector<uint8_t> records;
+    for (const RawRecord& record : buildRecordStream(RECORDS)) records.insert(records.end(), record.data, record.data + record.size);
+    const DataLoggerFormat formats[] = {DATA_LOGGER_FORMAT_INDEXED, DATA_LOGGER_FORMAT_COMPRESSED};
+    const char* names[] = {"indexed", "compressed"};
+    for (int f=0; f<2; f++) {
+        LogDirectory directory;
+        double time = timeNanoseconds(1, [&]() {
+            writeLog(directory, records, makeLoggerConfig(formats[f]), &stats);
+        });
+        printf("bench_data_logger: %s, %.2f M records/s, %.0f MB/s of records, %u blocks (%.2fx)\n",
+               names[f], RECORDS / (time * 1e-3), stats.recordBytes / (time * 1e-3), stats.blocksWritten,
+               (double) stats.recordBytes / stats.payloadBytes);
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+/******************************************************************
+    @file       bench_dispatch.cpp
+    @brief      Times finding the setting of an API key with the perfect hash index and with a linear scan
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_Types.h"
+#include "xioAPI_Protocol.h"
+#include <string.h>
+
+using namespace xioAPI_Types;
+using namespace xioAPI_Protocol;
+
+#define SETTING_TABLE_SIZE 256 // As xioAPI_Settings.h
+
+static settingTableEntry settingTable[SETTING_TABLE_SIZE];
+static uint16_t settingIndex[XIOAPI_KEY_SLOTS];
+static int settingValue;
+
+/**
+ * @brief Fills the setting table with every setting key in the order of `XIOAPI_SETTING_KEYS`, which
+ * is the order of the library's table, and leaves the other entries empty
+*/
+static size_t buildSettingTable() {
+    #define XIOAPI_BENCH_SETTING(name, key) {key, name, &settingValue, INT, 0},
+    static const settingTableEntry settings[] = {
+        XIOAPI_SETTING_KEYS(XIOAPI_BENCH_SETTING)
+    };
+    #undef XIOAPI_BENCH_SETTING
+
+    size_t count = sizeof(settings) / sizeof(settings[0]);
+    memcpy(settingTable, settings, sizeof(settings));
+    return count;
+}
+
+/**
+ * @brief The lookup that `handleCommand()` and `getSettingEntry()` did before the index
+*/
+static settingTableEntry* scanSettingTable(uint32_t hash) {
+    for (size_t i=0; i<SETTING_TABLE_SIZE; i++) {
+        if (settingTable[i].key == nullptr) continue; // Check if the setting table entry is empty
+        if (settingTable[i].hash == hash) return &settingTable[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief As `indexSettingTable()`
+*/
+static void indexSettingTable() {
+    memset(settingIndex, 0, sizeof(settingIndex));
+    for (size_t i=0; i<SETTING_TABLE_SIZE; i++) {
+        if (settingTable[i].key == nullptr) continue;
+        uint32_t slot = getKeySlot(settingTable[i].hash);
+        while (settingIndex[slot] != 0) slot = (slot + 1) & (XIOAPI_KEY_SLOTS - 1);
+        settingIndex[slot] = i + 1;
+    }
+}
+
+/**
+ * @brief As `getSettingEntry(hash)`, also counting the slots probed
+*/
+static settingTableEntry* getSettingEntry(uint32_t hash, size_t* probes) {
+    for (uint32_t slot = getKeySlot(hash); settingIndex[slot] != 0; slot = (slot + 1) & (XIOAPI_KEY_SLOTS - 1)) {
+        (*probes)++;
+        settingTableEntry* entry = &settingTable[settingIndex[slot] - 1];
+        if ((uint32_t) entry->hash == hash) return entry;
+    }
+    return nullptr;
+}
+
+int main() {
+    size_t settingCount = buildSettingTable();
+    indexSettingTable();
+
+    // Both lookups agree on every key: settings are found, commands are not
+    size_t maxProbes = 0;
+    for (size_t i=0; i<NUM_API_KEYS; i++) {
+        size_t probes = 0;
+        settingTableEntry* entry = getSettingEntry(API_KEYS[i], &probes);
+        CHECK(entry == scanSettingTable(API_KEYS[i]));
+        CHECK((entry != nullptr) == (i < settingCount));
+        if (probes > maxProbes) maxProbes = probes;
+    }
+    CHECK(maxProbes <= 1);
+
+    const size_t iterations = 1 << 22;
+    volatile uintptr_t sink = 0;
+    size_t i = 0;
+    double scan = timeNanoseconds(iterations, [&]() { sink = sink + (uintptr_t) scanSettingTable(API_KEYS[i++ % NUM_API_KEYS]); });
+    i = 0;
+    size_t probes = 0;
+    double indexed = timeNanoseconds(iterations, [&]() { sink = sink + (uintptr_t) getSettingEntry(API_KEYS[i++ % NUM_API_KEYS], &probes); });
+
+    // Commands are looked up as settings first, so they paid for a whole scan
+    const APIKeyHashASCII* commands = API_KEYS + settingCount;
+    size_t commandCount = NUM_API_KEYS - settingCount;
+    i = 0;
+    double scanMiss = timeNanoseconds(iterations, [&]() { sink = sink + (uintptr_t) scanSettingTable(commands[i++ % commandCount]); });
+    i = 0;
+    double indexedMiss = timeNanoseconds(iterations, [&]() { sink = sink + (uintptr_t) getSettingEntry(commands[i++ % commandCount], &probes); });
+
+    printf("bench_dispatch: %zu keys (%zu settings), linear scan %.1f ns, index %.1f ns (%.1fx), at most %zu probe\n",
+           NUM_API_KEYS, settingCount, scan, indexed, scan / indexed, maxProbes);
+    printf("bench_dispatch: command keys, linear scan %.1f ns, index %.1f ns (%.1fx)\n",
+           scanMiss, indexedMiss, scanMiss / indexedMiss);
+    return testFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+/******************************************************************
+    @file       bench_filter.cpp
+    @brief      Times the CIC decimation filter per input sample
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_Filter.h"
+#include <stdlib.h>
+#include <vector>
+
+#define SAMPLES 4096 // Input samples, cycled through
+#define CHANNELS 6 // As the inertial message: gyroscope and accelerometer
+
+/**
+ * @brief Times `DecimationFilter::update()` and returns the time per input sample in ns
+ *
+ * @param order The filter order. 0 is the plain sample dropping of the rate divisor.
+*/
+static double timeFilter(const std::vector<float>& samples, uint8_t order, uint16_t factor) {
+    DecimationFilter filter;
+    filter.configure(order, factor, CHANNELS);
+    float out[CHANNELS];
+    volatile float sink = 0.0f;
+    size_t next = 0;
+    return timeNanoseconds(2000000, [&]() {
+        if (filter.update(&samples[next], out)) sink = sink + out[0];
+        next = (next + CHANNELS) % samples.size();
+    });
+}
+
+int main() {
+    srand(1);
+    std::vector<float> samples(SAMPLES * CHANNELS);
+    for (float& v : samples) v = rand() / (float) RAND_MAX - 0.5f;
+
+    const uint16_t factors[] = {1, 8, 40};
+    for (uint16_t factor : factors) {
+        double dropping = timeFilter(samples, 0, factor);
+        printf("bench_filter: divisor %u, %d channels, sample dropping %.1f ns/sample", factor, CHANNELS, dropping);
+        for (uint8_t order=1; order<=XIOAPI_DECIMATION_MAX_ORDER; order++) {
+            printf(", order %u %.1f ns/sample", order, timeFilter(samples, order, factor));
+        }
+        printf("\n");
+    }
+    return 0;
+}
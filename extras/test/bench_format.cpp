@@ -0,0 +1,96 @@
+/******************************************************************
+    @file       bench_format.cpp
+    @brief      Times the data message formatting against the printf format it replaced
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_Format.h"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace xioAPI_Format;
+
+#define VALUE_SETS (1 << 16)
+#define ITERATIONS (1 << 20)
+
+static std::vector<float> values;
+static volatile size_t sink = 0;
+
+/**
+ * @brief Times a message layout against the snprintf() call it replaced, over the same values,
+ * and checks that both give the same message
+ *
+ * @param layoutCall Formats a message from six values and a timestamp with the layout
+ * @param printfCall Formats the same message with the original format string
+*/
+template <typename LayoutCall, typename PrintfCall>
+static void compare(const char* name, LayoutCall layoutCall, PrintfCall printfCall) {
+    char message[InertialLayout::bufferSize]; // The largest of the layouts compared
+    char expected[sizeof(message)];
+    size_t mismatches = 0;
+    for (size_t k=0; k<VALUE_SETS; k++) {
+        const float* v = &values[k * 6];
+        size_t len = layoutCall(message, v, (uint32_t) (k * 1000));
+        if (printfCall(expected, v, (uint32_t) (k * 1000)) != (int) len || strcmp(message, expected) != 0) mismatches++;
+    }
+    CHECK(mismatches == 0);
+
+    size_t i = 0;
+    double layout = timeNanoseconds(ITERATIONS, [&]() {
+        sink = sink + layoutCall(message, &values[(i % VALUE_SETS) * 6], (uint32_t) i);
+        i++;
+    });
+    i = 0;
+    double printfTime = timeNanoseconds(ITERATIONS, [&]() {
+        sink = sink + printfCall(message, &values[(i % VALUE_SETS) * 6], (uint32_t) i);
+        i++;
+    });
+    printf("bench_format: %-13s layout %6.1f ns, snprintf %7.1f ns (%.1fx)\n", name, layout, printfTime, printfTime / layout);
+}
+
+int main() {
+    values.resize(VALUE_SETS * 6);
+    srand(1);
+    for (float& v : values) v = (rand() % 2000001 - 1000000) * 1e-3f;
+
+    // The format strings are those of the send*Message() functions before the layouts. High-g
+    // messages were added with the layouts, so theirs follows the same pattern.
+    compare("inertial",
+        [](char* out, const float* v, uint32_t t) { return InertialLayout::format(out, t, v[0], v[1], v[2], v[3], v[4], v[5]); },
+        [](char* out, const float* v, uint32_t t) { return snprintf(out, InertialLayout::bufferSize, "I,%lu,%0.4f,%0.4f,%0.4f,%0.4f,%0.4f,%0.4f",
+                                                                    (unsigned long) t, v[0], v[1], v[2], v[3], v[4], v[5]); });
+    compare("magnetometer",
+        [](char* out, const float* v, uint32_t t) { return MagnetometerLayout::format(out, t, v[0], v[1], v[2]); },
+        [](char* out, const float* v, uint32_t t) { return snprintf(out, MagnetometerLayout::bufferSize, "M,%lu,%0.4f,%0.4f,%0.4f", (unsigned long) t, v[0], v[1], v[2]); });
+    compare("high-g",
+        [](char* out, const float* v, uint32_t t) { return HighGAccelerometerLayout::format(out, t, v[0], v[1], v[2]); },
+        [](char* out, const float* v, uint32_t t) { return snprintf(out, HighGAccelerometerLayout::bufferSize, "H,%lu,%0.4f,%0.4f,%0.4f", (unsigned long) t, v[0], v[1], v[2]); });
+    compare("quaternion",
+        [](char* out, const float* v, uint32_t t) { return QuaternionLayout::format(out, t, v[0], v[1], v[2], v[3]); },
+        [](char* out, const float* v, uint32_t t) { return snprintf(out, QuaternionLayout::bufferSize, "Q,%lu,%0.4f,%0.4f,%0.4f,%0.4f", (unsigned long) t, v[0], v[1], v[2], v[3]); });
+    compare("euler",
+        [](char* out, const float* v, uint32_t t) { return EulerLayout::format(out, t, v[0], v[1], v[2]); },
+        [](char* out, const float* v, uint32_t t) { return snprintf(out, EulerLayout::bufferSize, "A,%lu,%0.4f,%0.4f,%0.4f", (unsigned long) t, v[0], v[1], v[2]); });
+    compare("temperature",
+        [](char* out, const float* v, uint32_t t) { return TemperatureLayout::format(out, t, v[0]); },
+        [](char* out, const float* v, uint32_t t) { return snprintf(out, TemperatureLayout::bufferSize, "T,%lu,%0.4f", (unsigned long) t, v[0]); });
+    compare("battery",
+        [](char* out, const float* v, uint32_t t) { return BatteryLayout::format(out, t, v[0], v[1], t % 3); },
+        [](char* out, const float* v, uint32_t t) { return snprintf(out, BatteryLayout::bufferSize, "B,%lu,%0.4f,%0.4f,%u", (unsigned long) t, v[0], v[1], t % 3); });
+    compare("rssi",
+        [](char* out, const float* v, uint32_t t) { return RSSILayout::format(out, t, v[0], v[1]); },
+        [](char* out, const float* v, uint32_t t) { return snprintf(out, RSSILayout::bufferSize, "W,%lu,%0.4f,%0.4f", (unsigned long) t, v[0], v[1]); });
+
+    return testFailures == 0 ? 0 : 1;
+}
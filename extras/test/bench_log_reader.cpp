@@ -0,0 +1,83 @@
+/******************************************************************
+    @file       bench_log_reader.cpp
+    @brief      Times scanning and range queries of data logger files with the log reader
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "log_files.h"
+#include "xioAPI_LogReader.h"
+#include <thread>
+
+#define RECORDS 2000000
+#define THREADS 4
+
+using namespace xioAPI_Protocol;
+
+/**
+ * @brief Reads every inertial sample of the file, split between `threads` threads
+ *
+ * @return The number of samples
+*/
+static size_t scanInertial(const LogReader& reader, size_t threads) {
+    std::vector<LogRange> chunks(threads);
+    size_t count = reader.split(reader.getRange(), chunks.data(), threads);
+    std::vector<size_t> samples(count, 0);
+    std::vector<std::thread> workers;
+    for (size_t c=0; c<count; c++) {
+        workers.emplace_back([&, c]() {
+            LogCursor<InertialMessage> cursor(reader, chunks[c]);
+            InertialMessage message;
+            uint64_t timestamp;
+            while (cursor.next(&message, &timestamp)) samples[c]++;
+        });
+    }
+    size_t total = 0;
+    for (size_t c=0; c<count; c++) {
+        workers[c].join();
+        total += samples[c];
+    }
+    return total;
+}
+
+int main() {
+    std::vector<RawRecord> stream = buildRecordStream(RECORDS);
+    const DataLoggerFormat formats[] = {DATA_LOGGER_FORMAT_INDEXED, DATA_LOGGER_FORMAT_COMPRESSED};
+    const char* names[] = {"indexed", "compressed"};
+    for (int f=0; f<2; f++) {
+        LogDirectory directory;
+        std::string path = writeRecordLog(directory, stream, formats[f])[0];
+        LogReader reader;
+        double open = timeNanoseconds(1, [&]() { reader.open(path.c_str()); });
+
+        size_t samples = 0;
+        scanInertial(reader, 1); // Warm the page cache
+        double one = timeNanoseconds(1, [&]() { samples = scanInertial(reader, 1); });
+        double many = timeNanoseconds(1, [&]() { samples = scanInertial(reader, THREADS); });
+
+        // Range queries of 10 ms windows
+        uint64_t first = stream.front().timestamp;
+        uint64_t span = stream.back().timestamp - first;
+        size_t i = 0;
+        volatile size_t sink = 0;
+        double query = timeNanoseconds(100000, [&]() {
+            uint64_t from = first + (i++ * 7919 * 1000ull) % span;
+            sink = sink + reader.getRange(from, from + 10000).firstBlock;
+        });
+
+        printf("bench_log_reader: %s, %zu blocks, open %.1f us, range query %.0f ns\n",
+               names[f], reader.getBlockCount(), open * 1e-3, query);
+        printf("bench_log_reader: %s, %zu inertial samples, 1 thread %.2f M samples/s, %d threads %.2f M samples/s (%u CPUs)\n",
+               names[f], samples, samples / (one * 1e-3), THREADS, samples / (many * 1e-3), std::thread::hardware_concurrency());
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+/******************************************************************
+    @file       bench_replay.cpp
+    @brief      Times replaying data logger files as fast as possible and in real time
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "log_files.h"
+#include "xioAPI_Replay.h"
+
+#define RECORDS 1000000
+#define REAL_TIME_RECORDS 1000 // 1 s at 1 kHz
+
+static LogReplay replay;
+
+static uint32_t micros() {
+    static auto start = std::chrono::steady_clock::now();
+    return (uint32_t) std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Replays a file as fast as possible
+ *
+ * @return The messages replayed per second
+*/
+static double replayFile(const std::string& path) {
+    POSIXReplaySource source;
+    source.open(path.c_str());
+    size_t count = 0;
+    double time = timeNanoseconds(1, [&]() {
+        replay.begin(&source, XIOAPI_REPLAY_SPEED_MAX);
+        ReplayMessage message;
+        while (replay.next(0, &message)) count++;
+    });
+    return count / (time * 1e-9);
+}
+
+int main() {
+    std::vector<RawRecord> stream = buildRecordStream(RECORDS);
+    LogDirectory indexedDirectory, compressedDirectory, textDirectory;
+    std::string indexed = writeRecordLog(indexedDirectory, stream, DATA_LOGGER_FORMAT_INDEXED)[0];
+    std::string compressed = writeRecordLog(compressedDirectory, stream, DATA_LOGGER_FORMAT_COMPRESSED)[0];
+    std::string text = writeLog(textDirectory, joinMessages(buildTextMessages(RECORDS)), makeLoggerConfig(DATA_LOGGER_FORMAT_TEXT))[0];
+
+    printf("bench_replay: as fast as possible, indexed %.2f M msg/s, compressed %.2f M msg/s, ASCII %.2f M msg/s\n",
+           replayFile(indexed) * 1e-6, replayFile(compressed) * 1e-6, replayFile(text) * 1e-6);
+
+    // Real time, polled in a busy loop with the microsecond clock
+    std::vector<RawRecord> samples(stream.begin(), stream.begin() + REAL_TIME_RECORDS);
+    LogDirectory realTimeDirectory;
+    std::string path = writeRecordLog(realTimeDirectory, samples, DATA_LOGGER_FORMAT_COMPRESSED)[0];
+    POSIXReplaySource source;
+    source.open(path.c_str());
+    replay.begin(&source, 1.0f);
+    ReplayMessage message;
+    while (replay.isRunning()) replay.next(micros(), &message);
+    const ReplayStats& stats = replay.getStats();
+    printf("bench_replay: real time, %u messages of a 1 kHz log, %.1f msg/s, worst lag %.1f us\n",
+           stats.messages, replay.getMessageRate(), (double) stats.lag);
+    return stats.messages == REAL_TIME_RECORDS ? 0 : 1;
+}
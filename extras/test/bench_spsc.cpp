@@ -0,0 +1,89 @@
+/******************************************************************
+    @file       bench_spsc.cpp
+    @brief      Measures the throughput of the SPSC circular buffer between a producer and a consumer thread
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_SPSCBuffer.h"
+#include <thread>
+
+#define BUFFER_SIZE 8192 // As dataASCIIBuffer
+#define MESSAGE_SIZE 80 // About one ASCII inertial message
+
+static SPSCCircularBuffer<char, BUFFER_SIZE> buffer;
+
+/**
+ * @brief Moves `bytes` bytes from a producer thread to the calling thread, and returns the time taken in ns
+ *
+ * @param bulk Push whole messages and drain through spans, as the data logger does, instead of one char at a time
+*/
+static double transfer(size_t bytes, bool bulk) {
+    char message[MESSAGE_SIZE];
+    for (size_t i=0; i<sizeof(message); i++) message[i] = 'a' + i % 26;
+    buffer.clear();
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&]() {
+        size_t sent = 0;
+        while (sent < bytes) {
+            if (bulk) {
+                if (buffer.push(message, sizeof(message), CIRCULAR_BUFFER_REJECT) == 0) sent += sizeof(message);
+                else std::this_thread::yield();
+            }
+            else {
+                for (size_t i=0; i<sizeof(message); ) {
+                    if (buffer.push(message[i])) i++;
+                    else std::this_thread::yield();
+                }
+                sent += sizeof(message);
+            }
+        }
+    });
+
+    size_t received = 0;
+    volatile char sink = 0;
+    while (received < bytes) {
+        if (bulk) {
+            SPSCCircularBuffer<char, BUFFER_SIZE>::Span first, second;
+            size_t n = buffer.spans(first, second);
+            if (n == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            sink = sink + first.data[0];
+            buffer.consume(n);
+            received += n;
+        }
+        else {
+            char c;
+            if (buffer.shift(c)) {
+                sink = sink + c;
+                received++;
+            }
+            else std::this_thread::yield();
+        }
+    }
+    producer.join();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+int main() {
+    const size_t bytes = (size_t) MESSAGE_SIZE * 500000;
+    double single = transfer(bytes, false);
+    double bulk = transfer(bytes, true);
+
+    printf("bench_spsc: %zu B between two threads (%u CPUs), push/shift %.1f MB/s, bulk push/spans %.1f MB/s (%.1fx)\n",
+           bytes, std::thread::hardware_concurrency(), bytes * 1e3 / single, bytes * 1e3 / bulk, single / bulk);
+    return 0;
+}
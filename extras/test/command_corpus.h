@@ -0,0 +1,65 @@
+/******************************************************************
+    @file       command_corpus.h
+    @brief      Command messages built from every API key, for the parser tests and benchmark
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_COMMAND_CORPUS_H
+#define XIOAPI_COMMAND_CORPUS_H
+
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include "xioAPI_Types.h"
+#include "xioAPI_Protocol.h"
+
+struct CorpusEntry {
+    const char* key;
+    uint32_t hash;
+    std::string message;
+};
+
+/**
+ * @brief Builds a message for each API key with each form of value that the protocol uses
+*/
+inline std::vector<CorpusEntry> buildCommandCorpus() {
+    struct Key { const char* key; uint32_t hash; };
+    #define XIOAPI_CORPUS_KEY(name, key) {key, xioAPI_Protocol::name},
+    static const Key keys[] = {
+        XIOAPI_SETTING_KEYS(XIOAPI_CORPUS_KEY)
+        XIOAPI_COMMAND_KEYS(XIOAPI_CORPUS_KEY)
+    };
+    #undef XIOAPI_CORPUS_KEY
+
+    static const char* values[] = {
+        "null",
+        "1",
+        "-2.5",
+        "true",
+        "\"x-IMU3 \\\"Thetis\\\" \\u00e9\"",
+        "[1.0, -2.5, 3e-1]",
+        "[1,0,0,0,1,0,0,0,1]",
+    };
+
+    std::vector<CorpusEntry> corpus;
+    for (const Key& key : keys) {
+        for (const char* value : values) {
+            char message[256];
+            snprintf(message, sizeof(message), "{\"%s\":%s}", key.key, value);
+            corpus.push_back({key.key, key.hash, message});
+        }
+    }
+    return corpus;
+}
+
+#endif // XIOAPI_COMMAND_CORPUS_H
@@ -0,0 +1,165 @@
+/******************************************************************
+    @file       log_files.h
+    @brief      Writes data logger files to a temporary directory, for the log file round trip tests
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_TEST_LOG_FILES_H
+#define XIOAPI_TEST_LOG_FILES_H
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "records.h"
+#include "xioAPI_DataLogger.h"
+
+#define LOG_FILES_CHUNK_SIZE 1000 // Bytes passed to each DataLogger::write(), so records and lines are split between calls
+
+/**
+ * @brief A temporary directory that is removed with the files in it
+*/
+class LogDirectory {
+public:
+    LogDirectory() {
+        char path[] = "/tmp/xioapi_test_XXXXXX";
+        if (mkdtemp(path) != nullptr) _path = path;
+    }
+
+    ~LogDirectory() {
+        DIR* dir = opendir(_path.c_str());
+        if (dir == nullptr) return;
+        while (struct dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') unlink((_path + "/" + entry->d_name).c_str());
+        }
+        closedir(dir);
+        rmdir(_path.c_str());
+    }
+
+    const std::string& getPath() const { return _path; }
+
+private:
+    std::string _path;
+};
+
+/**
+ * @brief The settings snapshot written to the header of each indexed log file
+*/
+inline const std::vector<uint8_t>& getLogSettings() {
+    static std::vector<uint8_t> settings;
+    if (settings.empty()) {
+        for (size_t i=0; i<300; i++) settings.push_back((uint8_t) (i * 7 + 1));
+    }
+    return settings;
+}
+
+inline DataLoggerConfig makeLoggerConfig(DataLoggerFormat format, uint32_t maxFileSize=0, uint32_t maxFilePeriod=0) {
+    const std::vector<uint8_t>& settings = getLogSettings();
+    DataLoggerConfig config;
+    config.format = format;
+    config.fileNamePrefix = "log";
+    config.fileNameTimeEnabled = false;
+    config.fileNameCounterEnabled = true;
+    config.maxFileSize = maxFileSize;
+    config.maxFilePeriod = maxFilePeriod;
+    config.fileExtension = format == DATA_LOGGER_FORMAT_TEXT ? ".txt" : ".bin";
+    config.getTime = nullptr;
+    config.settings = settings.data();
+    config.settingsSize = settings.size();
+    return config;
+}
+
+/**
+ * @brief Logs a byte stream with the POSIX storage in `LOG_FILES_CHUNK_SIZE` pieces, as
+ * `serviceDataLogger()` drains the data message buffer
+ *
+ * @param directory An empty directory, so the files are numbered from 1
+ *
+ * @return The paths of the files written, in order
+*/
+inline std::vector<std::string> writeLog(const LogDirectory& directory, const std::vector<uint8_t>& data, const DataLoggerConfig& config,
+                                         DataLoggerStats* stats=nullptr) {
+    POSIXDataLoggerStorage storage(directory.getPath().c_str());
+    std::unique_ptr<DataLogger> logger(new DataLogger()); // A new logger, as the statistics are kept across begin()
+    logger->begin(&storage);
+
+    uint32_t now = 0;
+    for (size_t offset=0; offset < data.size(); ) {
+        size_t n = data.size() - offset < LOG_FILES_CHUNK_SIZE ? data.size() - offset : LOG_FILES_CHUNK_SIZE;
+        offset += logger->write(data.data() + offset, n, config, now);
+        logger->service(config, now);
+    }
+    logger->stop(config, now);
+    if (stats != nullptr) *stats = logger->getStats();
+
+    std::vector<std::string> paths;
+    for (uint32_t i=1; i<=logger->getStats().filesOpened; i++) {
+        char name[XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH];
+        snprintf(name, sizeof(name), "/%s_%04u%s", config.fileNamePrefix, i, config.fileExtension);
+        paths.push_back(directory.getPath() + name);
+    }
+    return paths;
+}
+
+/**
+ * @brief Builds `count` ASCII inertial messages at 1 kHz, of varying length. The 32-bit timestamps
+ * wrap part way through.
+*/
+inline std::vector<std::string> buildTextMessages(size_t count) {
+    srand(5);
+    std::vector<std::string> messages;
+    char line[128];
+    for (size_t i=0; i<count; i++) {
+        uint32_t t = 0xFFFF0000u + i * 1000;
+        double phase = i * 0.001;
+        snprintf(line, sizeof(line), "I,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\r\n", t,
+                 sin(phase * 3) * 500, sensorNoise(), sensorNoise(), sin(phase), cos(phase), 1 + sensorNoise());
+        messages.push_back(line);
+    }
+    return messages;
+}
+
+inline std::vector<uint8_t> joinMessages(const std::vector<std::string>& messages) {
+    std::vector<uint8_t> data;
+    for (const std::string& message : messages) data.insert(data.end(), message.begin(), message.end());
+    return data;
+}
+
+/**
+ * @brief Logs raw records in the indexed or compressed format
+*/
+inline std::vector<std::string> writeRecordLog(const LogDirectory& directory, const std::vector<RawRecord>& stream, DataLoggerFormat format,
+                                               uint32_t maxFileSize=0, DataLoggerStats* stats=nullptr) {
+    std::vector<uint8_t> data;
+    for (const RawRecord& record : stream) data.insert(data.end(), record.data, record.data + record.size);
+    return writeLog(directory, data, makeLoggerConfig(format, maxFileSize), stats);
+}
+
+/**
+ * @brief Reads a whole file
+*/
+inline std::vector<uint8_t> readFile(const std::string& path) {
+    std::vector<uint8_t> data;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) return data;
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) data.insert(data.end(), buffer, buffer + n);
+    fclose(file);
+    return data;
+}
+
+#endif // XIOAPI_TEST_LOG_FILES_H
@@ -0,0 +1,90 @@
+/******************************************************************
+    @file       records.h
+    @brief      A synthetic stream of data message records, for the log and compression tests
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_TEST_RECORDS_H
+#define XIOAPI_TEST_RECORDS_H
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "xioAPI_Binary.h"
+#include "xioAPI_Log.h"
+
+struct RawRecord {
+    uint8_t data[XIOAPI_BINARY_MAX_RAW_SIZE];
+    size_t size;
+    uint64_t timestamp;
+};
+
+inline float sensorNoise() { return (rand() % 2001 - 1000) * 1e-4f; }
+
+/**
+ * @brief Builds `count` records of slowly varying sensor data at 1 kHz, in the mix of message
+ * types that a device sends. The 32-bit timestamps wrap part way through.
+*/
+inline std::vector<RawRecord> buildRecordStream(size_t count, std::vector<xioAPI_Protocol::DataMessageRecord>* messages=nullptr) {
+    using namespace xioAPI_Types;
+    using namespace xioAPI_Protocol;
+    srand(3);
+    std::vector<RawRecord> stream;
+    xioAPI_Log::TimestampExtender extender;
+    for (size_t i=0; i<count; i++) {
+        DataMessageRecord record;
+        memset(&record, 0, sizeof(record));
+        uint32_t t = 0xFFFF0000u + i * 1000;
+        double phase = i * 0.001;
+        switch (i % 10) {
+            case 1: case 5:
+                record.type = QUATERNION_MESSAGE;
+                record.quaternion = {(float) cos(phase/2), (float) sin(phase/2), 0.001f * sensorNoise(), 0.0f, t};
+                break;
+            case 3:
+                record.type = MAGNETOMETER_MESSAGE;
+                record.magnetometer = {(float) (30*cos(phase)) + sensorNoise(), (float) (20*sin(phase)), -40 + sensorNoise(), t};
+                break;
+            case 7:
+                record.type = EULER_MESSAGE;
+                record.euler = {(float) (180*sin(phase)), sensorNoise(), (float) (90*cos(phase)), t};
+                break;
+            case 9:
+                if (i % 20 == 9) {
+                    record.type = TEMPERATURE_MESSAGE;
+                    record.temperature = {25.5f + sensorNoise(), t};
+                }
+                else {
+                    record.type = BATTERY_MESSAGE;
+                    record.battery = {87.5f, 3.9f + sensorNoise(), CHARGING, t};
+                }
+                break;
+            default:
+                record.type = INERTIAL_MESSAGE;
+                record.inertial = {(float) sin(phase) + sensorNoise(), (float) cos(phase) + sensorNoise(), 1 + sensorNoise(),
+                                   (float) (50*sin(phase*3)) + sensorNoise(), sensorNoise(), sensorNoise(), t};
+                break;
+        }
+
+        RawRecord raw;
+        raw.size = xioAPI_Binary::encodeRawRecord(raw.data, sizeof(raw.data), record);
+        raw.timestamp = extender.extend(t);
+        xioAPI_Log::setRecordTimestamp(raw.data, raw.size, raw.timestamp);
+        stream.push_back(raw);
+        if (messages != nullptr) messages->push_back(record);
+    }
+    return stream;
+}
+
+#endif // XIOAPI_TEST_RECORDS_H
@@ -0,0 +1,51 @@
+/******************************************************************
+    @file       test.h
+    @brief      Minimal checks and timing for the xio API host tests
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_TEST_H
+#define XIOAPI_TEST_H
+
+#include <stdio.h>
+#include <chrono>
+
+static int testFailures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        testFailures++; \
+    } \
+} while (0)
+
+/**
+ * @brief Prints the result of a test program and returns its exit code
+*/
+inline int testResult(const char* name) {
+    printf("%s: %s\n", name, testFailures == 0 ? "passed" : "FAILED");
+    return testFailures == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Returns the mean time of `fn()` in nanoseconds over `iterations` calls
+*/
+template <typename Function>
+double timeNanoseconds(size_t iterations, Function fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i=0; i<iterations; i++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+#endif // XIOAPI_TEST_H
@@ -0,0 +1,74 @@
+/******************************************************************
+    @file       test_binary.cpp
+    @brief      Host tests of the binary data message frames and raw records
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_Binary.h"
+#include <stdlib.h>
+
+using namespace xioAPI_Binary;
+using namespace xioAPI_Types;
+using namespace xioAPI_Protocol;
+
+int main() {
+    srand(1);
+
+    // Random inertial messages survive framing, never contain LF or CR, and fail their CRC when corrupted
+    for (int k=0; k<20000; k++) {
+        InertialMessage msg;
+        uint32_t words[sizeof(InertialMessage) / 4];
+        for (uint32_t& w : words) w = rand() ^ (rand() << 16);
+        memcpy(&msg, words, sizeof(msg));
+        if (k % 3 == 0) msg.timestamp = 0x0A0D0ADB; // Every byte needs stuffing
+
+        uint8_t frame[XIOAPI_BINARY_MAX_FRAME_SIZE];
+        size_t len = encodeInertialMessage(frame, sizeof(frame), msg);
+        CHECK(len > 0 && frame[len - 1] == XIOAPI_BINARY_FRAME_END);
+        for (size_t i=0; i+1<len; i++) CHECK(frame[i] != 0x0A && frame[i] != 0x0D);
+
+        uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+        InertialMessage decoded;
+        CHECK(decodeInertialMessage(raw, decodeFrame(frame, len, raw, sizeof(raw)), &decoded));
+        CHECK(memcmp(&decoded, &msg, sizeof(msg)) == 0);
+
+        frame[len / 2] ^= 0x01;
+        size_t rawLen = decodeFrame(frame, len, raw, sizeof(raw));
+        CHECK(rawLen == 0 || !decodeInertialMessage(raw, rawLen, &decoded) || memcmp(&decoded, &msg, sizeof(msg)) != 0);
+    }
+
+    // Messages with non-float fields
+    BatteryMessage battery = {50.5f, 3.7f, CHARGING, 123};
+    uint8_t frame[XIOAPI_BINARY_MAX_FRAME_SIZE];
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    BatteryMessage decodedBattery;
+    size_t len = encodeBatteryMessage(frame, sizeof(frame), battery);
+    CHECK(decodeBatteryMessage(raw, decodeFrame(frame, len, raw, sizeof(raw)), &decodedBattery));
+    CHECK(decodedBattery.status == CHARGING && decodedBattery.timestamp == 123);
+
+    // Raw records round trip
+    DataMessageRecord record;
+    memset(&record, 0, sizeof(record));
+    record.type = QUATERNION_MESSAGE;
+    record.quaternion = {1.0f, 0.5f, -0.25f, 0.125f, 0xFFFFFFFF};
+    DataMessageRecord decodedRecord;
+    size_t rawLen = encodeRawRecord(raw, sizeof(raw), record);
+    CHECK(rawLen == getRawRecordSize(raw[0]));
+    CHECK(decodeRawRecord(raw, rawLen, &decodedRecord));
+    CHECK(decodedRecord.type == QUATERNION_MESSAGE && memcmp(&decodedRecord.quaternion, &record.quaternion, sizeof(record.quaternion)) == 0);
+
+    // Frames that do not fit are rejected
+    CHECK(encodeInertialMessage(frame, 8, InertialMessage()) == 0);
+
+    return testResult("test_binary");
+}
@@ -0,0 +1,128 @@
+/******************************************************************
+    @file       test_circular_buffer.cpp
+    @brief      Host tests of the bulk push, span and consume operations of CircularBuffer
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_CircularBuffer.h"
+#include <stdlib.h>
+#include <deque>
+
+#define CAPACITY 37
+
+typedef CircularBuffer<int, CAPACITY> Buffer;
+
+/**
+ * @brief Checks that the buffer holds the same elements as the model, through its spans and by index
+*/
+static void checkContents(const Buffer& buffer, const std::deque<int>& model) {
+    CHECK(buffer.size() == model.size());
+    Buffer::Span first, second;
+    CHECK(buffer.spans(first, second) == model.size());
+    CHECK(first.length + second.length == model.size());
+    for (size_t i=0; i<model.size(); i++) {
+        int value = i < first.length ? first.data[i] : second.data[i - first.length];
+        CHECK(value == model[i] && buffer[i] == model[i]);
+    }
+}
+
+int main() {
+    srand(1);
+    static Buffer buffer;
+    std::deque<int> model;
+    int next = 0;
+    int values[2 * CAPACITY];
+
+    // Random mixed operations against a std::deque model
+    for (int k=0; k<300000; k++) {
+        size_t n = rand() % (2 * CAPACITY);
+        for (size_t i=0; i<n; i++) values[i] = next + i;
+
+        switch (rand() % 8) {
+            case 0: { // Bulk push, overwriting the oldest elements
+                size_t lost = buffer.push(values, n, CIRCULAR_BUFFER_OVERWRITE);
+                for (size_t i=0; i<n; i++) model.push_back(values[i]);
+                size_t expected = 0;
+                while (model.size() > CAPACITY) {
+                    model.pop_front();
+                    expected++;
+                }
+                CHECK(lost == expected);
+                next += n;
+                break;
+            }
+            case 1: { // Bulk push of the elements that fit
+                size_t fits = CAPACITY - model.size();
+                size_t lost = buffer.push(values, n, CIRCULAR_BUFFER_TRUNCATE);
+                CHECK(lost == (n > fits ? n - fits : 0));
+                for (size_t i=0; i<n - lost; i++) model.push_back(values[i]);
+                next += n;
+                break;
+            }
+            case 2: { // Bulk push of all or nothing
+                size_t lost = buffer.push(values, n, CIRCULAR_BUFFER_REJECT);
+                if (n > CAPACITY - model.size()) CHECK(lost == n);
+                else {
+                    CHECK(lost == 0);
+                    for (size_t i=0; i<n; i++) model.push_back(values[i]);
+                }
+                next += n;
+                break;
+            }
+            case 3: { // The default bulk push overwrites
+                bool overwrote = model.size() + n > CAPACITY;
+                CHECK(buffer.push(values, n) == !overwrote);
+                for (size_t i=0; i<n; i++) model.push_back(values[i]);
+                while (model.size() > CAPACITY) model.pop_front();
+                next += n;
+                break;
+            }
+            case 4: // Single elements at either end
+                CHECK(buffer.push(next) == (model.size() < CAPACITY));
+                model.push_back(next++);
+                if (model.size() > CAPACITY) model.pop_front();
+                if (!model.empty() && rand() % 2) {
+                    CHECK(buffer.pop() == model.back());
+                    model.pop_back();
+                }
+                break;
+            case 5:
+                CHECK(buffer.unshift(next) == (model.size() < CAPACITY));
+                model.push_front(next++);
+                if (model.size() > CAPACITY) model.pop_back();
+                break;
+            case 6: { // Consume more or less than is stored
+                size_t take = rand() % (CAPACITY + 5);
+                buffer.consume(take);
+                for (size_t i=0; i<take && !model.empty(); i++) model.pop_front();
+                break;
+            }
+            default:
+                if (!model.empty()) {
+                    CHECK(buffer.shift() == model.front());
+                    model.pop_front();
+                }
+                break;
+        }
+        checkContents(buffer, model);
+        if (testFailures > 0) break; // Stop at the first failure rather than report every later mismatch
+    }
+
+    // A push of more than the capacity keeps the last elements
+    buffer.clear();
+    for (int i=0; i<2 * CAPACITY; i++) values[i] = i;
+    CHECK(buffer.push(values, 2 * CAPACITY, CIRCULAR_BUFFER_OVERWRITE) == CAPACITY);
+    CHECK(buffer.isFull() && buffer.first() == CAPACITY && buffer.last() == 2 * CAPACITY - 1);
+
+    return testResult("test_circular_buffer");
+}
@@ -0,0 +1,173 @@
+/******************************************************************
+    @file       test_column_export.cpp
+    @brief      Host tests of exporting data logger files to column files
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "log_files.h"
+#include "xioAPI_ColumnExport.h"
+
+using namespace xioAPI_Types;
+using namespace xioAPI_Protocol;
+
+static uint64_t getLE(const uint8_t* p, size_t size) {
+    uint64_t value = 0;
+    for (size_t i=size; i>0; i--) value = value << 8 | p[i - 1];
+    return value;
+}
+
+/**
+ * @brief A column file read back into memory
+*/
+struct ColumnFileData {
+    std::vector<uint8_t> data;
+    uint64_t rows;
+    size_t columns;
+    uint64_t offsets[XIOAPI_COLUMN_MAX_COLUMNS];
+
+    template <typename T>
+    T get(size_t column, uint64_t row) const {
+        T value;
+        memcpy(&value, data.data() + offsets[column] + row * sizeof(T), sizeof(T));
+        return value;
+    }
+};
+
+/**
+ * @brief Reads a column file and checks its header and column descriptors against the schema
+*/
+static bool readColumnFile(const std::string& path, DataMessageType type, uint64_t rows, ColumnFileData* file) {
+    file->data = readFile(path);
+    const uint8_t* header = file->data.data();
+    size_t columns = getColumnCount(type);
+    if (file->data.size() < XIOAPI_COLUMN_HEADER_SIZE + columns * XIOAPI_COLUMN_DESCRIPTOR_SIZE) return false;
+
+    CHECK(getLE(header, 4) == XIOAPI_COLUMN_MAGIC && getLE(header + 4, 2) == XIOAPI_COLUMN_VERSION);
+    CHECK(getLE(header + 6, 2) == type && header[9] == columns);
+    CHECK(getLE(header + 12, 8) == rows);
+    file->rows = rows;
+    file->columns = columns;
+
+    uint64_t end = XIOAPI_COLUMN_HEADER_SIZE + columns * XIOAPI_COLUMN_DESCRIPTOR_SIZE;
+    for (size_t c=0; c<columns; c++) {
+        const uint8_t* descriptor = header + XIOAPI_COLUMN_HEADER_SIZE + c * XIOAPI_COLUMN_DESCRIPTOR_SIZE;
+        size_t size = c == 0 ? 8 : 4;
+        CHECK(strncmp((const char*) descriptor, getColumnName(type, c), XIOAPI_COLUMN_NAME_SIZE) == 0);
+        CHECK(descriptor[16] == (c == 0 ? COLUMN_UINT64 : COLUMN_FLOAT32) && descriptor[17] == size);
+        file->offsets[c] = getLE(descriptor + 24, 8);
+        CHECK(file->offsets[c] % 8 == 0 && file->offsets[c] >= end && file->offsets[c] < end + 8); // Back to back on 8 byte boundaries
+        end = file->offsets[c] + rows * size;
+    }
+    CHECK(file->data.size() == end);
+    return testFailures == 0;
+}
+
+/**
+ * @brief The inertial columns must hold exactly what `LogCursor` reads, bit for bit
+*/
+static void checkInertialColumns(const LogReader& reader, const ColumnFileData& file) {
+    LogCursor<InertialMessage> cursor(reader, reader.getRange());
+    InertialMessage message;
+    uint64_t timestamp;
+    uint64_t row = 0;
+    while (cursor.next(&message, &timestamp) && row < file.rows) {
+        const float values[6] = {message.ax, message.ay, message.az, message.gx, message.gy, message.gz};
+        CHECK(file.get<uint64_t>(0, row) == timestamp);
+        for (size_t c=1; c<7; c++) {
+            float value = file.get<float>(c, row);
+            CHECK(memcmp(&value, &values[c - 1], sizeof(float)) == 0);
+        }
+        row++;
+        if (testFailures > 0) return;
+    }
+    CHECK(row == file.rows && !cursor.next(&message, &timestamp));
+}
+
+static void checkExport(const std::vector<RawRecord>& stream, DataLoggerFormat format) {
+    LogDirectory directory;
+    std::string path = writeRecordLog(directory, stream, format)[0];
+    LogReader reader;
+    CHECK(reader.open(path.c_str()));
+
+    uint64_t rows[NUM_DATA_MESSAGE_TYPES] = {0};
+    for (const RawRecord& record : stream) rows[xioAPI_Binary::getMessageType(record.data[0])]++;
+
+    // The same files with any number of threads, as each chunk writes from its own first rows
+    std::vector<uint8_t> firstExport[NUM_DATA_MESSAGE_TYPES];
+    const size_t threadCounts[] = {1, 3, 4};
+    for (size_t threads : threadCounts) {
+        char prefix[32];
+        snprintf(prefix, sizeof(prefix), "/threads%zu", threads);
+        ColumnExportStats stats;
+        CHECK(exportColumns(reader, (directory.getPath() + prefix).c_str(), threads, &stats));
+        CHECK(stats.threads == threads && stats.corruptBlocks == 0);
+
+        for (size_t t=0; t<NUM_DATA_MESSAGE_TYPES; t++) {
+            CHECK(stats.rows[t] == rows[t]);
+            std::string columnPath = directory.getPath() + prefix + "_" + getColumnFileName((DataMessageType) t) + ".col";
+            if (rows[t] == 0) { // No file for a type without samples
+                CHECK(access(columnPath.c_str(), F_OK) != 0);
+                continue;
+            }
+
+            ColumnFileData file;
+            if (!readColumnFile(columnPath, (DataMessageType) t, rows[t], &file)) return;
+            if (threads == 1) firstExport[t] = file.data;
+            else CHECK(file.data == firstExport[t]);
+
+            // The timestamp column holds the samples of the type in file order
+            uint64_t row = 0;
+            for (const RawRecord& record : stream) {
+                if (xioAPI_Binary::getMessageType(record.data[0]) != (int) t) continue;
+                if (file.get<uint64_t>(0, row++) != record.timestamp) {
+                    CHECK(false);
+                    break;
+                }
+            }
+            if (t == INERTIAL_MESSAGE) checkInertialColumns(reader, file);
+        }
+    }
+
+    // A damaged block is skipped by both passes, so the rows still line up
+    std::vector<uint8_t> data = readFile(path);
+    size_t headerSize = (size_t) reader.getFileHeader().headerBlocks * XIOAPI_LOG_BLOCK_SIZE;
+    data[headerSize + 7 * XIOAPI_LOG_BLOCK_SIZE + XIOAPI_LOG_BLOCK_HEADER_SIZE + 50] ^= 0x04;
+    std::string damagedPath = directory.getPath() + "/damaged.bin";
+    FILE* damaged = fopen(damagedPath.c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), damaged);
+    fclose(damaged);
+
+    LogReader damagedReader;
+    CHECK(damagedReader.open(damagedPath.c_str()));
+    ColumnExportStats stats;
+    CHECK(exportColumns(damagedReader, (directory.getPath() + "/damaged").c_str(), 3, &stats));
+    CHECK(stats.corruptBlocks == 1 && stats.rows[INERTIAL_MESSAGE] < rows[INERTIAL_MESSAGE]);
+    ColumnFileData file;
+    if (readColumnFile(directory.getPath() + "/damaged_inertial.col", INERTIAL_MESSAGE, stats.rows[INERTIAL_MESSAGE], &file)) {
+        checkInertialColumns(damagedReader, file);
+    }
+
+    // An output path that cannot be written
+    CHECK(!exportColumns(reader, (directory.getPath() + "/missing/out").c_str(), 2));
+}
+
+int main() {
+    std::vector<RawRecord> stream = buildRecordStream(200000);
+    checkExport(stream, DATA_LOGGER_FORMAT_INDEXED);
+    checkExport(stream, DATA_LOGGER_FORMAT_COMPRESSED);
+
+    CHECK(getColumnCount(INERTIAL_MESSAGE) == 7 && strcmp(getColumnName(INERTIAL_MESSAGE, 4), "gx") == 0);
+    CHECK(getColumnName(TEMPERATURE_MESSAGE, 2) == nullptr && getColumnFileName((DataMessageType) NUM_DATA_MESSAGE_TYPES) == nullptr);
+
+    return testResult("test_column_export");
+}
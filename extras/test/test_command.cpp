@@ -0,0 +1,82 @@
+/******************************************************************
+    @file       test_command.cpp
+    @brief      Host tests of the command parser and the streaming object reader
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "command_corpus.h"
+#include "xioAPI_Command.h"
+#include <string.h>
+
+using namespace xioAPI_Command;
+using namespace xioAPI_Types;
+
+static bool parse(const char* text, Command* command, char* buffer, size_t size) {
+    strncpy(buffer, text, size - 1);
+    buffer[size - 1] = '\0';
+    return parseCommand(buffer, strlen(buffer), command);
+}
+
+int main() {
+    char buffer[256];
+    Command command;
+
+    // Every API key is found with every form of value
+    std::vector<CorpusEntry> corpus = buildCommandCorpus();
+    for (const CorpusEntry& entry : corpus) {
+        bool ok = parse(entry.message.c_str(), &command, buffer, sizeof(buffer));
+        CHECK(ok && command.hash == entry.hash && strcmp(command.key, entry.key) == 0);
+        if (!ok) printf("  %s\n", entry.message.c_str());
+    }
+
+    // Values convert like `JsonVariant::as<T>()`
+    CHECK(parse("{ \"x\" : [1.0, -2.5, 3e-1] }\r", &command, buffer, sizeof(buffer)));
+    CHECK(command.value.size() == 3 && command.value[1].as<float>() == -2.5f && command.value[0].as<int>() == 1);
+    CHECK(parse("{\"x\":123456789}", &command, buffer, sizeof(buffer)));
+    CHECK(command.value.as<long>() == 123456789 && command.value.as<float>() == 123456789.0f);
+    CHECK(parse("{\"x\":false}", &command, buffer, sizeof(buffer)));
+    CHECK(!command.value.as<bool>() && command.value.as<int>() == 0 && !command.value.isNull());
+    CHECK(parse("{\"x\":null}", &command, buffer, sizeof(buffer)));
+    CHECK(command.value.isNull() && command.value.as<const char*>() == nullptr);
+    CHECK(parse("{\"x\":\"a\\\"b\\u00e9\\ud83d\\ude00\\n\"}", &command, buffer, sizeof(buffer)));
+    CHECK(strcmp(command.value.as<const char*>(), "a\"b\xc3\xa9\xf0\x9f\x98\x80\n") == 0);
+
+    // Malformed messages are rejected
+    const char* malformed[] = {
+        "", "{}", "{\"x\"}", "{\"x\":}", "{\"x\":1,}", "{\"x\":1,\"y\":2}", "{\"x\":01}", "{\"x\":1.}",
+        "{\"x\":[1,2}", "{\"x\":[1,2,3,4,5,6,7,8,9,10]}", "{\"x\":{\"a\":1}}", "{\"x\":\"abc}", "{\"x\":tru}",
+        "{\"x\":1} x", "{\"x\":\"\\ud800\"}", "{\"x\":[\"a\"]}", "[1]", "{\"x\":-}",
+    };
+    for (const char* text : malformed) {
+        bool ok = parse(text, &command, buffer, sizeof(buffer));
+        CHECK(!ok);
+        if (ok) printf("  accepted %s\n", text);
+    }
+
+    // The object reader splits a pretty-printed configuration file into members
+    const char* file = "{\n  \"deviceName\": \"Thetis\",\n  \"softIronMatrix\": [1, 0, 0, 0, 1, 0, 0, 0, 1],\n"
+                       "  \"bad\": ,\n  \"udpSendPort\": 9000\n}\n";
+    ObjectReader reader;
+    reader.reset();
+    size_t members = 0;
+    for (const char* c=file; *c; c++) {
+        Command member;
+        if (!reader.read(*c, &member)) continue;
+        members++;
+        if (member.hash == xioAPI_Protocol::SOFT_IRON_MATRIX) CHECK(member.value.size() == 9);
+        if (member.hash == xioAPI_Protocol::UDP_SEND_PORT) CHECK(member.value.as<int>() == 9000);
+    }
+    CHECK(members == 3 && reader.getErrors() == 1 && reader.isComplete());
+
+    return testResult("test_command");
+}
@@ -0,0 +1,79 @@
+/******************************************************************
+    @file       test_compression.cpp
+    @brief      Host tests of the delta and varint compression of data message records
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "records.h"
+#include "xioAPI_Compression.h"
+#include <float.h>
+
+using namespace xioAPI_Compression;
+using namespace xioAPI_Protocol;
+
+int main() {
+    // Varints and zigzag encoding round trip at the limits
+    const int64_t values[] = {0, 1, -1, 63, -64, 64, 127, 128, -129, INT32_MAX, INT32_MIN, INT64_MAX, INT64_MIN};
+    for (int64_t value : values) {
+        uint8_t buffer[10];
+        uint8_t* end = writeVarint(buffer, zigzagEncode(value));
+        uint64_t decoded = 0;
+        CHECK(readVarint(buffer, end, &decoded) == end && zigzagDecode(decoded) == value);
+        CHECK(readVarint(buffer, end - 1, &decoded) == nullptr); // Truncated
+    }
+    CHECK(quantize(1.23456f, 4) == 12346 && quantize(-1.23456f, 4) == -12346);
+
+    // Records round trip within half a quantization step, with exact timestamps and IDs
+    std::vector<DataMessageRecord> messages;
+    std::vector<RawRecord> stream = buildRecordStream(100000, &messages);
+    Encoder encoder;
+    Decoder decoder;
+    encoder.reset();
+    decoder.reset();
+    double maxError = 0.0;
+    size_t compressedBytes = 0, rawBytes = 0;
+    for (size_t i=0; i<stream.size(); i++) {
+        uint8_t compressed[XIOAPI_COMPRESSION_MAX_RECORD_SIZE];
+        size_t len = encoder.encode(stream[i].data, stream[i].size, compressed, sizeof(compressed));
+        CHECK(len > 0);
+        compressedBytes += len;
+        rawBytes += stream[i].size;
+
+        uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+        size_t rawLen = 0;
+        CHECK(decoder.decode(compressed, len, raw, sizeof(raw), &rawLen) == len);
+        CHECK(rawLen == stream[i].size && raw[0] == stream[i].data[0]);
+        CHECK(xioAPI_Log::getRecordTimestamp(raw) == stream[i].timestamp);
+
+        DataMessageRecord record;
+        CHECK(xioAPI_Binary::decodeRawRecord(raw, rawLen, &record) && record.type == messages[i].type);
+        const float* decoded = (const float*) &record.inertial;
+        const float* original = (const float*) &messages[i].inertial;
+        size_t channels = (rawLen - 10) / 4;
+        for (size_t c=0; c<channels; c++) {
+            if (record.type == xioAPI_Types::BATTERY_MESSAGE && c == 2) continue; // The status is not a float
+            double error = fabs(decoded[c] - original[c]);
+            CHECK(error <= 0.5e-4 + fabs(original[c]) * FLT_EPSILON); // Half a quantization step, plus the float rounding
+            maxError = fmax(maxError, error);
+        }
+    }
+    CHECK(maxError > 0.0); // The channels really were quantized
+    CHECK(compressedBytes * 2 < rawBytes);
+
+    // An output buffer that is too small is refused rather than overrun
+    uint8_t small[4];
+    encoder.reset();
+    CHECK(encoder.encode(stream[0].data, stream[0].size, small, sizeof(small)) == 0);
+
+    return testResult("test_compression");
+}
@@ -0,0 +1,271 @@
+/******************************************************************
+    @file       test_data_logger.cpp
+    @brief      Host tests of the data logger file rotation, overruns and indexed file round trips
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "log_files.h"
+#include "xioAPI_CircularBuffer.h"
+#include "xioAPI_LogReader.h"
+#include <stdint.h>
+#include <sys/stat.h>
+#include <memory>
+
+#define MiB (1024 * 1024)
+
+/**
+ * @brief Keeps log files in memory, and can be made to fail or to accept short writes
+*/
+class MemoryStorage : public DataLoggerStorage {
+public:
+    struct File {
+        std::string name;
+        std::vector<uint8_t> data;
+        std::vector<size_t> writes;
+    };
+
+    bool open(const char* path) override {
+        if (failing) return false;
+        files.push_back(File{path, {}, {}});
+        _open = true;
+        return true;
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        if (!_open || failing) return 0;
+        if (size > maxWrite) size = maxWrite;
+        files.back().data.insert(files.back().data.end(), data, data + size);
+        files.back().writes.push_back(size);
+        return size;
+    }
+
+    void close() override { _open = false; }
+
+    bool exists(const char* path) override {
+        for (const File& file : files) {
+            if (file.name == path) return true;
+        }
+        return false;
+    }
+
+    std::vector<uint8_t> join() const {
+        std::vector<uint8_t> data;
+        for (const File& file : files) data.insert(data.end(), file.data.begin(), file.data.end());
+        return data;
+    }
+
+    std::vector<File> files;
+    bool failing = false;
+    size_t maxWrite = SIZE_MAX;
+
+private:
+    bool _open = false;
+};
+
+static uint32_t getTimestamp(const uint8_t* line) {
+    return (uint32_t) strtoul((const char*) line + 2, nullptr, 10);
+}
+
+/**
+ * @brief Text files are rotated under `maxFileSize` between messages, in whole blocks
+*/
+static void checkSizeRotation() {
+    std::vector<uint8_t> data = joinMessages(buildTextMessages(60000));
+    DataLoggerConfig config = makeLoggerConfig(DATA_LOGGER_FORMAT_TEXT, 1);
+    MemoryStorage storage;
+    std::unique_ptr<DataLogger> logger(new DataLogger()); // The statistics are kept across begin()
+    logger->begin(&storage);
+    for (size_t offset=0; offset < data.size(); ) {
+        size_t n = data.size() - offset < LOG_FILES_CHUNK_SIZE ? data.size() - offset : LOG_FILES_CHUNK_SIZE;
+        CHECK(logger->write(data.data() + offset, n, config, 0) == n); // The storage keeps up
+        offset += n;
+    }
+    logger->stop(config, 0);
+
+    CHECK(data.size() > 3 * MiB && storage.files.size() == data.size() / MiB + 1);
+    CHECK(storage.join() == data);
+    for (size_t i=0; i<storage.files.size(); i++) {
+        const MemoryStorage::File& file = storage.files[i];
+        char name[32];
+        snprintf(name, sizeof(name), "/log_%04zu.txt", i + 1);
+        CHECK(file.name == name);
+        CHECK(file.data.size() <= MiB && file.data.front() == 'I' && file.data.back() == '\n');
+        if (i + 1 < storage.files.size()) CHECK(file.data.size() > MiB - 128); // Only the message that did not fit is moved on
+        for (size_t w=0; w + 1 < file.writes.size(); w++) CHECK(file.writes[w] == XIOAPI_DATA_LOGGER_BLOCK_SIZE);
+    }
+    CHECK(logger->getStats().stalls == 0 && logger->getStats().writeErrors == 0);
+}
+
+/**
+ * @brief Text files are rotated after `maxFilePeriod`, including by `service()` when no data arrives
+*/
+static void checkPeriodRotation() {
+    std::vector<std::string> messages = buildTextMessages(10000); // 10 s at 1 kHz
+    DataLoggerConfig config = makeLoggerConfig(DATA_LOGGER_FORMAT_TEXT, 0, 2);
+    MemoryStorage storage;
+    std::unique_ptr<DataLogger> logger(new DataLogger());
+    logger->begin(&storage);
+    for (size_t i=0; i<messages.size(); i++) {
+        uint32_t now = 0xFFFFF000u + i; // The millisecond clock wraps too
+        CHECK(logger->write((const uint8_t*) messages[i].data(), messages[i].size(), config, now) == messages[i].size());
+        logger->service(config, now);
+    }
+    logger->stop(config, 0xFFFFF000u + messages.size());
+
+    CHECK(storage.files.size() == 5);
+    CHECK(storage.join() == joinMessages(messages));
+    for (const MemoryStorage::File& file : storage.files) {
+        const uint8_t* last = file.data.data() + file.data.size() - 1;
+        while (last > file.data.data() && last[-1] != '\n') last--;
+        CHECK(file.data.front() == 'I' && file.data.back() == '\n');
+        CHECK(getTimestamp(last) - getTimestamp(file.data.data()) <= 2000 * 1000);
+    }
+
+    // With no more data, the next service() after the period closes the file
+    storage.files.clear();
+    logger.reset(new DataLogger());
+    logger->begin(&storage);
+    std::vector<uint8_t> data = joinMessages(std::vector<std::string>(messages.begin(), messages.begin() + 40));
+    CHECK(data.size() < XIOAPI_DATA_LOGGER_BLOCK_SIZE); // Less than a block, so nothing is written until the period ends
+    CHECK(logger->write(data.data(), data.size(), config, 0) == data.size());
+    logger->service(config, 1999);
+    CHECK(storage.files.empty());
+    logger->service(config, 2000);
+    CHECK(!logger->isLogging() && storage.files.size() == 1 && storage.files[0].data == data);
+}
+
+/**
+ * @brief Feeds the messages through a data message buffer as `sendEncodedDataMessage()` and
+ * `serviceDataLogger()` do, while the storage fails and accepts short writes.
+ * Messages that do not fit in the buffer are rejected whole and counted as overruns.
+*/
+static void checkOverruns() {
+    std::vector<std::string> messages = buildTextMessages(40000);
+    DataLoggerConfig config = makeLoggerConfig(DATA_LOGGER_FORMAT_TEXT, 1);
+    static CircularBuffer<char, 8192> buffer;
+    buffer.clear();
+    MemoryStorage storage;
+    storage.maxWrite = 1000;
+    std::unique_ptr<DataLogger> logger(new DataLogger());
+    logger->begin(&storage);
+
+    std::vector<uint8_t> accepted;
+    size_t overruns = 0;
+    for (size_t i=0; i<messages.size(); i++) {
+        storage.failing = (i / 500) % 4 == 3; // The storage is busy a quarter of the time
+        const std::string& message = messages[i];
+        if (buffer.push(message.data(), message.size(), CIRCULAR_BUFFER_REJECT) > 0) overruns++;
+        else accepted.insert(accepted.end(), message.begin(), message.end());
+
+        if (i % 8 != 0) continue; // Drained less often than messages arrive
+        CircularBuffer<char, 8192>::Span spans[2];
+        buffer.spans(spans[0], spans[1]);
+        for (int s=0; s<2 && spans[s].length > 0; s++) {
+            size_t n = logger->write((const uint8_t*) spans[s].data, spans[s].length, config, i);
+            buffer.consume(n);
+            if (n < spans[s].length) break;
+        }
+        logger->service(config, i);
+    }
+    storage.failing = false;
+    while (!buffer.isEmpty()) {
+        CircularBuffer<char, 8192>::Span first, second;
+        buffer.spans(first, second);
+        buffer.consume(logger->write((const uint8_t*) first.data, first.length, config, 0));
+    }
+    logger->stop(config, 0);
+
+    const DataLoggerStats& stats = logger->getStats();
+    CHECK(overruns > 0 && stats.stalls > 0 && stats.writeErrors > 0);
+    CHECK(accepted.size() < joinMessages(messages).size());
+    CHECK(storage.join() == accepted); // Nothing accepted is lost, repeated or split
+    for (const MemoryStorage::File& file : storage.files) CHECK(file.data.size() <= MiB && file.data.back() == '\n');
+}
+
+/**
+ * @brief Taken names get a counter, so existing files are never overwritten
+*/
+static void checkFileNames() {
+    DataLoggerConfig config = makeLoggerConfig(DATA_LOGGER_FORMAT_TEXT);
+    config.fileNameCounterEnabled = false;
+    MemoryStorage storage;
+    storage.files.push_back(MemoryStorage::File{"/log.txt", {}, {}});
+    std::unique_ptr<DataLogger> logger(new DataLogger());
+    logger->begin(&storage);
+    const uint8_t line[] = "T,1,25.0\r\n";
+    logger->write(line, sizeof(line) - 1, config, 0);
+    logger->stop(config, 0);
+    logger->write(line, sizeof(line) - 1, config, 0);
+    logger->stop(config, 0);
+    CHECK(storage.files.size() == 3 && storage.files[1].name == "/log_0001.txt" && storage.files[2].name == "/log_0002.txt");
+}
+
+/**
+ * @brief Logs records in the indexed format with POSIX files, rotating under `maxFileSize`,
+ * and reads every file back with the log reader
+*/
+static void checkIndexedFiles(const std::vector<RawRecord>& stream, DataLoggerFormat format) {
+    // A few bytes of noise between records are skipped
+    std::vector<uint8_t> data;
+    for (size_t i=0; i<stream.size(); i++) {
+        if (i % 10000 == 5000) data.push_back(0);
+        data.insert(data.end(), stream[i].data, stream[i].data + stream[i].size);
+    }
+
+    LogDirectory directory;
+    DataLoggerStats stats;
+    std::vector<std::string> paths = writeLog(directory, data, makeLoggerConfig(format, 1), &stats);
+    CHECK(paths.size() > 1);
+    CHECK(stats.recordErrors == stream.size() / 10000 && stats.stalls == 0 && stats.writeErrors == 0);
+
+    size_t next = 0;
+    uint32_t blocks = 0;
+    for (const std::string& path : paths) {
+        struct stat st;
+        CHECK(stat(path.c_str(), &st) == 0 && st.st_size <= MiB);
+
+        LogReader reader;
+        CHECK(reader.open(path.c_str()) && !reader.isRecovered());
+        const uint8_t* settings = reader.getSettings();
+        CHECK(settings != nullptr && memcmp(settings, getLogSettings().data(), getLogSettings().size()) == 0);
+        CHECK(reader.getFileHeader().firstSequence == blocks); // Block sequence numbers run on across files
+        for (size_t b=0; b<reader.getBlockCount(); b++) {
+            xioAPI_Log::BlockReader block;
+            CHECK(block.begin(reader.getBlock(b), XIOAPI_LOG_BLOCK_SIZE));
+            CHECK(block.getHeader().sequence == blocks++);
+            CHECK(((block.getHeader().flags & XIOAPI_LOG_BLOCK_COMPRESSED) != 0) == (format == DATA_LOGGER_FORMAT_COMPRESSED));
+            size_t rawLen;
+            const uint8_t* raw;
+            while ((raw = block.next(&rawLen)) != nullptr) {
+                CHECK(next < stream.size() && rawLen == stream[next].size);
+                CHECK(xioAPI_Log::getRecordTimestamp(raw) == stream[next].timestamp);
+                if (format == DATA_LOGGER_FORMAT_INDEXED) CHECK(memcmp(raw, stream[next].data, rawLen) == 0);
+                next++;
+            }
+        }
+    }
+    CHECK(next == stream.size() && blocks == stats.blocksWritten);
+}
+
+int main() {
+    checkSizeRotation();
+    checkPeriodRotation();
+    checkOverruns();
+    checkFileNames();
+
+    std::vector<RawRecord> stream = buildRecordStream(100000);
+    checkIndexedFiles(stream, DATA_LOGGER_FORMAT_INDEXED);
+    checkIndexedFiles(stream, DATA_LOGGER_FORMAT_COMPRESSED);
+
+    return testResult("test_data_logger");
+}
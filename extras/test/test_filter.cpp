@@ -0,0 +1,77 @@
+/******************************************************************
+    @file       test_filter.cpp
+    @brief      Host tests of the CIC decimation filter against a reference FIR filter
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_Filter.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+int main() {
+    srand(1);
+    for (int order=1; order<=XIOAPI_DECIMATION_MAX_ORDER; order++) {
+        for (int factor=1; factor<=40; factor+=3) {
+            // The reference impulse response is `order` boxcars of length `factor` convolved together
+            std::vector<double> taps(1, 1.0);
+            for (int k=0; k<order; k++) {
+                std::vector<double> next(taps.size() + factor - 1, 0.0);
+                for (size_t i=0; i<taps.size(); i++) {
+                    for (int r=0; r<factor; r++) next[i + r] += taps[i];
+                }
+                taps = next;
+            }
+            double gain = pow(factor, order);
+
+            std::vector<double> x(2000);
+            for (double& v : x) v = rand() / (double) RAND_MAX - 0.5;
+
+            DecimationFilter filter;
+            filter.configure(order, factor, 2);
+            size_t outputs = 0;
+            for (size_t i=0; i<x.size(); i++) {
+                float in[2] = {(float) x[i], 1.0f};
+                float out[2];
+                if (!filter.update(in, out)) continue;
+                outputs++;
+                if (i < taps.size()) continue; // Still filling
+                double expected = 0.0;
+                for (size_t n=0; n<taps.size(); n++) expected += taps[n] * x[i - n];
+                CHECK(fabs(expected / gain - out[0]) < 1e-4);
+                CHECK(fabs(out[1] - 1.0f) < 1e-4); // Unity DC gain
+            }
+            CHECK(outputs == x.size() / factor);
+
+            // The first alias of the output rate is a null of the response
+            if (factor == 1) continue;
+            filter.configure(order, factor, 1);
+            double alias = 0.0;
+            for (int i=0; i<4000; i++) {
+                float in = (float) cos(2 * M_PI * i / factor + 0.3);
+                float out;
+                if (filter.update(&in, &out) && i > 200) alias = fmax(alias, fabs(out));
+            }
+            CHECK(alias < 1e-3);
+        }
+    }
+
+    // A disabled filter reports itself unconfigured, so its caller configures (and clears) it again
+    DecimationFilter filter;
+    filter.configure(2, 4, 1);
+    CHECK(filter.isConfigured(2, 4));
+    filter.disable();
+    CHECK(!filter.isConfigured(2, 4));
+
+    return testResult("test_filter");
+}
@@ -0,0 +1,69 @@
+/******************************************************************
+    @file       test_format.cpp
+    @brief      Host tests of the data message number formatting against printf
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_Format.h"
+#include <math.h>
+#include <string.h>
+
+using namespace xioAPI_Format;
+
+static void checkFixed4(float value) {
+    char expected[64], actual[64];
+    int len = snprintf(expected, sizeof(expected), "%0.4f", value);
+    char* end = formatFixed4(actual, value);
+    *end = '\0';
+    if (end - actual != len || strcmp(expected, actual) != 0) {
+        printf("formatFixed4(%a): \"%s\", expected \"%s\"\n", value, actual, expected);
+        testFailures++;
+    }
+}
+
+int main() {
+    // Random bit patterns cover every exponent, including infinities and NaNs
+    uint32_t seed = 12345;
+    for (long i=0; i<2000000; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float value;
+        memcpy(&value, &seed, sizeof(value));
+        checkFixed4(value);
+    }
+
+    // Values either side of the rounding boundaries
+    for (int i=-200000; i<200000; i++) {
+        checkFixed4(i / 32.0f);
+        checkFixed4(i / 10000.0f);
+        checkFixed4(i * 0.00005f);
+    }
+    const float edges[] = {0.0f, -0.0f, -0.00004f, 0.00005f, INFINITY, -INFINITY, NAN, 3.4e38f, -3.4e38f, 429496.7295f};
+    for (float value : edges) checkFixed4(value);
+
+    const uint32_t unsignedValues[] = {0, 1, 9, 10, 1000000000, 4294967295u};
+    for (uint32_t value : unsignedValues) {
+        char expected[16], actual[16];
+        snprintf(expected, sizeof(expected), "%u", value);
+        *formatUnsigned(actual, value) = '\0';
+        CHECK(strcmp(expected, actual) == 0);
+    }
+
+    // A whole data message matches the printf format it replaced
+    char message[InertialLayout::bufferSize];
+    char expected[InertialLayout::bufferSize];
+    size_t len = InertialLayout::format(message, 123456u, 1.0f, -2.5f, 0.00005f, 100.0f, -0.0001f, 9.80665f);
+    snprintf(expected, sizeof(expected), "I,%u,%0.4f,%0.4f,%0.4f,%0.4f,%0.4f,%0.4f", 123456u, 1.0f, -2.5f, 0.00005f, 100.0f, -0.0001f, 9.80665f);
+    CHECK(len == strlen(expected) && strcmp(message, expected) == 0);
+
+    return testResult("test_format");
+}
@@ -0,0 +1,117 @@
+/******************************************************************
+    @file       test_log.cpp
+    @brief      Host tests of the indexed log file format
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "records.h"
+#include "xioAPI_Log.h"
+
+using namespace xioAPI_Log;
+
+/**
+ * @brief Packs the stream into blocks, then reads every block back and compares the records
+*/
+static void checkBlocks(const std::vector<RawRecord>& stream, bool compressed) {
+    std::vector<uint8_t> blocks;
+    uint8_t block[XIOAPI_LOG_BLOCK_SIZE];
+    BlockBuilder builder;
+    Index index;
+    index.clear();
+    uint32_t count = 0;
+    builder.begin(block, count, compressed);
+    for (const RawRecord& record : stream) {
+        if (builder.append(record.data, record.size, record.timestamp)) continue;
+        builder.finish();
+        index.add(count++, builder.getHeader());
+        blocks.insert(blocks.end(), block, block + XIOAPI_LOG_BLOCK_SIZE);
+        builder.begin(block, count, compressed);
+        CHECK(builder.append(record.data, record.size, record.timestamp));
+    }
+    builder.finish();
+    index.add(count++, builder.getHeader());
+    blocks.insert(blocks.end(), block, block + XIOAPI_LOG_BLOCK_SIZE);
+
+    size_t next = 0;
+    for (uint32_t b=0; b<count; b++) {
+        BlockReader reader;
+        CHECK(reader.begin(blocks.data() + b * XIOAPI_LOG_BLOCK_SIZE, XIOAPI_LOG_BLOCK_SIZE));
+        CHECK(reader.getHeader().sequence == b);
+        size_t rawLen;
+        const uint8_t* raw;
+        while ((raw = reader.next(&rawLen)) != nullptr) {
+            CHECK(next < stream.size() && rawLen == stream[next].size);
+            CHECK(getRecordTimestamp(raw) == stream[next].timestamp);
+            if (!compressed) CHECK(memcmp(raw, stream[next].data, rawLen) == 0);
+            next++;
+        }
+        CHECK(!reader.isCorrupt());
+    }
+    CHECK(next == stream.size());
+
+    // The index covers every block once, in order
+    uint32_t covered = 0;
+    for (size_t i=0; i<index.getEntryCount(); i++) {
+        const IndexEntry& entry = index.getEntry(i);
+        CHECK(entry.firstBlock == covered);
+        covered += entry.blockCount;
+    }
+    CHECK(covered == count && index.getEntryCount() <= XIOAPI_LOG_INDEX_CAPACITY);
+
+    // A flipped payload bit fails the block checksum
+    blocks[XIOAPI_LOG_BLOCK_HEADER_SIZE + 5] ^= 0x10;
+    BlockReader reader;
+    CHECK(!reader.begin(blocks.data(), XIOAPI_LOG_BLOCK_SIZE));
+}
+
+int main() {
+    std::vector<RawRecord> stream = buildRecordStream(300000);
+    CHECK(stream.back().timestamp > UINT32_MAX); // The 32-bit timestamps wrapped
+    checkBlocks(stream, false);
+    checkBlocks(stream, true);
+
+    // File headers, index entries and footers round trip, and are rejected when corrupt
+    FileHeader header = {XIOAPI_LOG_VERSION, getHeaderBlocks(100), XIOAPI_LOG_BLOCK_SIZE, 100, 0x12345678, 42};
+    uint8_t buffer[XIOAPI_LOG_FILE_HEADER_SIZE];
+    FileHeader decodedHeader;
+    CHECK(writeFileHeader(buffer, header) == XIOAPI_LOG_FILE_HEADER_SIZE);
+    CHECK(readFileHeader(buffer, sizeof(buffer), &decodedHeader));
+    CHECK(decodedHeader.headerBlocks == 1 && decodedHeader.settingsCRC == 0x12345678 && decodedHeader.firstSequence == 42);
+    buffer[10] ^= 0x01;
+    CHECK(!readFileHeader(buffer, sizeof(buffer), &decodedHeader));
+
+    IndexEntry entry = {3, 2, 0x5, 7, 0x100000000ull, 0x100000010ull};
+    uint8_t entryBuffer[XIOAPI_LOG_INDEX_ENTRY_SIZE];
+    IndexEntry decodedEntry;
+    CHECK(writeIndexEntry(entryBuffer, entry) == XIOAPI_LOG_INDEX_ENTRY_SIZE);
+    CHECK(readIndexEntry(entryBuffer, &decodedEntry));
+    CHECK(decodedEntry.firstBlock == 3 && decodedEntry.lastTimestamp == 0x100000010ull);
+
+    uint32_t indexCRC = crc32(entryBuffer, sizeof(entryBuffer));
+    Footer footer = {4096, 1, 5};
+    uint8_t footerBuffer[XIOAPI_LOG_FOOTER_SIZE];
+    Footer decodedFooter;
+    CHECK(writeFooter(footerBuffer, footer, indexCRC) == XIOAPI_LOG_FOOTER_SIZE);
+    CHECK(readFooter(footerBuffer, &decodedFooter, indexCRC) && decodedFooter.blockCount == 5);
+    CHECK(!readFooter(footerBuffer, &decodedFooter, indexCRC ^ 1));
+
+    // Older samples of another message type map back before the newest timestamp
+    TimestampExtender extender;
+    CHECK(extender.extend(0xFFFFFFF0u) == 0xFFFFFFF0u);
+    CHECK(extender.extend(0x00000010u) == 0x100000010ull);
+    CHECK(extender.extend(0xFFFFFFF8u) == 0xFFFFFFF8u);
+
+    CHECK(crc32((const uint8_t*) "123456789", 9) == 0xCBF43926); // The standard check value
+
+    return testResult("test_log");
+}
@@ -0,0 +1,250 @@
+/******************************************************************
+    @file       test_log_reader.cpp
+    @brief      Host tests of reading data logger files with the memory-mapped log reader
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "log_files.h"
+#include "xioAPI_LogReader.h"
+#include <algorithm>
+#include <thread>
+
+using namespace xioAPI_Protocol;
+
+static void writeFile(const std::string& path, const std::vector<uint8_t>& data, size_t size) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) return;
+    fwrite(data.data(), 1, size, file);
+    fclose(file);
+}
+
+/**
+ * @brief Reads the samples of one message type in a range, and checks them against a scan of the
+ * logged records, of which the first `logged` reached the file
+ *
+ * @return The number of samples
+*/
+template <typename Message>
+static size_t checkCursor(const LogReader& reader, const LogRange& range, const std::vector<RawRecord>& stream, bool exact, size_t logged=SIZE_MAX) {
+    LogCursor<Message> cursor(reader, range);
+    Message message;
+    uint64_t timestamp;
+    size_t count = 0;
+    size_t i = std::lower_bound(stream.begin(), stream.end(), range.from,
+                                [](const RawRecord& record, uint64_t t) { return record.timestamp < t; }) - stream.begin();
+    for ( ; i<stream.size() && i<logged && stream[i].timestamp <= range.to; i++) { // The records are in time order
+        const RawRecord& record = stream[i];
+        if (xioAPI_Binary::getMessageType(record.data[0]) != LogMessageTraits<Message>::type) continue;
+
+        if (!cursor.next(&message, &timestamp)) {
+            CHECK(false); // A sample is missing
+            return count;
+        }
+        count++;
+        CHECK(timestamp == record.timestamp && message.timestamp == (uint32_t) record.timestamp);
+        if (exact) {
+            Message expected;
+            CHECK(LogMessageTraits<Message>::decode(record.data, record.size, &expected));
+            CHECK(memcmp(&message, &expected, sizeof(message)) == 0);
+        }
+        if (testFailures > 0) return count;
+    }
+    CHECK(!cursor.next(&message, &timestamp)); // No extra samples
+    CHECK(cursor.getCorruptBlocks() == 0);
+    return count;
+}
+
+static size_t checkAllTypes(const LogReader& reader, const LogRange& range, const std::vector<RawRecord>& stream, bool exact, size_t logged=SIZE_MAX) {
+    return checkCursor<InertialMessage>(reader, range, stream, exact, logged)
+           + checkCursor<MagnetometerMessage>(reader, range, stream, exact, logged)
+           + checkCursor<QuaternionMessage>(reader, range, stream, exact, logged)
+           + checkCursor<EulerMessage>(reader, range, stream, exact, logged)
+           + checkCursor<TemperatureMessage>(reader, range, stream, exact, logged)
+           + checkCursor<BatteryMessage>(reader, range, stream, exact, logged);
+}
+
+/**
+ * @brief The first block of a range must be the first that can hold samples from `from`, and no
+ * block after the range may hold samples up to `to`
+*/
+static void checkRange(const LogReader& reader, const LogRange& range) {
+    xioAPI_Log::BlockHeader header;
+    if (range.firstBlock > 0) CHECK(reader.getBlockHeader(range.firstBlock - 1, &header) && header.lastTimestamp < range.from);
+    for (size_t b=range.endBlock; b<reader.getBlockCount(); b++) CHECK(reader.getBlockHeader(b, &header) && header.firstTimestamp > range.to);
+}
+
+/**
+ * @brief The index written when the file was closed covers every block once, within
+ * `XIOAPI_LOG_INDEX_CAPACITY` entries, and each entry summarises its blocks
+*/
+static void checkIndex(const LogReader& reader, const std::vector<uint8_t>& file) {
+    const uint8_t* end = file.data() + file.size() - XIOAPI_LOG_FOOTER_SIZE;
+    xioAPI_Log::Footer footer;
+    xioAPI_Log::readFooter(end, &footer, 0); // Locates the index; the checksum is verified next
+    size_t indexSize = (size_t) footer.entryCount * XIOAPI_LOG_INDEX_ENTRY_SIZE;
+    CHECK(footer.indexOffset + indexSize + XIOAPI_LOG_FOOTER_SIZE == file.size());
+    CHECK(xioAPI_Log::readFooter(end, &footer, xioAPI_Log::crc32(file.data() + footer.indexOffset, indexSize)));
+    CHECK(footer.blockCount == reader.getBlockCount());
+    CHECK(footer.entryCount > XIOAPI_LOG_INDEX_CAPACITY / 2 && footer.entryCount <= XIOAPI_LOG_INDEX_CAPACITY); // Coarsened, but not more than needed
+
+    uint32_t next = 0;
+    for (size_t i=0; i<footer.entryCount; i++) {
+        xioAPI_Log::IndexEntry entry;
+        CHECK(xioAPI_Log::readIndexEntry(file.data() + footer.indexOffset + i * XIOAPI_LOG_INDEX_ENTRY_SIZE, &entry));
+        CHECK(entry.firstBlock == next && entry.blockCount > 0);
+
+        uint16_t typeMask = 0;
+        uint64_t first = UINT64_MAX, last = 0;
+        for (uint32_t b=entry.firstBlock; b<entry.firstBlock + entry.blockCount && b<reader.getBlockCount(); b++) {
+            xioAPI_Log::BlockHeader header;
+            CHECK(reader.getBlockHeader(b, &header));
+            if (b == entry.firstBlock) CHECK(entry.firstSequence == header.sequence);
+            typeMask |= header.typeMask;
+            if (header.firstTimestamp < first) first = header.firstTimestamp;
+            if (header.lastTimestamp > last) last = header.lastTimestamp;
+        }
+        CHECK(entry.typeMask == typeMask && entry.firstTimestamp == first && entry.lastTimestamp == last);
+        next += entry.blockCount;
+    }
+    CHECK(next == reader.getBlockCount());
+}
+
+static void checkFile(const std::vector<RawRecord>& stream, DataLoggerFormat format) {
+    bool exact = format == DATA_LOGGER_FORMAT_INDEXED; // Compressed logs round the values
+    LogDirectory directory;
+    DataLoggerStats stats;
+    std::string path = writeRecordLog(directory, stream, format, 0, &stats)[0];
+    std::vector<uint8_t> data = readFile(path);
+
+    LogReader reader;
+    CHECK(reader.open(path.c_str()) && !reader.isRecovered());
+    CHECK(reader.getBlockCount() == stats.blocksWritten);
+    CHECK(reader.getSettings() != nullptr && memcmp(reader.getSettings(), getLogSettings().data(), getLogSettings().size()) == 0);
+    checkIndex(reader, data);
+
+    // Every sample of every type
+    LogRange all = reader.getRange();
+    CHECK(checkAllTypes(reader, all, stream, exact) == stream.size());
+
+    // Timestamp ranges, including ones that start before or end after the samples
+    uint64_t first = stream.front().timestamp;
+    uint64_t last = stream.back().timestamp;
+    srand(9);
+    for (int i=0; i<100 && testFailures == 0; i++) {
+        uint64_t from = first - 5000 + (uint64_t) rand() * (last - first + 10000) / RAND_MAX;
+        uint64_t to = from + (uint64_t) rand() * (i % 2 ? 20000 : 2000000) / RAND_MAX;
+        LogRange range = reader.getRange(from, to);
+        checkRange(reader, range);
+        checkCursor<InertialMessage>(reader, range, stream, exact);
+        checkCursor<TemperatureMessage>(reader, range, stream, exact);
+    }
+    // Ranges that start or end exactly on the first or last sample of a block
+    for (size_t b=0; b<reader.getBlockCount() && testFailures == 0; b++) {
+        xioAPI_Log::BlockHeader header;
+        CHECK(reader.getBlockHeader(b, &header));
+        const LogRange edges[] = {
+            reader.getRange(header.firstTimestamp, header.firstTimestamp),
+            reader.getRange(header.lastTimestamp, header.lastTimestamp),
+            reader.getRange(header.lastTimestamp, header.lastTimestamp + 1),
+            reader.getRange(header.firstTimestamp - 1, header.lastTimestamp)
+        };
+        for (const LogRange& range : edges) {
+            checkRange(reader, range);
+            CHECK(range.firstBlock <= b && range.endBlock > b);
+        }
+        if (b % 16 == 0) checkCursor<InertialMessage>(reader, edges[3], stream, exact);
+    }
+    LogRange none = reader.getRange(last + 1, UINT64_MAX);
+    CHECK(none.firstBlock == none.endBlock && none.firstBlock == reader.getBlockCount());
+
+    // Four threads over disjoint chunks read every sample once
+    LogRange chunks[4];
+    CHECK(reader.split(all, chunks, 4) == 4);
+    size_t counts[4] = {0};
+    std::vector<std::thread> threads;
+    for (size_t c=0; c<4; c++) {
+        CHECK(chunks[c].firstBlock == (c == 0 ? 0 : chunks[c - 1].endBlock) && chunks[c].endBlock > chunks[c].firstBlock);
+        threads.emplace_back([&, c]() {
+            LogCursor<InertialMessage> cursor(reader, chunks[c]);
+            InertialMessage message;
+            uint64_t timestamp;
+            while (cursor.next(&message, &timestamp)) counts[c]++;
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    CHECK(chunks[3].endBlock == reader.getBlockCount());
+    CHECK(counts[0] + counts[1] + counts[2] + counts[3] == checkCursor<InertialMessage>(reader, all, stream, exact));
+    LogRange small = reader.getRange(first, first + 1000); // One block
+    CHECK(reader.split(small, chunks, 4) == 1 && chunks[0].firstBlock == small.firstBlock && chunks[0].endBlock == small.endBlock);
+
+    // A damaged index or footer is not trusted, and the blocks are recovered the same
+    std::string copy = directory.getPath() + "/copy.bin";
+    size_t footerOffset = data.size() - XIOAPI_LOG_FOOTER_SIZE;
+    const size_t damaged[] = {footerOffset - 10, footerOffset + 2, footerOffset + XIOAPI_LOG_FOOTER_SIZE - 1};
+    for (size_t offset : damaged) {
+        data[offset] ^= 0x01;
+        writeFile(copy, data, data.size());
+        data[offset] ^= 0x01;
+        LogReader recovered;
+        CHECK(recovered.open(copy.c_str()) && recovered.isRecovered());
+        CHECK(recovered.getBlockCount() == reader.getBlockCount());
+        LogRange range = recovered.getRange(first + 123456, first + 234567);
+        CHECK(range.firstBlock == reader.getRange(first + 123456, first + 234567).firstBlock);
+        CHECK(range.endBlock == reader.getRange(first + 123456, first + 234567).endBlock);
+    }
+    writeFile(copy, data, data.size() - 1);
+    LogReader cut;
+    CHECK(cut.open(copy.c_str()) && cut.isRecovered() && cut.getBlockCount() == reader.getBlockCount());
+
+    // A file cut off mid-block by power loss keeps its whole blocks
+    size_t headerSize = (size_t) reader.getFileHeader().headerBlocks * XIOAPI_LOG_BLOCK_SIZE;
+    size_t records = 0;
+    for (size_t b=0; b<10; b++) {
+        xioAPI_Log::BlockHeader header;
+        CHECK(reader.getBlockHeader(b, &header));
+        records += header.recordCount;
+    }
+    writeFile(copy, data, headerSize + 10 * XIOAPI_LOG_BLOCK_SIZE + XIOAPI_LOG_BLOCK_SIZE / 2);
+    LogReader truncated;
+    CHECK(truncated.open(copy.c_str()) && truncated.isRecovered() && truncated.getBlockCount() == 10);
+    CHECK(checkAllTypes(truncated, truncated.getRange(), stream, exact, records) == records);
+
+    // A damaged block is skipped and counted
+    xioAPI_Log::BlockHeader header;
+    CHECK(reader.getBlockHeader(5, &header));
+    data[headerSize + 5 * XIOAPI_LOG_BLOCK_SIZE + XIOAPI_LOG_BLOCK_HEADER_SIZE + 100] ^= 0x10;
+    writeFile(copy, data, data.size());
+    LogReader damagedBlock;
+    CHECK(damagedBlock.open(copy.c_str()) && !damagedBlock.isRecovered());
+    LogCursor<InertialMessage> cursor(damagedBlock, damagedBlock.getRange());
+    InertialMessage message;
+    uint64_t timestamp;
+    size_t count = 0;
+    while (cursor.next(&message, &timestamp)) count++;
+    CHECK(cursor.getCorruptBlocks() == 1 && count < checkCursor<InertialMessage>(reader, all, stream, exact));
+}
+
+int main() {
+    std::vector<RawRecord> stream = buildRecordStream(300000);
+    checkFile(stream, DATA_LOGGER_FORMAT_INDEXED);
+    checkFile(stream, DATA_LOGGER_FORMAT_COMPRESSED);
+
+    // Files that are not indexed logs are refused
+    LogDirectory directory;
+    std::string text = writeLog(directory, joinMessages(buildTextMessages(1000)), makeLoggerConfig(DATA_LOGGER_FORMAT_TEXT))[0];
+    LogReader reader;
+    CHECK(!reader.open(text.c_str()) && !reader.isOpen());
+    CHECK(!reader.open((directory.getPath() + "/missing.bin").c_str()));
+
+    return testResult("test_log_reader");
+}
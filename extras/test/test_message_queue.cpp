@@ -0,0 +1,90 @@
+/******************************************************************
+    @file       test_message_queue.cpp
+    @brief      Host tests of the lock-free MPSC message queue, including a multi-producer stress test
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_MessageQueue.h"
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#define PRODUCERS 4
+#define RECORDS_PER_PRODUCER 250000
+
+/**
+ * @brief A record wider than one store, so a torn read shows up as a bad check word
+*/
+struct Record {
+    uint32_t producer;
+    uint32_t sequence;
+    uint64_t check;
+    float values[6];
+};
+
+static Record makeRecord(uint32_t producer, uint32_t sequence) {
+    Record record;
+    record.producer = producer;
+    record.sequence = sequence;
+    record.check = ((uint64_t) producer << 32 | sequence) * 0x9E3779B97F4A7C15ull;
+    for (int i=0; i<6; i++) record.values[i] = (float) (sequence + i);
+    return record;
+}
+
+static bool isRecord(const Record& record) {
+    if (record.producer >= PRODUCERS) return false;
+    Record expected = makeRecord(record.producer, record.sequence);
+    return memcmp(&record, &expected, sizeof(record)) == 0;
+}
+
+int main() {
+    // One thread: FIFO order, and a full queue refuses records instead of overwriting them
+    static MPSCQueue<Record, 8> small;
+    CHECK(small.isEmpty());
+    for (uint32_t i=0; i<8; i++) CHECK(small.push(makeRecord(0, i)));
+    CHECK(!small.push(makeRecord(0, 8)) && small.size() == 8);
+    Record record;
+    for (uint32_t i=0; i<8; i++) CHECK(small.pop(record) && record.sequence == i);
+    CHECK(!small.pop(record) && small.isEmpty());
+
+    // Producers on several threads: every record arrives once, whole, and in order per producer
+    static MPSCQueue<Record, 64> queue;
+    std::vector<std::thread> producers;
+    for (uint32_t p=0; p<PRODUCERS; p++) {
+        producers.push_back(std::thread([p]() {
+            for (uint32_t i=0; i<RECORDS_PER_PRODUCER; ) {
+                if (queue.push(makeRecord(p, i))) i++;
+                else std::this_thread::yield(); // Full; let the consumer run on a single CPU
+            }
+        }));
+    }
+
+    uint32_t next[PRODUCERS] = {};
+    size_t received = 0, errors = 0;
+    while (received < (size_t) PRODUCERS * RECORDS_PER_PRODUCER) {
+        if (!queue.pop(record)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (!isRecord(record) || record.sequence != next[record.producer]) errors++;
+        else next[record.producer]++;
+        received++;
+    }
+    for (std::thread& producer : producers) producer.join();
+
+    CHECK(errors == 0);
+    CHECK(queue.isEmpty() && !queue.pop(record));
+    for (uint32_t p=0; p<PRODUCERS; p++) CHECK(next[p] == RECORDS_PER_PRODUCER);
+
+    return testResult("test_message_queue");
+}
@@ -0,0 +1,177 @@
+/******************************************************************
+    @file       test_replay.cpp
+    @brief      Host tests of replaying data logger files, and of the replay pacing
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "log_files.h"
+#include "xioAPI_Compression.h"
+#include "xioAPI_LogReader.h"
+#include "xioAPI_Replay.h"
+
+#define CLOCK_STEP 250 // µs between calls of LogReplay::next() with a new time
+
+static LogReplay replay;
+
+/**
+ * @brief Checks that a replayed sample has the values of the logged record. Compressed logs
+ * round the values to `XIOAPI_COMPRESSION_DECIMALS` decimal places.
+*/
+static void checkSample(const ReplayMessage& message, const RawRecord& logged, bool compressed) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    size_t rawLen = xioAPI_Binary::encodeRawRecord(raw, sizeof(raw), message.record);
+    CHECK(rawLen == logged.size && raw[0] == logged.data[0]);
+    CHECK(message.size == 0 && message.timestamp == logged.timestamp);
+    xioAPI_Log::setRecordTimestamp(raw, rawLen, message.timestamp);
+    if (!compressed) {
+        CHECK(memcmp(raw, logged.data, rawLen) == 0);
+        return;
+    }
+
+    const float tolerance = 0.5f * powf(10, -XIOAPI_COMPRESSION_DECIMALS) * 1.01f;
+    for (size_t offset=XIOAPI_BINARY_HEADER_SIZE; offset + 4 < rawLen; offset += 4) {
+        float value, expected;
+        memcpy(&value, raw + offset, 4);
+        memcpy(&expected, logged.data + offset, 4);
+        CHECK(fabsf(value - expected) <= tolerance + fabsf(expected) * 1e-6f);
+    }
+}
+
+/**
+ * @brief Replays an indexed log as fast as possible and compares every sample
+*/
+static void checkIndexedReplay(const std::vector<RawRecord>& stream, DataLoggerFormat format) {
+    LogDirectory directory;
+    std::vector<std::string> paths = writeRecordLog(directory, stream, format);
+    CHECK(paths.size() == 1);
+
+    POSIXReplaySource source;
+    CHECK(source.open(paths[0].c_str()));
+    CHECK(replay.begin(&source, XIOAPI_REPLAY_SPEED_MAX));
+    ReplayMessage message;
+    size_t count = 0;
+    while (replay.next(0, &message)) {
+        if (count < stream.size()) checkSample(message, stream[count], format == DATA_LOGGER_FORMAT_COMPRESSED);
+        count++;
+        if (testFailures > 0) break;
+    }
+    CHECK(count == stream.size() && !replay.isRunning());
+    CHECK(replay.getStats().messages == stream.size() && replay.getStats().errors == 0);
+
+    // A file cut short by power loss has no index; the whole blocks are replayed
+    std::vector<uint8_t> data = readFile(paths[0]);
+    LogReader reader;
+    CHECK(reader.open(paths[0].c_str()));
+    size_t headerSize = (size_t) reader.getFileHeader().headerBlocks * XIOAPI_LOG_BLOCK_SIZE;
+    size_t records = 0;
+    for (size_t b=0; b<3; b++) {
+        xioAPI_Log::BlockHeader header;
+        CHECK(reader.getBlockHeader(b, &header));
+        records += header.recordCount;
+    }
+    FILE* file = fopen(paths[0].c_str(), "wb");
+    fwrite(data.data(), 1, headerSize + 3 * XIOAPI_LOG_BLOCK_SIZE + 1000, file);
+    fclose(file);
+
+    CHECK(source.open(paths[0].c_str()));
+    CHECK(replay.begin(&source, XIOAPI_REPLAY_SPEED_MAX));
+    count = 0;
+    while (replay.next(0, &message)) count++;
+    CHECK(count == records && replay.getStats().errors == 0);
+}
+
+/**
+ * @brief Replays a text log of ASCII messages and binary frames, with a line that is neither
+*/
+static void checkTextReplay() {
+    std::vector<std::string> messages = buildTextMessages(20000);
+    for (size_t i=9; i<messages.size(); i+=10) { // Every tenth message is a binary frame
+        xioAPI_Protocol::InertialMessage inertial = {0.5f, -0.25f, 1.0f, 10.0f, 20.0f, 30.0f, (uint32_t) (0xFFFF0000u + i * 1000)};
+        uint8_t frame[XIOAPI_BINARY_MAX_FRAME_SIZE];
+        size_t len = xioAPI_Binary::encodeInertialMessage(frame, sizeof(frame), inertial);
+        messages[i].assign((const char*) frame, len);
+    }
+    std::vector<std::string> logged = messages;
+    logged.insert(logged.begin() + 5000, "Not a data message\r\n");
+
+    LogDirectory directory;
+    std::vector<std::string> paths = writeLog(directory, joinMessages(logged), makeLoggerConfig(DATA_LOGGER_FORMAT_TEXT));
+    CHECK(paths.size() == 1);
+
+    POSIXReplaySource source;
+    CHECK(source.open(paths[0].c_str()));
+    CHECK(replay.begin(&source, XIOAPI_REPLAY_SPEED_MAX));
+    ReplayMessage message;
+    size_t count = 0;
+    while (replay.next(0, &message)) {
+        if (count < messages.size()) {
+            CHECK(std::string((const char*) message.data, message.size) == messages[count]);
+            CHECK(message.timestamp == 0xFFFF0000ull + count * 1000); // Extended past the 32-bit wrap
+        }
+        count++;
+    }
+    CHECK(count == messages.size());
+    CHECK(replay.getStats().errors == 1 && replay.getStats().bytes == joinMessages(messages).size());
+}
+
+/**
+ * @brief Replays a 1 kHz log against a simulated microsecond clock, which wraps. Each message must be
+ * released in the first call at or after its due time, and the achieved rate must be the log rate
+ * times the speed.
+*/
+static void checkPacing(const std::string& path, size_t records, float speed) {
+    POSIXReplaySource source;
+    CHECK(source.open(path.c_str()));
+    CHECK(replay.begin(&source, speed));
+
+    uint32_t now = 0xFFFFFF00u;
+    uint64_t clock = 0;
+    uint64_t first = 0;
+    uint64_t worst = 0;
+    size_t count = 0;
+    size_t early = 0;
+    ReplayMessage message;
+    while (replay.isRunning()) {
+        while (replay.next(now, &message)) {
+            if (count++ == 0) first = message.timestamp;
+            uint64_t due = (uint64_t) ((message.timestamp - first) / (double) speed);
+            if (clock < due) early++;
+            else if (clock - due > worst) worst = clock - due;
+        }
+        now += CLOCK_STEP;
+        clock += CLOCK_STEP;
+    }
+
+    const ReplayStats& stats = replay.getStats();
+    CHECK(count == records && early == 0);
+    CHECK(worst < CLOCK_STEP && stats.lag == worst);
+    float expectedRate = 1000 * speed;
+    CHECK(fabsf(replay.getMessageRate() - expectedRate) < expectedRate * 0.01f);
+}
+
+int main() {
+    std::vector<RawRecord> stream = buildRecordStream(50000);
+    checkIndexedReplay(stream, DATA_LOGGER_FORMAT_INDEXED);
+    checkIndexedReplay(stream, DATA_LOGGER_FORMAT_COMPRESSED);
+    checkTextReplay();
+
+    // Real time and faster, over 3 s of samples
+    std::vector<RawRecord> samples(stream.begin(), stream.begin() + 3000);
+    LogDirectory directory;
+    std::vector<std::string> paths = writeRecordLog(directory, samples, DATA_LOGGER_FORMAT_COMPRESSED);
+    checkPacing(paths[0], samples.size(), 1.0f);
+    checkPacing(paths[0], samples.size(), 4.0f);
+    checkPacing(paths[0], samples.size(), 0.5f);
+
+    return testResult("test_replay");
+}
@@ -0,0 +1,130 @@
+/******************************************************************
+    @file       test_setting_json.cpp
+    @brief      Host tests of the setting message writer and the readAll batches
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_SettingJSON.h"
+#include "xioAPI_Command.h"
+#include "xioAPI_Protocol.h"
+#include <math.h>
+#include <string.h>
+#include <string>
+
+using namespace xioAPI_Types;
+using namespace xioAPI_SettingJSON;
+
+static bool appendString(const char* data, size_t size, void* context) {
+    static_cast<std::string*>(context)->append(data, size);
+    return true;
+}
+
+static bool failAfterTwo(const char* data, size_t size, void* context) {
+    (void) data;
+    (void) size;
+    return ++*static_cast<int*>(context) <= 2;
+}
+
+static std::string write(const settingTableEntry& entry) {
+    char out[512];
+    size_t len = writeSettingJSON(out, sizeof(out), &entry);
+    return std::string(out, len);
+}
+
+int main() {
+    bool flag = true;
+    uint8_t byte = 200;
+    int number = -42;
+    float scalar = 0.1f;
+    float nan = NAN;
+    xioVector vector = {{1.0f, -2.5f, 0.3f}};
+    xioMatrix matrix = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+    char text[16] = "a\"b\\c\n";
+
+    CHECK(write({"b", 0, &flag, BOOL, 0}) == "{\"b\":true}");
+    CHECK(write({"c", 0, &byte, CHAR, 0}) == "{\"c\":200}");
+    CHECK(write({"i", 0, &number, INT, 0}) == "{\"i\":-42}");
+    CHECK(write({"f", 0, &scalar, FLOAT, 0}) == "{\"f\":0.100000001}");
+    CHECK(write({"n", 0, &nan, FLOAT, 0}) == "{\"n\":null}");
+    CHECK(write({"v", 0, &vector, VECTOR, 0}) == "{\"v\":[1,-2.5,0.300000012]}");
+    CHECK(write({"m", 0, &matrix, MATRIX, 0}) == "{\"m\":[1,0,0,0,1,0,0,0,1]}");
+    CHECK(write({"s", 0, text, CHAR_ARRAY, sizeof(text)}) == "{\"s\":\"a\\\"b\\\\c\\u000a\"}");
+
+    // Every message reads back through the command parser with the same value
+    char message[512];
+    std::string json = write({"s", 0, text, CHAR_ARRAY, sizeof(text)});
+    strcpy(message, json.c_str());
+    xioAPI_Command::Command command;
+    CHECK(xioAPI_Command::parseCommand(message, json.size(), &command) && strcmp(command.value.as<const char*>(), text) == 0);
+    json = write({"v", 0, &vector, VECTOR, 0});
+    strcpy(message, json.c_str());
+    CHECK(xioAPI_Command::parseCommand(message, json.size(), &command) && command.value[2].as<float>() == vector.array[2]);
+
+    // A message that does not fit writes nothing
+    char small[8];
+    const settingTableEntry integer = {"i", 0, &number, INT, 0};
+    CHECK(writeSettingJSON(small, sizeof(small), &integer) == 0);
+
+    // A batch that fills its buffer exactly refuses the next setting without writing past the buffer
+    const settingTableEntry& entry = integer;
+    const size_t messageLen = write(entry).size() + 2; // With CRLF
+    for (size_t capacity=1; capacity<4*messageLen; capacity++) {
+        char buffer[128];
+        memset(buffer, '#', sizeof(buffer));
+        SettingBatch batch(buffer, capacity);
+        size_t added = 0;
+        while (batch.add(&entry)) added++;
+        CHECK(added == capacity / messageLen);
+        CHECK(batch.size() == added * messageLen && batch.size() <= capacity);
+        for (size_t i=capacity; i<sizeof(buffer); i++) CHECK(buffer[i] == '#');
+        if (capacity % messageLen == 0) CHECK(batch.size() == capacity); // The exact fill
+    }
+
+    // Cleared batches start again at the front
+    char buffer[64];
+    SettingBatch batch(buffer, sizeof(buffer));
+    CHECK(batch.isEmpty() && batch.add(&entry) && !batch.isEmpty());
+    batch.clear();
+    CHECK(batch.add(&entry) && batch.size() == messageLen && memcmp(batch.data(), "{\"i\":-42}\r\n", messageLen) == 0);
+
+    // A configuration file reads back through the object reader, skipping empty and unknown entries
+    const settingTableEntry table[] = {
+        {"deviceName", xioAPI_Protocol::DEVICE_NAME, text, CHAR_ARRAY, sizeof(text)},
+        {nullptr, 0, nullptr, BOOL, 0},
+        {"softIronMatrix", xioAPI_Protocol::SOFT_IRON_MATRIX, &matrix, MATRIX, 0},
+        {"unknown", 0, &number, (SettingType) 99, 0},
+        {"udpSendPort", xioAPI_Protocol::UDP_SEND_PORT, &number, INT, 0},
+    };
+    std::string file;
+    CHECK(writeConfigurationJSON(table, sizeof(table) / sizeof(table[0]), appendString, &file));
+    CHECK(file.front() == '{' && file.back() == '}' && file.find("unknown") == std::string::npos);
+    xioAPI_Command::ObjectReader reader;
+    reader.reset();
+    size_t members = 0;
+    for (char c : file) {
+        xioAPI_Command::Command member;
+        if (!reader.read(c, &member)) continue;
+        members++;
+        if (member.hash == xioAPI_Protocol::DEVICE_NAME) CHECK(strcmp(member.value.as<const char*>(), text) == 0);
+        if (member.hash == xioAPI_Protocol::SOFT_IRON_MATRIX) CHECK(member.value.size() == 9 && member.value[4].as<float>() == 1.0f);
+        if (member.hash == xioAPI_Protocol::UDP_SEND_PORT) CHECK(member.value.as<int>() == number);
+    }
+    CHECK(members == 3 && reader.isComplete() && reader.getErrors() == 0);
+
+    // A failed write stops the file
+    int writes = 0;
+    CHECK(!writeConfigurationJSON(table, sizeof(table) / sizeof(table[0]), failAfterTwo, &writes));
+    CHECK(writes == 3);
+
+    return testResult("test_setting_json");
+}
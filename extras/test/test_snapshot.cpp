@@ -0,0 +1,87 @@
+/******************************************************************
+    @file       test_snapshot.cpp
+    @brief      Host tests of the binary settings snapshot and its file storage
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_Snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace xioAPI_Snapshot;
+
+int main() {
+    uint8_t buffer[XIOAPI_SNAPSHOT_MAX_SIZE];
+    float matrix[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    int port = 9000;
+    const char name[] = "Thetis";
+
+    SnapshotWriter writer(buffer, sizeof(buffer));
+    writer.setSource(3061, 1792195200);
+    CHECK(writer.add(0x1111, 3, &port, sizeof(port)));
+    CHECK(writer.add(0x2222, 4, matrix, sizeof(matrix)));
+    CHECK(writer.add(0x3333, 1, name, sizeof(name)));
+    size_t size = writer.finish();
+    CHECK(size == XIOAPI_SNAPSHOT_HEADER_SIZE + 3 * XIOAPI_SNAPSHOT_FIELD_SIZE + sizeof(port) + sizeof(matrix) + sizeof(name));
+
+    SnapshotReader reader;
+    CHECK(reader.open(buffer, size) && reader.getFieldCount() == 3);
+    CHECK(reader.getSourceSize() == 3061 && reader.getSourceStamp() == 1792195200); // The configuration file it was made from
+    SnapshotField field;
+    CHECK(reader.next(&field) && field.hash == 0x1111 && field.type == 3 && memcmp(field.value, &port, sizeof(port)) == 0);
+    CHECK(reader.next(&field) && field.hash == 0x2222 && field.size == sizeof(matrix) && memcmp(field.value, matrix, sizeof(matrix)) == 0);
+    CHECK(reader.next(&field) && strcmp((const char*) field.value, name) == 0);
+    CHECK(!reader.next(&field));
+
+    // Extra trailing bytes (e.g. the rest of the EEPROM) are ignored
+    CHECK(reader.open(buffer, sizeof(buffer)));
+
+    // Truncated, corrupt and foreign data is rejected
+    CHECK(!reader.open(buffer, size - 1));
+    CHECK(!reader.open(buffer, XIOAPI_SNAPSHOT_HEADER_SIZE - 1));
+    buffer[size - 2] ^= 0x01;
+    CHECK(!reader.open(buffer, size));
+    buffer[size - 2] ^= 0x01;
+    buffer[4]++; // Version
+    CHECK(!reader.open(buffer, size));
+    buffer[4]--;
+    uint8_t erased[XIOAPI_SNAPSHOT_MAX_SIZE];
+    memset(erased, 0xFF, sizeof(erased));
+    CHECK(!reader.open(erased, sizeof(erased)));
+    memset(erased, 0, XIOAPI_SNAPSHOT_HEADER_SIZE); // An invalidated snapshot
+    CHECK(!reader.open(erased, sizeof(erased)));
+
+    // A snapshot that does not fit fails as a whole
+    uint8_t small[40];
+    SnapshotWriter smallWriter(small, sizeof(small));
+    CHECK(smallWriter.add(0x1111, 3, &port, sizeof(port)));
+    CHECK(!smallWriter.add(0x2222, 4, matrix, sizeof(matrix)));
+    CHECK(smallWriter.finish() == 0);
+
+    // File storage replaces the whole snapshot
+    char path[] = "/tmp/xioapi_snapshot_XXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    close(fd);
+    unlink(path);
+    POSIXSnapshotStorage storage(path);
+    uint8_t readBack[XIOAPI_SNAPSHOT_MAX_SIZE];
+    CHECK(storage.read(readBack, sizeof(readBack)) == 0);
+    CHECK(storage.write(buffer, size));
+    CHECK(storage.read(readBack, sizeof(readBack)) == size && memcmp(readBack, buffer, size) == 0);
+    CHECK(reader.open(readBack, size));
+    unlink(path);
+
+    return testResult("test_snapshot");
+}
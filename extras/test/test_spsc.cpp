@@ -0,0 +1,141 @@
+/******************************************************************
+    @file       test_spsc.cpp
+    @brief      Host tests of the lock-free SPSC circular buffer, including a two-thread stress test
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "test.h"
+#include "xioAPI_SPSCBuffer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+/**
+ * @brief An element that is wider than one store, so a torn read shows up as a bad check word
+*/
+struct Sample {
+    uint64_t sequence;
+    uint64_t check;
+    uint32_t words[4];
+};
+
+static Sample makeSample(uint64_t sequence) {
+    Sample sample;
+    sample.sequence = sequence;
+    sample.check = ~sequence * 0x9E3779B97F4A7C15ull;
+    for (uint32_t i=0; i<4; i++) sample.words[i] = (uint32_t) (sequence >> i) ^ i;
+    return sample;
+}
+
+static bool isSample(const Sample& sample, uint64_t sequence) {
+    Sample expected = makeSample(sequence);
+    return memcmp(&sample, &expected, sizeof(sample)) == 0;
+}
+
+/**
+ * @brief One producer and one consumer move `count` samples through a small buffer, each mixing single
+ * and bulk operations, while the consumer checks that every sample arrives once, in order and whole
+*/
+static void stress(uint64_t count) {
+    static SPSCCircularBuffer<Sample, 61> buffer; // Not a power of two, so the indices wrap at odd places
+    buffer.clear();
+
+    std::thread producer([&]() {
+        unsigned int seed = 7;
+        Sample batch[16];
+        uint64_t next = 0;
+        while (next < count) {
+            uint64_t before = next;
+            size_t n = rand_r(&seed) % 16 + 1;
+            if (n > count - next) n = count - next;
+            for (size_t i=0; i<n; i++) batch[i] = makeSample(next + i);
+
+            switch (rand_r(&seed) % 3) {
+                case 0: // One at a time
+                    for (size_t i=0; i<n && buffer.push(batch[i]); i++) next++;
+                    break;
+                case 1: // All or nothing
+                    if (buffer.push(batch, n, CIRCULAR_BUFFER_REJECT) == 0) next += n;
+                    break;
+                default: // As many as fit; overwriting must not touch unread samples
+                    next += n - buffer.push(batch, n, rand_r(&seed) % 2 ? CIRCULAR_BUFFER_TRUNCATE : CIRCULAR_BUFFER_OVERWRITE);
+                    break;
+            }
+            if (next == before) std::this_thread::yield(); // Full; let the consumer run on a single CPU
+        }
+    });
+
+    unsigned int seed = 11;
+    uint64_t expected = 0;
+    size_t errors = 0;
+    while (expected < count) {
+        uint64_t before = expected;
+        if (rand_r(&seed) % 2) {
+            Sample sample;
+            if (buffer.shift(sample)) {
+                if (!isSample(sample, expected)) errors++;
+                expected++;
+            }
+        }
+        else {
+            SPSCCircularBuffer<Sample, 61>::Span first, second;
+            size_t n = buffer.spans(first, second);
+            CHECK(first.length + second.length == n);
+            size_t take = n == 0 ? 0 : rand_r(&seed) % n + 1;
+            for (size_t i=0; i<take; i++) {
+                const Sample& sample = i < first.length ? first.data[i] : second.data[i - first.length];
+                if (!isSample(sample, expected + i)) errors++;
+            }
+            buffer.consume(take);
+            expected += take;
+        }
+        if (expected == before) std::this_thread::yield(); // Empty
+    }
+    producer.join();
+
+    CHECK(errors == 0);
+    CHECK(buffer.isEmpty());
+}
+
+int main() {
+    // Single-threaded behaviour matches the FIFO subset of CircularBuffer
+    SPSCCircularBuffer<int, 5> buffer;
+    int values[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    CHECK(buffer.isEmpty() && buffer.available() == 5);
+    CHECK(buffer.push(values, 3, CIRCULAR_BUFFER_REJECT) == 0);
+    CHECK(buffer.push(values + 3, 3, CIRCULAR_BUFFER_REJECT) == 3 && buffer.size() == 3); // Rejected whole
+    CHECK(buffer.push(values + 3, 3, CIRCULAR_BUFFER_TRUNCATE) == 1 && buffer.isFull());
+    CHECK(!buffer.push(7)); // Never overwrites
+
+    int value;
+    CHECK(buffer.shift(value) && value == 0);
+    CHECK(buffer.shift(value) && value == 1);
+    CHECK(buffer.push(values + 5, 2)); // Wraps around the end of the storage
+
+    SPSCCircularBuffer<int, 5>::Span first, second;
+    CHECK(buffer.spans(first, second) == 5);
+    int order[5], k = 0;
+    for (size_t i=0; i<first.length; i++) order[k++] = first.data[i];
+    for (size_t i=0; i<second.length; i++) order[k++] = second.data[i];
+    CHECK(second.length > 0); // The readable elements really were split
+    for (int i=0; i<5; i++) CHECK(order[i] == i + 2);
+
+    buffer.consume(4);
+    CHECK(buffer.size() == 1 && buffer.shift(value) && value == 6);
+    buffer.consume(1); // More than is readable
+    CHECK(buffer.isEmpty() && !buffer.shift(value));
+
+    // Two threads
+    stress(1000000);
+
+    return testResult("test_spsc");
+}
@@ -19,7 +19,7 @@
 #include "xioAPI.h"
 
 xioAPI api;
-CircularBuffer<char,8192> dataASCIIBuffer;
+xioDataBuffer dataASCIIBuffer;
 
 using namespace xioAPI_Types;
 using namespace xioAPI_Protocol;
@@ -55,52 +55,11 @@ bool xioAPI::begin(Stream* port, WiFiUDP* server) {
 void xioAPI::sendSetting(const settingTableEntry* entry) {
     // Setting format: {"[setting]":[value]}\r\n
 
-    StaticJsonDocument<256> _doc;
-    char _out[256];
-
-    const char* key = entry->key;
-    SettingType _entryType = entry->type;
-    void* _entryValue = entry->value;
-    JsonArray _settingArray;
-    xioVector* _vector;
-    xioMatrix* _matrix;
-
-    switch (_entryType) {
-        case BOOL:
-            _doc[key] = *(bool*) _entryValue;
-            break;
-        case CHAR:
-            _doc[key] = *(uint8_t*) _entryValue;
-            break;
-        case FLOAT:
-            _doc[key] = *(float*) _entryValue;
-            break;
-        case INT:
-            _doc[key] = *(int*) _entryValue;
-            break;
-        case VECTOR:
-            _settingArray = _doc.createNestedArray(key);
-            _vector = static_cast<xioVector*>(_entryValue);
-            for (size_t i=0; i<3; i++) {
-                _settingArray.add(_vector->array[i]);
-            }
-            break;
-        case MATRIX:
-            _settingArray = _doc.createNestedArray(key);
-            _matrix = static_cast<xioMatrix*>(_entryValue);
-            for (size_t i=0; i<9; i++) {
-                _settingArray.add(_matrix->array[i/3][i%3]);
-            }
-            break;
-        case CHAR_ARRAY:
-            _doc[key] = (const char*) _entryValue;
-            break;
-        default:
-            return;
-    }
-
-    size_t outLen = serializeJson(_doc, _out);
-    send("%s", _out);
+    char _out[XIOAPI_SETTING_MESSAGE_SIZE];
+    size_t outLen = xioAPI_SettingJSON::writeSettingJSON(_out, sizeof(_out) - 1, entry);
+    if (outLen == 0) return;
+    _out[outLen] = '\0';
+    sendString(_out, outLen);
 }
 
 /**
@@ -128,7 +87,7 @@ void xioAPI::sendPing(Ping ping) {
     root["serialNumber"] = "Unknown";
 
     size_t outLen = serializeJson(_doc, _out);
-    send("%s", _out);
+    sendString(_out, outLen);
 }
 
 /**
@@ -171,17 +130,75 @@ void xioAPI::sendNetworkAnnouncement(NetworkAnnouncement na) {
     sendUDP((uint8_t*) _out, outLen, "255.255.255.255", 10000);
 }
 
+/**
+ * @brief Sends every setting in response to `readAll`. The setting messages are written straight into
+ * a batch that fills a UDP datagram, and each batch is sent with one serial write and one datagram.
+ * The cost of the response is reported by `getSettingTableStats()`.
+*/
 void xioAPI::sendSettingTable() {
+    char buffer[XIOAPI_UDP_MAX_PAYLOAD_SIZE];
+    xioAPI_SettingJSON::SettingBatch batch(buffer, sizeof(buffer));
+    uint32_t start = micros();
+    _settingTableStats = {0, 0, 0, 0};
+
     for (size_t i=0; i<SETTING_TABLE_SIZE; i++) {
         if (settingTable[i].key == nullptr) continue; // Skip sending the setting if the key (entry) is empty
-        sendSetting(&settingTable[i]);
+
+        if (!batch.add(&settingTable[i])) {
+            if (batch.isEmpty()) continue; // The setting cannot be formatted, or does not fit in a datagram on its own
+            sendSettingBatch(batch.data(), batch.size()); // The batch is full
+            batch.clear();
+            if (!batch.add(&settingTable[i])) continue;
+        }
+        _settingTableStats.settings++;
+    }
+    if (!batch.isEmpty()) sendSettingBatch(batch.data(), batch.size());
+
+    _settingTableStats.duration = micros() - start;
+}
+
+/**
+ * @brief Sends a batch of CRLF-terminated messages with one serial write and one UDP datagram
+*/
+void xioAPI::sendSettingBatch(const char* batch, size_t size) {
+    if (_serialPort != nullptr) _serialPort->write((const uint8_t*) batch, size);
+    if (_udpServer != nullptr && settings.wirelessMode) {
+        flushUDP(); // Keep the messages in order
+        beginUDPPacket();
+        _udpServer->write((const uint8_t*) batch, size);
+        _udpServer->endPacket();
     }
+    _settingTableStats.packets++;
+    _settingTableStats.bytes += size;
 }
 
+/**
+ * @brief Sends the settings as a JSON configuration file. The file is written straight from the setting
+ * table a setting at a time (`writeConfigurationJSON()`), so it is never held in memory as a whole.
+ * Over UDP, it is split between lines into datagrams of up to `XIOAPI_UDP_MAX_PAYLOAD_SIZE` bytes.
+*/
 void xioAPI::sendSettingFile() {
-    char _out[6144];
-    size_t outLen = serializeJsonPretty(_jsonConfigDoc, _out);
-    send("%s", _out);
+    _settingFilePacketLen = 0;
+    if (_udpServer != nullptr && settings.wirelessMode) flushUDP(); // Keep the messages in order
+
+    xioAPI_SettingJSON::writeConfigurationJSON(settingTable, SETTING_TABLE_SIZE, sendSettingFilePart, this);
+    sendSettingFilePart("\r\n", 2, this);
+    if (_settingFilePacketLen > 0) _udpServer->endPacket();
+}
+
+bool xioAPI::sendSettingFilePart(const char* data, size_t size, void* context) {
+    xioAPI* api = static_cast<xioAPI*>(context);
+    if (api->_serialPort != nullptr) api->_serialPort->write((const uint8_t*) data, size);
+    if (api->_udpServer == nullptr || !settings.wirelessMode) return true;
+
+    if (api->_settingFilePacketLen > 0 && api->_settingFilePacketLen + size > XIOAPI_UDP_MAX_PAYLOAD_SIZE) {
+        api->_udpServer->endPacket();
+        api->_settingFilePacketLen = 0;
+    }
+    if (api->_settingFilePacketLen == 0) api->beginUDPPacket();
+    api->_udpServer->write((const uint8_t*) data, size);
+    api->_settingFilePacketLen += size;
+    return true;
 }
 
 
@@ -192,60 +209,111 @@ void xioAPI::sendSettingFile() {
 
 /**
  * @brief Continuously checks if a command is available from the device interface.
- * If a command is present, it will parse it into a command key and a value for later processing.
- * The command will automatically be processed as soon as it is detected.
+ * Only the bytes that have already arrived are read, so this never blocks; a partial command is kept
+ * until the rest of it arrives in a later call. Each command is parsed into a command key and a value
+ * and handled as soon as its terminator is read.
 */
 void xioAPI::checkForCommand() {
-    char buffer[256];
-    StaticJsonDocument<256> doc;
+    serviceUDP();
+    serviceConfigurations();
 
     while (_serialPort->available() > 0) { //  Check for xio API Command Messages
-        // Read the incoming bytes
-        int blen = _serialPort->readBytesUntil(TERMINAL, buffer, BUFFER_SIZE);
-        DeserializationError error = deserializeJson(doc, buffer, blen);
-
-        if (error) {
-            _serialPort->println("Ran into error"); // DEBUG
-            _serialPort->println(error.c_str()); // DEBUG
-            return;
-        }
+        int c = _serialPort->read();
+        if (c < 0) break;
+        if (!frameCommand((char) c)) continue;
 
-        JsonObject root = doc.as<JsonObject>();
+        dispatchCommand(_cmdBuffer, _cmdLen);
+        _cmdLen = 0;
+        flushUDP(); // Do not hold command responses back for the coalescing deadline
+    }
+}
 
-        for (JsonPair kv : root) {
-            strcpy(_cmd, kv.key().c_str());
-            _value = kv.value();
-        }
+/**
+ * @brief Adds a byte to the command being received.
+ * 
+ * `START_JSON` skips everything up to the opening brace of a command, including the CR of the previous
+ * terminator. `START_CMD` stores the command up to its terminator. `END_JSON` discards the rest of a
+ * command that is longer than `XIOAPI_COMMAND_BUFFER_SIZE`, which is reported once.
+ * 
+ * @return `true` if a complete command is in `_cmdBuffer`
+*/
+bool xioAPI::frameCommand(char c) {
+    switch (_cmdState) {
+        case START_JSON:
+            if (c != START_OBJ) return false;
+            _cmdBuffer[0] = c;
+            _cmdLen = 1;
+            _cmdState = START_CMD;
+            return false;
+        case START_CMD:
+            if (c == TERMINAL) {
+                while (_cmdLen > 0 && _cmdBuffer[_cmdLen-1] == '\r') _cmdLen--;
+                _cmdBuffer[_cmdLen] = NULL_TERMINATOR;
+                _cmdState = START_JSON;
+                return true;
+            }
+            if (_cmdLen == XIOAPI_COMMAND_BUFFER_SIZE) {
+                sendError("Command message too long");
+                _cmdLen = 0;
+                _cmdState = END_JSON;
+                return false;
+            }
+            _cmdBuffer[_cmdLen++] = c;
+            return false;
+        default: // END_JSON
+            if (c == TERMINAL) _cmdState = START_JSON;
+            return false;
+    }
+}
 
-        handleCommand(_cmd);
+/**
+ * @brief Parses a complete command message into a command key and value, then handles it.
+ * Malformed commands are reported with an error message.
+ * 
+ * @param command The command message, without its terminator. The key and value are decoded in place.
+ * @param size The length of the command message
+*/
+void xioAPI::dispatchCommand(char* command, size_t size) {
+    xioAPI_Command::Command cmd;
+    if (!xioAPI_Command::parseCommand(command, size, &cmd)) {
+        sendError("Invalid command message");
+        return;
     }
+
+    _cmd = cmd.key;
+    _value = cmd.value;
+    handleCommand(cmd.hash);
+    clearValue(); // The value does not outlive the command buffer
 }
 
 /**
  * @brief Handles the command based upon the key presented. 
 */
 void xioAPI::handleCommand(const char* cmdPtr) {
-    uint32_t cmdHash = hash(cmdPtr);
+    _cmd = cmdPtr;
+    handleCommand(hash(cmdPtr));
+}
 
+/**
+ * @brief Handles the command with the given key hash, e.g. as computed by `xioAPI_Command::parseCommand()`
+*/
+void xioAPI::handleCommand(uint32_t cmdHash) {
     using xioAPI_Protocol::APIKeyHashASCII;
 
     // First check to see if it is a setting read/write command:
-    const size_t numEntries = sizeof(settingTable) / sizeof(settingTable[0]);
-    for (size_t i=0; i<numEntries; i++) { // Check all keys in the hash table
-        if (settingTable[i].hash == cmdHash) { // If the command key is present in the hash table, then it is a setting read/write
-            if (_value.isNull()) { // If the passed value was null, then it is a read command
-                sendSetting(&settingTable[i]);
-            }
-            else {
-                updateSetting(&settingTable[i], _value);
-                sendSetting(&settingTable[i]);
-            }
-            
-            // Exit function after handle
-            return;
+    settingTableEntry* entry = getSettingEntry(cmdHash);
+    if (entry != nullptr) {
+        if (_value.isNull()) { // If the passed value was null, then it is a read command
+            sendSetting(entry);
         }
+        else {
+            updateSetting(entry, _value);
+            sendSetting(entry);
+        }
+        return;
     }
 
+    // Otherwise it is a command. The compiler turns the switch into a fixed-depth comparison tree.
     switch(cmdHash) {
         case XIO_DEFAULT:
             loadConfigurationsFromJSON(true, DEFAULT_CONFIG_FILE_NAME);
@@ -255,11 +323,11 @@ void xioAPI::handleCommand(const char* cmdPtr) {
             sendAck("apply");
             break;
         case SAVE:
-            saveConfigurations();
+            requestSaveConfigurations();
             sendAck("save");
             break;
         case TIME:
-            if (_value != nullptr) { // Assume that a WRITE command has been sent
+            if (!_value.isNull()) { // Assume that a WRITE command has been sent
                 cmdWriteTime();
             }
             cmdReadTime();
@@ -321,7 +389,7 @@ void xioAPI::handleCommand(const char* cmdPtr) {
             break;
         default:
             char _buf[128];
-            sprintf(_buf, "Did not recognize key: %s as %08x", cmdPtr, cmdHash);
+            snprintf(_buf, sizeof(_buf), "Did not recognize key: %s as %08x", _cmd, (unsigned int) cmdHash);
             sendError(_buf);
     }
 }
@@ -333,48 +401,272 @@ void xioAPI::handleCommand(const char* cmdPtr) {
 
 
 void xioAPI::sendInertialMessage(InertialMessage msg) {
-    // Inertial Message Format: "I,timestamp (µs),gx,gy,gz,ax,ay,az\r\n"
-    sendDataMessage("I,%lu,%0.4f,%0.4f,%0.4f,%0.4f,%0.4f,%0.4f", msg.timestamp, msg.gx, msg.gy, msg.gz, msg.ax, msg.ay, msg.az);
+    float values[6] = {msg.gx, msg.gy, msg.gz, msg.ax, msg.ay, msg.az};
+    if (!isFilteredMessageDue(INERTIAL_MESSAGE, _inertialFilter, settings.inertialDecimationFilterOrder, values, 6)) return;
+    msg.gx = values[0]; msg.gy = values[1]; msg.gz = values[2];
+    msg.ax = values[3]; msg.ay = values[4]; msg.az = values[5];
+
+    DataMessageRecord record;
+    record.type = INERTIAL_MESSAGE;
+    record.inertial = msg;
+    dispatchDataMessage(record);
 }
 
 void xioAPI::sendMagnetometerMessage(MagnetometerMessage msg) {
-    // Magnetometer Message Format: "M,timestamp (µs),mx,my,mz\r\n"
-    sendDataMessage("M,%lu,%0.4f,%0.4f,%0.4f", msg.timestamp, msg.mx, msg.my, msg.mz);
+    float values[3] = {msg.mx, msg.my, msg.mz};
+    if (!isFilteredMessageDue(MAGNETOMETER_MESSAGE, _magnetometerFilter, settings.magnetometerDecimationFilterOrder, values, 3)) return;
+    msg.mx = values[0]; msg.my = values[1]; msg.mz = values[2];
+
+    DataMessageRecord record;
+    record.type = MAGNETOMETER_MESSAGE;
+    record.magnetometer = msg;
+    dispatchDataMessage(record);
+}
+
+void xioAPI::sendHighGAccelerometerMessage(HighGAccelerometerMessage msg) {
+    float values[3] = {msg.ax, msg.ay, msg.az};
+    if (!isFilteredMessageDue(HIGHG_ACCELEROMETER_MESSAGE, _highGFilter, settings.highGAccelerometerDecimationFilterOrder, values, 3)) return;
+    msg.ax = values[0]; msg.ay = values[1]; msg.az = values[2];
+
+    DataMessageRecord record;
+    record.type = HIGHG_ACCELEROMETER_MESSAGE;
+    record.highG = msg;
+    dispatchDataMessage(record);
 }
 
 void xioAPI::sendTemperatureMessage(TemperatureMessage msg) {
-    // Temperature Message Format: "T,timestamp (µs),temperature (°C)\r\n"
-    sendDataMessage("T,%lu,%0.4f", msg.timestamp, msg.temp);
+    if (!isMessageDue(TEMPERATURE_MESSAGE)) return;
+
+    DataMessageRecord record;
+    record.type = TEMPERATURE_MESSAGE;
+    record.temperature = msg;
+    dispatchDataMessage(record);
 }
 
 void xioAPI::sendQuaternionMessage(QuaternionMessage msg) {
-    // Quaternion Message Format: "Q,timestamp (µs),w,x,y,z\r\n"
-    sendDataMessage("Q,%lu,%0.4f,%0.4f,%0.4f,%0.4f", msg.timestamp, msg.w, msg.x, msg.y, msg.z);
+    if (!isMessageDue(QUATERNION_MESSAGE)) return;
+
+    DataMessageRecord record;
+    record.type = QUATERNION_MESSAGE;
+    record.quaternion = msg;
+    dispatchDataMessage(record);
 }
 
 void xioAPI::sendEulerMessage(EulerMessage msg) {
-    // Euler Angles Message Format: "A,timestamp (µs),roll,pitch,yaw\r\n"
-    sendDataMessage("A,%lu,%0.4f,%0.4f,%0.4f", msg.timestamp, msg.roll, msg.pitch, msg.yaw);
+    if (!isMessageDue(EULER_MESSAGE)) return;
+
+    DataMessageRecord record;
+    record.type = EULER_MESSAGE;
+    record.euler = msg;
+    dispatchDataMessage(record);
 }
 
 void xioAPI::sendBatteryMessage(BatteryMessage msg) {
-    // Battery Message Format: "B,timestamp (µs),percentCharged,voltage,status\r\n"
-    sendDataMessage("B,%lu,%0.4f,%0.4f,%u", msg.timestamp, msg.percentCharged, msg.voltage, msg.status);
+    if (!isMessageDue(BATTERY_MESSAGE)) return;
+
+    DataMessageRecord record;
+    record.type = BATTERY_MESSAGE;
+    record.battery = msg;
+    dispatchDataMessage(record);
 }
 
 void xioAPI::sendRSSIMessage(RSSIMessage msg) {
-    // RSSI Message Format: "W,timestamp (µs),percent,power (dBm)\r\n"
-    sendDataMessage("W,%lu,%0.4f,%0.4f", msg.timestamp, msg.percentage, msg.power);
+    if (!isMessageDue(RSSI_MESSAGE)) return;
+
+    DataMessageRecord record;
+    record.type = RSSI_MESSAGE;
+    record.rssi = msg;
+    dispatchDataMessage(record);
+}
+
+/**
+ * @brief Formats a data message sample as a binary frame or ASCII message and sends it.
+ * Does not apply the rate divisors, which the `send*Message()` functions have already applied.
+ * 
+ * @param record The data message sample
+*/
+void xioAPI::sendDataMessageRecord(const DataMessageRecord& record) {
+    if (_dataLoggerFormat != DATA_LOGGER_FORMAT_TEXT && settings.dataLoggerEnabled && settings.dataLoggerDataMessagesEnabled) {
+        uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+        size_t len = xioAPI_Binary::encodeRawRecord(raw, sizeof(raw), record);
+        if (len > 0 && dataASCIIBuffer.push((const char*) raw, len, CIRCULAR_BUFFER_REJECT) > 0) _dataLoggerOverruns++;
+    }
+
+    if (settings.binaryModeEnabled) {
+        uint8_t frame[XIOAPI_BINARY_MAX_FRAME_SIZE];
+        size_t len = 0;
+        switch (record.type) {
+            case INERTIAL_MESSAGE:              len = xioAPI_Binary::encodeInertialMessage(frame, sizeof(frame), record.inertial); break;
+            case MAGNETOMETER_MESSAGE:          len = xioAPI_Binary::encodeMagnetometerMessage(frame, sizeof(frame), record.magnetometer); break;
+            case QUATERNION_MESSAGE:            len = xioAPI_Binary::encodeQuaternionMessage(frame, sizeof(frame), record.quaternion); break;
+            case EULER_MESSAGE:                 len = xioAPI_Binary::encodeEulerMessage(frame, sizeof(frame), record.euler); break;
+            case HIGHG_ACCELEROMETER_MESSAGE:   len = xioAPI_Binary::encodeHighGAccelerometerMessage(frame, sizeof(frame), record.highG); break;
+            case TEMPERATURE_MESSAGE:           len = xioAPI_Binary::encodeTemperatureMessage(frame, sizeof(frame), record.temperature); break;
+            case BATTERY_MESSAGE:               len = xioAPI_Binary::encodeBatteryMessage(frame, sizeof(frame), record.battery); break;
+            case RSSI_MESSAGE:                  len = xioAPI_Binary::encodeRSSIMessage(frame, sizeof(frame), record.rssi); break;
+            default: break;
+        }
+        sendEncodedDataMessage(frame, len);
+        return;
+    }
+
+    switch (record.type) {
+        case INERTIAL_MESSAGE: { // Inertial Message Format: "I,timestamp (µs),gx,gy,gz,ax,ay,az\r\n"
+            const InertialMessage& msg = record.inertial;
+            sendDataMessage<xioAPI_Format::InertialLayout>(msg.timestamp, msg.gx, msg.gy, msg.gz, msg.ax, msg.ay, msg.az);
+            break;
+        }
+        case MAGNETOMETER_MESSAGE: { // Magnetometer Message Format: "M,timestamp (µs),mx,my,mz\r\n"
+            const MagnetometerMessage& msg = record.magnetometer;
+            sendDataMessage<xioAPI_Format::MagnetometerLayout>(msg.timestamp, msg.mx, msg.my, msg.mz);
+            break;
+        }
+        case QUATERNION_MESSAGE: { // Quaternion Message Format: "Q,timestamp (µs),w,x,y,z\r\n"
+            const QuaternionMessage& msg = record.quaternion;
+            sendDataMessage<xioAPI_Format::QuaternionLayout>(msg.timestamp, msg.w, msg.x, msg.y, msg.z);
+            break;
+        }
+        case EULER_MESSAGE: { // Euler Angles Message Format: "A,timestamp (µs),roll,pitch,yaw\r\n"
+            const EulerMessage& msg = record.euler;
+            sendDataMessage<xioAPI_Format::EulerLayout>(msg.timestamp, msg.roll, msg.pitch, msg.yaw);
+            break;
+        }
+        case HIGHG_ACCELEROMETER_MESSAGE: { // High-g Accelerometer Message Format: "H,timestamp (µs),ax,ay,az\r\n"
+            const HighGAccelerometerMessage& msg = record.highG;
+            sendDataMessage<xioAPI_Format::HighGAccelerometerLayout>(msg.timestamp, msg.ax, msg.ay, msg.az);
+            break;
+        }
+        case TEMPERATURE_MESSAGE: { // Temperature Message Format: "T,timestamp (µs),temperature (°C)\r\n"
+            const TemperatureMessage& msg = record.temperature;
+            sendDataMessage<xioAPI_Format::TemperatureLayout>(msg.timestamp, msg.temp);
+            break;
+        }
+        case BATTERY_MESSAGE: { // Battery Message Format: "B,timestamp (µs),percentCharged,voltage,status\r\n"
+            const BatteryMessage& msg = record.battery;
+            sendDataMessage<xioAPI_Format::BatteryLayout>(msg.timestamp, msg.percentCharged, msg.voltage, (uint32_t) msg.status);
+            break;
+        }
+        case RSSI_MESSAGE: { // RSSI Message Format: "W,timestamp (µs),percent,power (dBm)\r\n"
+            const RSSIMessage& msg = record.rssi;
+            sendDataMessage<xioAPI_Format::RSSILayout>(msg.timestamp, msg.percentage, msg.power);
+            break;
+        }
+        default: break;
+    }
+}
+
+/**
+ * @brief Sends a data message sample from a data message sender.
+ * With `XIOAPI_MESSAGE_QUEUE` defined the sample is only copied into the message queue and is
+ * formatted later by `processQueue()`, so the sampling tasks never format or contend for the
+ * interfaces. When the queue is full the sample is dropped and counted against its type.
+*/
+void xioAPI::dispatchDataMessage(const DataMessageRecord& record) {
+    #ifdef XIOAPI_MESSAGE_QUEUE
+    if (!_messageQueue.push(record)) _droppedMessages[record.type].fetch_add(1, std::memory_order_relaxed);
+    #else
+    sendDataMessageRecord(record);
+    #endif // XIOAPI_MESSAGE_QUEUE
 }
 
 void xioAPI::sendNotification(const char *note) {
     // Notification Message Format: "N,timestamp (µs),note\r\n"
-    send("N,%lu,%s", micros(), note);
+    char buffer[xioAPI_Format::NotificationLayout::bufferSize];
+    sendString(buffer, xioAPI_Format::NotificationLayout::format(buffer, micros(), note));
 }
 
 void xioAPI::sendError(const char *error) {
     // Error Message Format: "F,timestamp (µs),errorMessage\r\n"
-    send("F,%lu,%s", micros(), error);
+    char buffer[xioAPI_Format::ErrorLayout::bufferSize];
+    sendString(buffer, xioAPI_Format::ErrorLayout::format(buffer, micros(), error));
+}
+
+
+// =================================
+// === DATA MESSAGE RATE DIVISORS ===
+// =================================
+
+
+/**
+ * @brief Returns the rate divisor setting that applies to a data message type.
+ * Quaternion and Euler angle messages share the AHRS message rate divisor.
+*/
+int xioAPI::getRateDivisor(DataMessageType type) {
+    switch (type) {
+        case INERTIAL_MESSAGE:              return settings.inertialMessageRateDivisor;
+        case MAGNETOMETER_MESSAGE:          return settings.magnetometerMessageRateDivisor;
+        case QUATERNION_MESSAGE:
+        case EULER_MESSAGE:                 return settings.ahrsMessageRateDivisor;
+        case HIGHG_ACCELEROMETER_MESSAGE:   return settings.highGAccelerometerMessageRateDivisor;
+        case TEMPERATURE_MESSAGE:           return settings.temperatureMessageRateDivisor;
+        case BATTERY_MESSAGE:               return settings.batteryMessageRateDivisor;
+        case RSSI_MESSAGE:                  return settings.rssiMessageRateDivisor;
+        default:                            return 1;
+    }
+}
+
+/**
+ * @brief Counts a sample of a data message type and determines if it should be sent.
+ * A divisor of N sends every Nth sample and a divisor of 0 disables the message.
+ * The divisor is read from the settings on every sample, so changes apply to the next sample.
+ * 
+ * @param type The data message type being sent
+ * 
+ * @return `true` if the message should be sent, always `true` when rate divisors are disabled
+*/
+bool xioAPI::isMessageDue(DataMessageType type) {
+    if (!_rateDivisorsEnabled) return true;
+
+    int divisor = getRateDivisor(type);
+    if (divisor <= 0) return false;
+
+    if (++_messageCounters[type] >= (uint32_t) divisor) {
+        _messageCounters[type] = 0;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Decimates a filtered data message type according to its rate divisor.
+ * With a filter order of 0 this is the same as `isMessageDue()`. Otherwise every sample is
+ * passed through a CIC decimation filter and `values` is replaced with the filtered output
+ * when a message is due. The filter is reconfigured on the next sample after its order or divisor changes,
+ * and starts from a cleared state whenever filtering is turned back on.
+ * Divisors above `XIOAPI_DECIMATION_MAX_FACTOR` are not filtered: messages are dropped as with an order
+ * of 0, so the message rate always matches the rate divisor setting.
+ * 
+ * @param type The data message type being sent
+ * @param filter The decimation filter state for the message type
+ * @param order The `*DecimationFilterOrder` setting for the message type
+ * @param values The sample values, filtered in place
+ * @param channels The number of values
+ * 
+ * @return `true` if the message should be sent
+*/
+bool xioAPI::isFilteredMessageDue(DataMessageType type, DecimationFilter& filter, int order, float* values, uint8_t channels) {
+    int divisor = getRateDivisor(type);
+    if (!_rateDivisorsEnabled || order <= 0 || divisor > XIOAPI_DECIMATION_MAX_FACTOR) {
+        filter.disable(); // Re-entering the filtered path must not resume from stale integrator state
+        return isMessageDue(type);
+    }
+    if (divisor <= 0) return false;
+    if (order > XIOAPI_DECIMATION_MAX_ORDER) order = XIOAPI_DECIMATION_MAX_ORDER;
+
+    if (!filter.isConfigured(order, divisor)) filter.configure(order, divisor, channels);
+    return filter.update(values, values);
+}
+
+/**
+ * @brief Enables the `*MessageRateDivisor` settings so that the data message senders can be called at the sensor rate.
+ * Disabled by default, in which case every message is sent.
+*/
+void xioAPI::setRateDivisorsEnabled(bool enabled) {
+    _rateDivisorsEnabled = enabled;
+    memset(_messageCounters, 0, sizeof(_messageCounters));
+    _inertialFilter.reset();
+    _magnetometerFilter.reset();
+    _highGFilter.reset();
 }
 
 
@@ -387,70 +679,307 @@ void xioAPI::send(const char* message, ...) {
     char buffer[128];
     va_list args;
     va_start(args, message);
-    size_t writeLen = vsnprintf(buffer, sizeof(buffer), message, args);
+    int writeLen = vsnprintf(buffer, sizeof(buffer), message, args);
     va_end(args);
 
-    sendSerial(buffer, writeLen);
-    
-    sendUDP((uint8_t*) buffer, writeLen);
+    if (writeLen < 0) return;
+    if ((size_t) writeLen >= sizeof(buffer)) { // Never send past the end of the buffer
+        writeLen = sizeof(buffer) - 1;
+    }
+    sendString(buffer, writeLen);
 }
 
-void xioAPI::sendDataMessage(const char* message, ...) {
-    char buffer[128];
-    va_list args;
-    va_start(args, message);
-    size_t writeLen = vsnprintf(buffer, sizeof(buffer), message, args);
-    va_end(args);
+/**
+ * @brief Sends an already formatted message to the USB and UDP interfaces without copying it.
+ * Use this instead of `send("%s", ...)` for messages that may be longer than 128 bytes.
+ * 
+ * @param message The null-terminated message, without the trailing CRLF
+ * @param size The length of the message
+*/
+void xioAPI::sendString(const char* message, size_t size) {
+    sendSerial(message, size);
+    sendUDP((uint8_t*) message, size);
+}
 
-    if (settings.usbDataMessagesEnabled) sendSerial(buffer, writeLen);
-    if (settings.udpDataMessagesEnabled) sendUDP((uint8_t*) buffer, writeLen);
+/**
+ * @brief Hands an encoded data message to each enabled data message interface.
+ * The message is encoded once by the caller and shared by reference; each interface
+ * receives it with a single bulk write.
+ * 
+ * @param message The complete message, including its terminator (CRLF for ASCII, LF for binary frames)
+ * @param size The length of the message. A size of 0 (encoding failure) is ignored.
+*/
+void xioAPI::sendEncodedDataMessage(const uint8_t* message, size_t size) {
+    if (size == 0) return;
 
-    if (settings.dataLoggerDataMessagesEnabled) {
-        for (int i=0; i<writeLen; i++) {
-            dataASCIIBuffer.push(buffer[i]);
-        }
-        dataASCIIBuffer.push('\n');
+    if (settings.usbDataMessagesEnabled && _serialPort != nullptr) _serialPort->write(message, size);
+    if (settings.udpDataMessagesEnabled && _udpServer != nullptr && settings.wirelessMode) queueUDP(message, size, false);
+    if (settings.dataLoggerEnabled && settings.dataLoggerDataMessagesEnabled && _dataLoggerFormat == DATA_LOGGER_FORMAT_TEXT) {
+        if (dataASCIIBuffer.push((const char*) message, size, CIRCULAR_BUFFER_REJECT) > 0) _dataLoggerOverruns++; // Never log a partial message
     }
 }
 
+#ifdef XIOAPI_MESSAGE_QUEUE
+/**
+ * @brief Formats and transmits the queued data message samples in one batch. Call this from the
+ * single task that owns the USB, UDP and data logger interfaces.
+ * 
+ * @return The number of messages transmitted
+*/
+size_t xioAPI::processQueue() {
+    DataMessageRecord record;
+    size_t count = 0;
+    while (count < XIOAPI_MESSAGE_QUEUE_SIZE && _messageQueue.pop(record)) { // Bounded so busy producers cannot starve the caller
+        sendDataMessageRecord(record);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Clears the number of data messages dropped because the message queue was full
+*/
+void xioAPI::resetDroppedMessageCounts() {
+    for (uint8_t i=0; i<NUM_DATA_MESSAGE_TYPES; i++) {
+        _droppedMessages[i].store(0, std::memory_order_relaxed);
+    }
+}
+#endif // XIOAPI_MESSAGE_QUEUE
+
 void xioAPI::sendSerial(const char* buffer, size_t size) {
-    if (_serialPort != nullptr) {
-        if (settings.binaryModeEnabled) {
-            if (_serialPort != nullptr) { // Write data to serial terminal, if available.
-                _serialPort->write((uint8_t*) buffer, size);
-                _serialPort->write(0x0D);
-                _serialPort->write(0x0A);
-            }
-        }
-        else {
-            _serialPort->print(buffer);
-            _serialPort->print("\r\n");
-        }
+    if (_serialPort != nullptr) { // Write data to serial terminal, if available.
+        _serialPort->write((const uint8_t*) buffer, size);
+        _serialPort->write((const uint8_t*) "\r\n", 2);
     }
 }
 
 void xioAPI::sendUDP(uint8_t* buffer, size_t size, char* ipAddress, int sendPort) {
-    if (_udpServer != nullptr && settings.wirelessMode) { // Write data to UDP unicast, if available
+    if (_udpServer == nullptr || !settings.wirelessMode) return; // Write data to UDP unicast, if available
+
+    if (ipAddress != settings.udpIPAddress || sendPort != settings.udpSendPort) { // One-off destinations (e.g. broadcasts) are never coalesced
         _udpServer->beginPacket(ipAddress, sendPort);
         _udpServer->write(buffer, size);
         _udpServer->write(0x0D);
         _udpServer->write(0x0A);
         _udpServer->endPacket();
+        return;
     }
+
+    queueUDP(buffer, size, true);
+}
+
+/**
+ * @brief Enables coalescing of messages sent to the UDP destination in the settings.
+ * Messages are packed into a single datagram until it is full or the oldest message 
+ * has waited for `maxLatency`.
+ * 
+ * @param payloadSize The maximum datagram payload in bytes, limited to `XIOAPI_UDP_MAX_PAYLOAD_SIZE`. 0 disables coalescing.
+ * @param maxLatency The maximum time a message may wait in the datagram, in microseconds
+*/
+void xioAPI::setUDPCoalescing(size_t payloadSize, uint32_t maxLatency) {
+    flushUDP();
+    _udpCoalesceSize = payloadSize < XIOAPI_UDP_MAX_PAYLOAD_SIZE ? payloadSize : XIOAPI_UDP_MAX_PAYLOAD_SIZE;
+    _udpMaxLatency = maxLatency;
+}
+
+/**
+ * @brief Sends the pending coalesced datagram, if there is one
+*/
+void xioAPI::flushUDP() {
+    if (_udpPacketLen == 0 || _udpServer == nullptr) return;
+
+    beginUDPPacket();
+    _udpServer->write(_udpPacket, _udpPacketLen);
+    _udpServer->endPacket();
+    _udpPacketLen = 0;
+}
+
+/**
+ * @brief Sends the pending coalesced datagram if its oldest message has reached the latency deadline.
+ * Called from `checkForCommand()`, so it only needs to be called separately if commands are not polled.
+*/
+void xioAPI::serviceUDP() {
+    if (_udpPacketLen > 0 && micros() - _udpPacketStart >= _udpMaxLatency) {
+        flushUDP();
+    }
+}
+
+/**
+ * @brief Adds a message to the coalesced datagram, or sends it immediately if coalescing is disabled
+ * 
+ * @param buffer The message to send
+ * @param size The length of the message
+ * @param terminate Whether to append a CRLF to the message
+*/
+void xioAPI::queueUDP(const uint8_t* buffer, size_t size, bool terminate) {
+    size_t frameLen = terminate ? size + 2 : size;
+
+    if (frameLen > _udpCoalesceSize) { // Coalescing is disabled or the message is too large to batch
+        flushUDP();
+        beginUDPPacket();
+        _udpServer->write(buffer, size);
+        if (terminate) {
+            _udpServer->write(0x0D);
+            _udpServer->write(0x0A);
+        }
+        _udpServer->endPacket();
+        return;
+    }
+
+    if (_udpPacketLen + frameLen > _udpCoalesceSize) flushUDP();
+    if (_udpPacketLen == 0) _udpPacketStart = micros();
+
+    memcpy(_udpPacket + _udpPacketLen, buffer, size);
+    _udpPacketLen += size;
+    if (terminate) {
+        _udpPacket[_udpPacketLen++] = 0x0D;
+        _udpPacket[_udpPacketLen++] = 0x0A;
+    }
+
+    if (_udpPacketLen == _udpCoalesceSize) flushUDP();
+}
+
+/**
+ * @brief Begins a datagram to the UDP destination in the settings.
+ * The address string is only re-parsed when `settings.udpIPAddress` changes. A destination that is
+ * not a dotted IP address is passed to `beginPacket()` as a host name, which resolves it.
+*/
+int xioAPI::beginUDPPacket() {
+    if (strncmp(_udpIPAddressCache, settings.udpIPAddress, sizeof(_udpIPAddressCache)) != 0) {
+        _udpIPAddressParsed = _udpIPAddress.fromString(settings.udpIPAddress);
+        strncpy(_udpIPAddressCache, settings.udpIPAddress, sizeof(_udpIPAddressCache));
+    }
+    if (!_udpIPAddressParsed) return _udpServer->beginPacket(settings.udpIPAddress, settings.udpSendPort);
+    return _udpServer->beginPacket(_udpIPAddress, settings.udpSendPort);
+}
+
+/**
+ * @brief Sets the storage that the data logger writes its log files to.
+ * The data logger runs while the `dataLoggerEnabled` setting is set.
+ * 
+ * @param storage The log file storage (e.g. an `FSDataLoggerStorage` for `SD`)
+*/
+void xioAPI::beginDataLogger(DataLoggerStorage* storage) {
+    _dataLogger.begin(storage);
+    _dataLoggerRunning = false;
+    _dataLoggerClearPending = true;
+}
+
+/**
+ * @brief Selects whether the data logger writes the data messages as sent (`DATA_LOGGER_FORMAT_TEXT`)
+ * or as raw records in indexed log files (`DATA_LOGGER_FORMAT_INDEXED`, see `xioAPI_Log.h`), optionally
+ * compressed (`DATA_LOGGER_FORMAT_COMPRESSED`).
+ * The current log file is closed and any buffered data is discarded by the next `serviceDataLogger()`.
+*/
+void xioAPI::setDataLoggerFormat(DataLoggerFormat format) {
+    if (format == _dataLoggerFormat) return;
+    if (_dataLoggerRunning) {
+        _dataLogger.stop(getDataLoggerConfig(), millis());
+        _dataLoggerRunning = false;
+    }
+    _dataLoggerClearPending = true;
+    _dataLoggerFormat = format;
+}
+
+/**
+ * @brief Drains the data logger buffer into the log files and rotates them according to the
+ * `dataLogger*` settings. Call this regularly from the task that owns the log storage.
+ * Each overrun of the data logger buffer since the previous call is reported once with `sendError()`.
+*/
+void xioAPI::serviceDataLogger() {
+    DataLoggerConfig config = getDataLoggerConfig();
+    uint32_t now = millis();
+
+    if (_dataLoggerClearPending) { // Only the consumer may clear the buffer
+        _dataLoggerClearPending = false;
+        dataASCIIBuffer.clear();
+    }
+
+    if (!settings.dataLoggerEnabled) {
+        if (_dataLoggerRunning) {
+            _dataLogger.stop(config, now);
+            _dataLoggerRunning = false;
+        }
+        return;
+    }
+    _dataLoggerRunning = true;
+
+    xioDataBuffer::Span spans[2];
+    dataASCIIBuffer.spans(spans[0], spans[1]);
+    for (uint8_t i=0; i<2; i++) {
+        if (spans[i].length == 0) break;
+        size_t n = _dataLogger.write((const uint8_t*) spans[i].data, spans[i].length, config, now);
+        dataASCIIBuffer.consume(n);
+        if (n < spans[i].length) break; // The storage is behind
+    }
+    _dataLogger.service(config, now);
+
+    if (_dataLoggerOverruns != _dataLoggerOverrunsReported) {
+        _dataLoggerOverrunsReported = _dataLoggerOverruns;
+        sendError("Data logger buffer overrun");
+    }
+}
+
+/**
+ * @brief Starts replaying a recorded data logger file through the data message interfaces.
+ * Text logs are sent exactly as logged; indexed log samples are formatted with `sendDataMessageRecord()`.
+ * Disable `dataLoggerDataMessagesEnabled` to keep the replayed messages out of the data logger.
+ *
+ * @param source The open log file (e.g. an `FSReplaySource`), which is closed when the replay ends
+ * @param speed 1 for real time, N for N times real time, or `XIOAPI_REPLAY_SPEED_MAX` for as fast as possible
+*/
+bool xioAPI::beginReplay(ReplaySource* source, float speed) {
+    return _replay.begin(source, speed);
+}
+
+/**
+ * @brief Sends the replayed messages that are due, up to `XIOAPI_REPLAY_BATCH_SIZE` per call.
+ * Call this regularly until `isReplaying()` is `false`; `getReplayMessageRate()` reports the achieved rate.
+ *
+ * @return The number of messages sent
+*/
+size_t xioAPI::serviceReplay() {
+    ReplayMessage message;
+    size_t count = 0;
+    while (count < XIOAPI_REPLAY_BATCH_SIZE && _replay.next(micros(), &message)) {
+        if (message.size > 0) sendEncodedDataMessage(message.data, message.size);
+        else sendDataMessageRecord(message.record);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Returns the data logger file naming and rotation settings
+*/
+DataLoggerConfig xioAPI::getDataLoggerConfig() {
+    DataLoggerConfig config;
+    config.format = _dataLoggerFormat;
+    config.fileNamePrefix = settings.dataLoggerFileNamePrefix;
+    config.fileNameTimeEnabled = settings.dataLoggerFileNameTimeEnabled;
+    config.fileNameCounterEnabled = settings.dataLoggerFileNameCounterEnabled;
+    config.maxFileSize = settings.dataLoggerMaxFileSize > 0 ? settings.dataLoggerMaxFileSize : 0;
+    config.maxFilePeriod = settings.dataLoggerMaxFilePeriod > 0 ? settings.dataLoggerMaxFilePeriod : 0;
+    config.fileExtension = settings.binaryModeEnabled ? ".bin" : ".txt";
+    if (_dataLoggerFormat != DATA_LOGGER_FORMAT_TEXT) config.fileExtension = ".xlog";
+    config.getTime = _dataLoggerGetTime;
+    config.settings = &settings;
+    config.settingsSize = sizeof(settings);
+    return config;
 }
 
 /**
  * @brief Clears the value of the `_cmd` pointer 
 */
 void xioAPI::clearCmd() {
-    memset(_cmd, 0, sizeof(_cmd));
+    _cmd = "";
 }
 
 /**
  * @brief Clears the value of the `_value` object
 */
 void xioAPI::clearValue() {
-    _value.clear();
+    _value = xioAPI_Command::CommandValue();
 }
 
 /**
@@ -31,8 +31,56 @@
 #include "xioAPI_Settings.h"
 #include "xioAPI_Protocol.h"
 #include "xioAPI_Utility.h"
+#include "xioAPI_Binary.h"
+#include "xioAPI_Format.h"
+#include "xioAPI_Filter.h"
+#include "xioAPI_DataLogger.h"
+#include "xioAPI_Replay.h"
+#include "xioAPI_Command.h"
 
 #define XIOAPI_NETWORK_DISCOVERY_PORT 10000
+#define XIOAPI_UDP_MAX_PAYLOAD_SIZE 1472 // Bytes - 1500 byte Ethernet/WiFi MTU less the IPv4 and UDP headers
+#define XIOAPI_DATA_BUFFER_SIZE 8192
+#define XIOAPI_REPLAY_BATCH_SIZE 64 // Messages sent per call of `serviceReplay()`
+#define XIOAPI_COMMAND_BUFFER_SIZE 256 // Bytes - the longest command message, excluding its terminator
+
+/**
+ * @brief The cost of the last `readAll` response (`sendSettingTable()`)
+*/
+struct SettingTableStats {
+    uint32_t duration;  // µs
+    uint16_t settings;
+    uint16_t packets;   // Batches, each one serial write and one UDP datagram
+    uint32_t bytes;
+};
+
+
+// ==========================
+// === DATA LOGGER BUFFER ===
+// ==========================
+
+
+// #define XIOAPI_SPSC_DATA_BUFFER // Use a lock-free buffer so the data logger can be drained from another core or task
+
+#ifdef XIOAPI_SPSC_DATA_BUFFER
+#include "xioAPI_SPSCBuffer.h"
+typedef SPSCCircularBuffer<char,XIOAPI_DATA_BUFFER_SIZE> xioDataBuffer;
+#else
+typedef CircularBuffer<char,XIOAPI_DATA_BUFFER_SIZE> xioDataBuffer;
+#endif // XIOAPI_SPSC_DATA_BUFFER
+
+
+// ==========================
+// === DATA MESSAGE QUEUE ===
+// ==========================
+
+
+// #define XIOAPI_MESSAGE_QUEUE // Queue data message samples from any task and format and transmit them with `processQueue()`
+#define XIOAPI_MESSAGE_QUEUE_SIZE 64 // Records - must be a power of two
+
+#ifdef XIOAPI_MESSAGE_QUEUE
+#include "xioAPI_MessageQueue.h"
+#endif // XIOAPI_MESSAGE_QUEUE
 
 using namespace xioAPI_Types;
 using namespace xioAPI_Protocol;
@@ -45,28 +93,63 @@ public:
     bool begin(Stream* port, WiFiUDP* udp);
     void checkForCommand();
     void handleCommand(const char* cmdPtr);
+    void handleCommand(uint32_t cmdHash);
 
+    // The key of the command being handled. Valid until the next command is received.
     const char* getCommand() { return _cmd; }
     
     template <typename T>
     T getValue() { return _value.as<T>(); }
 
-    ValueType getValueType() { return _valueType; }
+    ValueType getValueType() { return _value.getType(); }
 
     // ------------------------
     // --- COMMAND MESSAGES ---
     // ------------------------
 
     void send(const char* message, ...);
-    void sendDataMessage(const char* message, ...);
+    void sendString(const char* message, size_t size);
+
+    /**
+     * @brief Formats a data message using a compile-time layout from `xioAPI_Format` and sends it.
+     * 
+     * @tparam Layout The message layout (e.g. `xioAPI_Format::InertialLayout`)
+     * @param fields The message fields, in layout order
+    */
+    template <typename Layout, typename... Fields>
+    void sendDataMessage(Fields... fields) {
+        char buffer[Layout::bufferSize + 1]; // The CRLF replaces the null terminator
+        size_t len = Layout::format(buffer, fields...);
+        buffer[len++] = 0x0D;
+        buffer[len++] = 0x0A;
+        sendEncodedDataMessage((uint8_t*) buffer, len);
+    }
+
+    void sendEncodedDataMessage(const uint8_t* message, size_t size);
     void sendSerial(const char* message, size_t size);
     void sendUDP(uint8_t* buffer, size_t size, char* ipAddress=settings.udpIPAddress, int sendPort=settings.udpSendPort);
+    void setUDPCoalescing(size_t payloadSize, uint32_t maxLatency);
+    void flushUDP();
+    void serviceUDP();
+    void beginDataLogger(DataLoggerStorage* storage);
+    void serviceDataLogger();
+    void setDataLoggerTimeCallback(bool (*getTime)(struct tm* now)) { _dataLoggerGetTime = getTime; }
+    void setDataLoggerFormat(DataLoggerFormat format);
+    uint32_t getDataLoggerOverruns() const { return _dataLoggerOverruns; }
+    const DataLoggerStats& getDataLoggerStats() const { return _dataLogger.getStats(); }
+    bool beginReplay(ReplaySource* source, float speed=1.0f);
+    size_t serviceReplay();
+    void stopReplay() { _replay.stop(); }
+    bool isReplaying() const { return _replay.isRunning(); }
+    const ReplayStats& getReplayStats() const { return _replay.getStats(); }
+    float getReplayMessageRate() const { return _replay.getMessageRate(); }
     void sendSetting(const settingTableEntry* entry);
     void sendAck(const char* cmd) { send("{\"%s\":null}", cmd); }
     void sendPing(Ping ping);
     void sendSelfTestResults(SelfTestResults results);
     void sendNetworkAnnouncement(NetworkAnnouncement na);
     void sendSettingTable();
+    const SettingTableStats& getSettingTableStats() const { return _settingTableStats; }
     void sendSettingFile();
 
     // Update the internal system time with passed _value. NOTE: `cmdWriteTimeCallbackPtr` must be user-defined before called.
@@ -114,6 +197,7 @@ public:
 
     void sendInertialMessage(InertialMessage msg);
     void sendMagnetometerMessage(MagnetometerMessage msg);
+    void sendHighGAccelerometerMessage(HighGAccelerometerMessage msg);
     void sendTemperatureMessage(TemperatureMessage msg);
     void sendQuaternionMessage(QuaternionMessage msg);
     void sendEulerMessage(EulerMessage msg);
@@ -121,6 +205,16 @@ public:
     void sendRSSIMessage(RSSIMessage msg);
     void sendNotification(const char *note);
     void sendError(const char *error);
+    void sendDataMessageRecord(const DataMessageRecord& record);
+
+    void setRateDivisorsEnabled(bool enabled);
+    bool isMessageDue(DataMessageType type);
+
+    #ifdef XIOAPI_MESSAGE_QUEUE
+    size_t processQueue();
+    uint32_t getDroppedMessageCount(DataMessageType type) const { return _droppedMessages[type].load(std::memory_order_relaxed); }
+    void resetDroppedMessageCounts();
+    #endif // XIOAPI_MESSAGE_QUEUE
 
     // --------------------------------
     // --- COMMAND CALLBACK SETTERS ---
@@ -146,12 +240,67 @@ protected:
     bool _isActive = false;
     bool _usbActive = true;
     bool _udpActive = true;
-    ValueType _valueType;
-    char _cmd[64];
-    JsonVariant _value;
+    const char* _cmd = "";
+    xioAPI_Command::CommandValue _value;
+
+    char _cmdBuffer[XIOAPI_COMMAND_BUFFER_SIZE + 1]; // Partial command message, kept between calls of `checkForCommand()`
+    size_t _cmdLen = 0;
+    TokenState _cmdState = START_JSON;
+
+    bool frameCommand(char c);
+    void dispatchCommand(char* command, size_t size);
 
     ValueType parseValueType(char c);
     void write();
+    void queueUDP(const uint8_t* buffer, size_t size, bool terminate);
+    int beginUDPPacket();
+
+    int getRateDivisor(DataMessageType type);
+    bool isFilteredMessageDue(DataMessageType type, DecimationFilter& filter, int order, float* values, uint8_t channels);
+    void dispatchDataMessage(const DataMessageRecord& record);
+
+    bool _rateDivisorsEnabled = false;
+    uint32_t _messageCounters[NUM_DATA_MESSAGE_TYPES] = {0};
+    DecimationFilter _inertialFilter;
+    DecimationFilter _magnetometerFilter;
+    DecimationFilter _highGFilter;
+
+    #ifdef XIOAPI_MESSAGE_QUEUE
+    MPSCQueue<DataMessageRecord, XIOAPI_MESSAGE_QUEUE_SIZE> _messageQueue;
+    std::atomic<uint32_t> _droppedMessages[NUM_DATA_MESSAGE_TYPES] = {};
+    #endif // XIOAPI_MESSAGE_QUEUE
+
+    uint8_t _udpPacket[XIOAPI_UDP_MAX_PAYLOAD_SIZE];
+    size_t _udpPacketLen = 0;
+    size_t _udpCoalesceSize = 0; // 0 disables coalescing
+    uint32_t _udpMaxLatency = 0;
+    uint32_t _udpPacketStart = 0;
+    IPAddress _udpIPAddress;
+    bool _udpIPAddressParsed = false; // `udpIPAddress` is a dotted IP address rather than a host name
+    char _udpIPAddressCache[sizeof(settings.udpIPAddress)] = {0};
+
+    DataLoggerConfig getDataLoggerConfig();
+
+    DataLogger _dataLogger;
+    bool _dataLoggerRunning = false;
+    bool (*_dataLoggerGetTime)(struct tm* now) = nullptr;
+    #ifdef XIOAPI_SPSC_DATA_BUFFER // Shared between the producer tasks and the data logger task
+    std::atomic<uint32_t> _dataLoggerOverruns{0}; // Data messages rejected because the data logger buffer was full
+    std::atomic<bool> _dataLoggerClearPending{false}; // The buffer is cleared by its consumer, `serviceDataLogger()`
+    #else
+    uint32_t _dataLoggerOverruns = 0; // Data messages rejected because the data logger buffer was full
+    bool _dataLoggerClearPending = false;
+    #endif // XIOAPI_SPSC_DATA_BUFFER
+    uint32_t _dataLoggerOverrunsReported = 0;
+    DataLoggerFormat _dataLoggerFormat = DATA_LOGGER_FORMAT_TEXT;
+
+    LogReplay _replay;
+
+    void sendSettingBatch(const char* batch, size_t size);
+    static bool sendSettingFilePart(const char* data, size_t size, void* context);
+
+    SettingTableStats _settingTableStats = {0, 0, 0, 0};
+    size_t _settingFilePacketLen = 0; // Bytes of the setting file in the open UDP datagram
 
 private:
     void clearCmd();
@@ -174,6 +323,6 @@ private:
 };
 
 extern xioAPI api;
-extern CircularBuffer<char,8192> dataASCIIBuffer;
+extern xioDataBuffer dataASCIIBuffer;
 
 #endif // xioAPI_h
\ No newline at end of file
@@ -0,0 +1,481 @@
+/******************************************************************
+    @file       xioAPI_Binary.cpp
+    @brief      Binary encoding and decoding of the xio API data messages
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+
+    Credit - Derived from the xIMU3 User Manual
+            (https://x-io.co.uk/downloads/x-IMU3-User-Manual-v1.1.pdf).
+******************************************************************/
+
+#include "xioAPI_Binary.h"
+
+namespace xioAPI_Binary {
+
+namespace {
+
+uint8_t* writeHeader(uint8_t* p, uint8_t id, uint32_t timestamp) {
+    *p++ = id;
+    for (size_t i=0; i<8; i++) { // Timestamps are sent as 64-bit little-endian values
+        *p++ = i < 4 ? (uint8_t) (timestamp >> (8*i)) : 0;
+    }
+    return p;
+}
+
+uint8_t* writeFloat(uint8_t* p, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (size_t i=0; i<4; i++) {
+        *p++ = (uint8_t) (bits >> (8*i));
+    }
+    return p;
+}
+
+const uint8_t* readHeader(const uint8_t* p, uint32_t* timestamp) {
+    p++; // Skip the message ID
+    uint32_t _timestamp = 0;
+    for (size_t i=0; i<4; i++) { // Upper 32 bits are discarded to match the message structs
+        _timestamp |= (uint32_t) p[i] << (8*i);
+    }
+    *timestamp = _timestamp;
+    return p + 8;
+}
+
+const uint8_t* readFloat(const uint8_t* p, float* value) {
+    uint32_t bits = 0;
+    for (size_t i=0; i<4; i++) {
+        bits |= (uint32_t) p[i] << (8*i);
+    }
+    memcpy(value, &bits, sizeof(bits));
+    return p + 4;
+}
+
+/**
+ * @brief Appends the checksum to a raw message and byte stuffs it into the output frame
+ *
+ * @param out The output buffer for the frame
+ * @param outSize The size of the output buffer
+ * @param raw The start of the raw message
+ * @param end One past the last payload byte of the raw message. Must leave room for the checksum.
+ *
+ * @return The length of the frame, or 0 if it did not fit in the output buffer
+*/
+size_t finishMessage(uint8_t* out, size_t outSize, uint8_t* raw, uint8_t* end) {
+    size_t rawLen = end - raw;
+    raw[rawLen] = crc8(raw, rawLen);
+    return encodeFrame(out, outSize, raw, rawLen + 1);
+}
+
+uint8_t* pack(uint8_t* p, const InertialMessage& msg) {
+    p = writeHeader(p, INERTIAL_ID, msg.timestamp);
+    p = writeFloat(p, msg.gx);
+    p = writeFloat(p, msg.gy);
+    p = writeFloat(p, msg.gz);
+    p = writeFloat(p, msg.ax);
+    p = writeFloat(p, msg.ay);
+    p = writeFloat(p, msg.az);
+    return p;
+}
+
+uint8_t* pack(uint8_t* p, const MagnetometerMessage& msg) {
+    p = writeHeader(p, MAGNETOMETER_ID, msg.timestamp);
+    p = writeFloat(p, msg.mx);
+    p = writeFloat(p, msg.my);
+    p = writeFloat(p, msg.mz);
+    return p;
+}
+
+uint8_t* pack(uint8_t* p, const HighGAccelerometerMessage& msg) {
+    p = writeHeader(p, HIGHG_ID, msg.timestamp);
+    p = writeFloat(p, msg.ax);
+    p = writeFloat(p, msg.ay);
+    p = writeFloat(p, msg.az);
+    return p;
+}
+
+uint8_t* pack(uint8_t* p, const TemperatureMessage& msg) {
+    p = writeHeader(p, TEMPERATURE_ID, msg.timestamp);
+    p = writeFloat(p, msg.temp);
+    return p;
+}
+
+uint8_t* pack(uint8_t* p, const QuaternionMessage& msg) {
+    p = writeHeader(p, QUATERNION_ID, msg.timestamp);
+    p = writeFloat(p, msg.w);
+    p = writeFloat(p, msg.x);
+    p = writeFloat(p, msg.y);
+    p = writeFloat(p, msg.z);
+    return p;
+}
+
+uint8_t* pack(uint8_t* p, const EulerMessage& msg) {
+    p = writeHeader(p, EULER_ID, msg.timestamp);
+    p = writeFloat(p, msg.roll);
+    p = writeFloat(p, msg.pitch);
+    p = writeFloat(p, msg.yaw);
+    return p;
+}
+
+uint8_t* pack(uint8_t* p, const BatteryMessage& msg) {
+    // The charging status is sent as a float to match the x-IMU3 binary battery message
+    p = writeHeader(p, BATTERY_ID, msg.timestamp);
+    p = writeFloat(p, msg.percentCharged);
+    p = writeFloat(p, msg.voltage);
+    p = writeFloat(p, (float) msg.status);
+    return p;
+}
+
+uint8_t* pack(uint8_t* p, const RSSIMessage& msg) {
+    p = writeHeader(p, RSSI_ID, msg.timestamp);
+    p = writeFloat(p, msg.percentage);
+    p = writeFloat(p, msg.power);
+    return p;
+}
+
+bool checkMessage(const uint8_t* raw, size_t rawLen, uint8_t id, size_t numFloats) {
+    return raw != nullptr && rawLen == XIOAPI_BINARY_HEADER_SIZE + 4*numFloats && raw[0] == id;
+}
+}
+
+
+// =========================
+// === FRAMING FUNCTIONS ===
+// =========================
+
+
+/**
+ * @brief Computes the CRC-8 (polynomial 0x07) of a block of data
+ *
+ * @param data The data to check
+ * @param len The number of bytes in `data`
+ *
+ * @return The 8-bit checksum
+*/
+uint8_t crc8(const uint8_t* data, size_t len) {
+    static const uint8_t table[16] = { // One nibble at a time
+        0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D
+    };
+    uint8_t crc = 0x00;
+    while (len--) {
+        crc ^= *data++;
+        crc = (uint8_t) (crc << 4) ^ table[crc >> 4];
+        crc = (uint8_t) (crc << 4) ^ table[crc >> 4];
+    }
+    return crc;
+}
+
+/**
+ * @brief Byte stuffs a raw message and terminates it with a LF
+ *
+ * @param out The output buffer for the frame
+ * @param outSize The size of the output buffer. `XIOAPI_BINARY_MAX_FRAME_SIZE` always fits a data message.
+ * @param raw The raw message, including its checksum
+ * @param rawLen The number of bytes in `raw`
+ *
+ * @return The length of the frame, or 0 if it did not fit in the output buffer
+*/
+size_t encodeFrame(uint8_t* out, size_t outSize, const uint8_t* raw, size_t rawLen) {
+    size_t n = 0;
+
+    for (size_t i=0; i<rawLen; i++) {
+        uint8_t b = raw[i];
+        uint8_t escaped;
+
+        switch (b) {
+            case XIOAPI_BINARY_FRAME_END: escaped = XIOAPI_BINARY_FRAME_ESC_END; break;
+            case XIOAPI_BINARY_FRAME_ESC: escaped = XIOAPI_BINARY_FRAME_ESC_ESC; break;
+            case 0x0D:                    escaped = XIOAPI_BINARY_FRAME_ESC_CR; break;
+            default:
+                if (n + 1 > outSize) return 0;
+                out[n++] = b;
+                continue;
+        }
+
+        if (n + 2 > outSize) return 0;
+        out[n++] = XIOAPI_BINARY_FRAME_ESC;
+        out[n++] = escaped;
+    }
+
+    if (n + 1 > outSize) return 0;
+    out[n++] = XIOAPI_BINARY_FRAME_END;
+    return n;
+}
+
+/**
+ * @brief Removes the byte stuffing from a frame and verifies its checksum
+ *
+ * @param frame The received frame. The terminating LF is optional.
+ * @param frameLen The number of bytes in `frame`
+ * @param raw The output buffer for the raw message
+ * @param rawSize The size of the output buffer
+ *
+ * @return The length of the raw message without its checksum, or 0 if the frame is malformed or corrupt
+*/
+size_t decodeFrame(const uint8_t* frame, size_t frameLen, uint8_t* raw, size_t rawSize) {
+    size_t n = 0;
+
+    for (size_t i=0; i<frameLen; i++) {
+        uint8_t b = frame[i];
+
+        if (b == XIOAPI_BINARY_FRAME_END) break;
+        if (b == XIOAPI_BINARY_FRAME_ESC) {
+            if (++i >= frameLen) return 0;
+            switch (frame[i]) {
+                case XIOAPI_BINARY_FRAME_ESC_END: b = XIOAPI_BINARY_FRAME_END; break;
+                case XIOAPI_BINARY_FRAME_ESC_ESC: b = XIOAPI_BINARY_FRAME_ESC; break;
+                case XIOAPI_BINARY_FRAME_ESC_CR:  b = 0x0D; break;
+                default: return 0;
+            }
+        }
+
+        if (n >= rawSize) return 0;
+        raw[n++] = b;
+    }
+
+    if (n < 2 || crc8(raw, n - 1) != raw[n - 1]) return 0;
+    return n - 1;
+}
+
+
+// =========================
+// === MESSAGE ENCODERS ====
+// =========================
+
+
+size_t encodeInertialMessage(uint8_t* out, size_t outSize, const InertialMessage& msg) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    return finishMessage(out, outSize, raw, pack(raw, msg));
+}
+
+size_t encodeMagnetometerMessage(uint8_t* out, size_t outSize, const MagnetometerMessage& msg) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    return finishMessage(out, outSize, raw, pack(raw, msg));
+}
+
+size_t encodeHighGAccelerometerMessage(uint8_t* out, size_t outSize, const HighGAccelerometerMessage& msg) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    return finishMessage(out, outSize, raw, pack(raw, msg));
+}
+
+size_t encodeTemperatureMessage(uint8_t* out, size_t outSize, const TemperatureMessage& msg) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    return finishMessage(out, outSize, raw, pack(raw, msg));
+}
+
+size_t encodeQuaternionMessage(uint8_t* out, size_t outSize, const QuaternionMessage& msg) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    return finishMessage(out, outSize, raw, pack(raw, msg));
+}
+
+size_t encodeEulerMessage(uint8_t* out, size_t outSize, const EulerMessage& msg) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    return finishMessage(out, outSize, raw, pack(raw, msg));
+}
+
+size_t encodeBatteryMessage(uint8_t* out, size_t outSize, const BatteryMessage& msg) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    return finishMessage(out, outSize, raw, pack(raw, msg));
+}
+
+size_t encodeRSSIMessage(uint8_t* out, size_t outSize, const RSSIMessage& msg) {
+    uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+    return finishMessage(out, outSize, raw, pack(raw, msg));
+}
+
+
+// =========================
+// === MESSAGE DECODERS ====
+// =========================
+
+
+/**
+ * @brief Returns the binary message ID of a raw message produced by `decodeFrame()`
+ *
+ * @return The message ID, or 0 if the message is empty
+*/
+uint8_t getMessageID(const uint8_t* raw, size_t rawLen) {
+    return rawLen > 0 ? raw[0] : 0;
+}
+
+bool decodeInertialMessage(const uint8_t* raw, size_t rawLen, InertialMessage* msg) {
+    if (!checkMessage(raw, rawLen, INERTIAL_ID, 6)) return false;
+    const uint8_t* p = readHeader(raw, &msg->timestamp);
+    p = readFloat(p, &msg->gx);
+    p = readFloat(p, &msg->gy);
+    p = readFloat(p, &msg->gz);
+    p = readFloat(p, &msg->ax);
+    p = readFloat(p, &msg->ay);
+    readFloat(p, &msg->az);
+    return true;
+}
+
+bool decodeMagnetometerMessage(const uint8_t* raw, size_t rawLen, MagnetometerMessage* msg) {
+    if (!checkMessage(raw, rawLen, MAGNETOMETER_ID, 3)) return false;
+    const uint8_t* p = readHeader(raw, &msg->timestamp);
+    p = readFloat(p, &msg->mx);
+    p = readFloat(p, &msg->my);
+    readFloat(p, &msg->mz);
+    return true;
+}
+
+bool decodeHighGAccelerometerMessage(const uint8_t* raw, size_t rawLen, HighGAccelerometerMessage* msg) {
+    if (!checkMessage(raw, rawLen, HIGHG_ID, 3)) return false;
+    const uint8_t* p = readHeader(raw, &msg->timestamp);
+    p = readFloat(p, &msg->ax);
+    p = readFloat(p, &msg->ay);
+    readFloat(p, &msg->az);
+    return true;
+}
+
+bool decodeTemperatureMessage(const uint8_t* raw, size_t rawLen, TemperatureMessage* msg) {
+    if (!checkMessage(raw, rawLen, TEMPERATURE_ID, 1)) return false;
+    const uint8_t* p = readHeader(raw, &msg->timestamp);
+    readFloat(p, &msg->temp);
+    return true;
+}
+
+bool decodeQuaternionMessage(const uint8_t* raw, size_t rawLen, QuaternionMessage* msg) {
+    if (!checkMessage(raw, rawLen, QUATERNION_ID, 4)) return false;
+    const uint8_t* p = readHeader(raw, &msg->timestamp);
+    p = readFloat(p, &msg->w);
+    p = readFloat(p, &msg->x);
+    p = readFloat(p, &msg->y);
+    readFloat(p, &msg->z);
+    return true;
+}
+
+bool decodeEulerMessage(const uint8_t* raw, size_t rawLen, EulerMessage* msg) {
+    if (!checkMessage(raw, rawLen, EULER_ID, 3)) return false;
+    const uint8_t* p = readHeader(raw, &msg->timestamp);
+    p = readFloat(p, &msg->roll);
+    p = readFloat(p, &msg->pitch);
+    readFloat(p, &msg->yaw);
+    return true;
+}
+
+bool decodeBatteryMessage(const uint8_t* raw, size_t rawLen, BatteryMessage* msg) {
+    if (!checkMessage(raw, rawLen, BATTERY_ID, 3)) return false;
+    float status;
+    const uint8_t* p = readHeader(raw, &msg->timestamp);
+    p = readFloat(p, &msg->percentCharged);
+    p = readFloat(p, &msg->voltage);
+    readFloat(p, &status);
+    msg->status = (xioAPI_Types::ChargingStatus) (int) status;
+    return true;
+}
+
+bool decodeRSSIMessage(const uint8_t* raw, size_t rawLen, RSSIMessage* msg) {
+    if (!checkMessage(raw, rawLen, RSSI_ID, 2)) return false;
+    const uint8_t* p = readHeader(raw, &msg->timestamp);
+    p = readFloat(p, &msg->percentage);
+    readFloat(p, &msg->power);
+    return true;
+}
+
+
+// ============================
+// === RAW RECORD FUNCTIONS ===
+// ============================
+
+
+/**
+ * @brief Returns the length of a raw message and its checksum, without byte stuffing
+ *
+ * @param id The binary message ID
+ *
+ * @return The length in bytes, or 0 if the ID is unknown
+*/
+size_t getRawRecordSize(uint8_t id) {
+    size_t numFloats;
+    switch (id) {
+        case INERTIAL_ID:       numFloats = 6; break;
+        case QUATERNION_ID:     numFloats = 4; break;
+        case MAGNETOMETER_ID:
+        case HIGHG_ID:
+        case EULER_ID:
+        case BATTERY_ID:        numFloats = 3; break;
+        case RSSI_ID:           numFloats = 2; break;
+        case TEMPERATURE_ID:    numFloats = 1; break;
+        default:                return 0;
+    }
+    return XIOAPI_BINARY_HEADER_SIZE + 4*numFloats + 1;
+}
+
+/**
+ * @brief Returns the `DataMessageType` of a binary message ID, or -1 if it is unknown
+*/
+int getMessageType(uint8_t id) {
+    switch (id) {
+        case INERTIAL_ID:       return xioAPI_Types::INERTIAL_MESSAGE;
+        case MAGNETOMETER_ID:   return xioAPI_Types::MAGNETOMETER_MESSAGE;
+        case QUATERNION_ID:     return xioAPI_Types::QUATERNION_MESSAGE;
+        case EULER_ID:          return xioAPI_Types::EULER_MESSAGE;
+        case HIGHG_ID:          return xioAPI_Types::HIGHG_ACCELEROMETER_MESSAGE;
+        case TEMPERATURE_ID:    return xioAPI_Types::TEMPERATURE_MESSAGE;
+        case BATTERY_ID:        return xioAPI_Types::BATTERY_MESSAGE;
+        case RSSI_ID:           return xioAPI_Types::RSSI_MESSAGE;
+        default:                return -1;
+    }
+}
+
+/**
+ * @brief Encodes a data message sample as a raw message with its checksum, without byte stuffing.
+ * Raw records are self-delimiting by their ID (see `getRawRecordSize()`), so they can be stored back to back.
+ *
+ * @param raw The output buffer
+ * @param rawSize The size of the output buffer, at least `XIOAPI_BINARY_MAX_RAW_SIZE`
+ * @param record The data message sample
+ *
+ * @return The length of the record, or 0 if the buffer is too small or the type is unknown
+*/
+size_t encodeRawRecord(uint8_t* raw, size_t rawSize, const DataMessageRecord& record) {
+    if (rawSize < XIOAPI_BINARY_MAX_RAW_SIZE) return 0;
+
+    uint8_t* p;
+    switch (record.type) {
+        case xioAPI_Types::INERTIAL_MESSAGE:            p = pack(raw, record.inertial); break;
+        case xioAPI_Types::MAGNETOMETER_MESSAGE:        p = pack(raw, record.magnetometer); break;
+        case xioAPI_Types::QUATERNION_MESSAGE:          p = pack(raw, record.quaternion); break;
+        case xioAPI_Types::EULER_MESSAGE:               p = pack(raw, record.euler); break;
+        case xioAPI_Types::HIGHG_ACCELEROMETER_MESSAGE: p = pack(raw, record.highG); break;
+        case xioAPI_Types::TEMPERATURE_MESSAGE:         p = pack(raw, record.temperature); break;
+        case xioAPI_Types::BATTERY_MESSAGE:             p = pack(raw, record.battery); break;
+        case xioAPI_Types::RSSI_MESSAGE:                p = pack(raw, record.rssi); break;
+        default:                                        return 0;
+    }
+    size_t rawLen = p - raw;
+    raw[rawLen] = crc8(raw, rawLen);
+    return rawLen + 1;
+}
+
+/**
+ * @brief Decodes a raw record produced by `encodeRawRecord()`
+ *
+ * @return `false` if the checksum or the length does not match
+*/
+bool decodeRawRecord(const uint8_t* raw, size_t rawLen, DataMessageRecord* record) {
+    if (raw == nullptr || rawLen < 1 || rawLen != getRawRecordSize(raw[0])) return false;
+    if (crc8(raw, rawLen - 1) != raw[rawLen - 1]) return false;
+
+    rawLen--; // The decoders take the message without its checksum
+    switch (raw[0]) {
+        case INERTIAL_ID:       record->type = xioAPI_Types::INERTIAL_MESSAGE;              return decodeInertialMessage(raw, rawLen, &record->inertial);
+        case MAGNETOMETER_ID:   record->type = xioAPI_Types::MAGNETOMETER_MESSAGE;          return decodeMagnetometerMessage(raw, rawLen, &record->magnetometer);
+        case QUATERNION_ID:     record->type = xioAPI_Types::QUATERNION_MESSAGE;            return decodeQuaternionMessage(raw, rawLen, &record->quaternion);
+        case EULER_ID:          record->type = xioAPI_Types::EULER_MESSAGE;                 return decodeEulerMessage(raw, rawLen, &record->euler);
+        case HIGHG_ID:          record->type = xioAPI_Types::HIGHG_ACCELEROMETER_MESSAGE;   return decodeHighGAccelerometerMessage(raw, rawLen, &record->highG);
+        case TEMPERATURE_ID:    record->type = xioAPI_Types::TEMPERATURE_MESSAGE;           return decodeTemperatureMessage(raw, rawLen, &record->temperature);
+        case BATTERY_ID:        record->type = xioAPI_Types::BATTERY_MESSAGE;               return decodeBatteryMessage(raw, rawLen, &record->battery);
+        case RSSI_ID:           record->type = xioAPI_Types::RSSI_MESSAGE;                  return decodeRSSIMessage(raw, rawLen, &record->rssi);
+        default:                return false;
+    }
+}
+}
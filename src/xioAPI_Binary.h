@@ -0,0 +1,125 @@
+/******************************************************************
+    @file       xioAPI_Binary.h
+    @brief      Binary encoding and decoding of the xio API data messages
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+    Credit - Derived from the xIMU3 User Manual
+            (https://x-io.co.uk/downloads/x-IMU3-User-Manual-v1.1.pdf).
+
+******************************************************************/
+
+#ifndef XIOAPI_BINARY_H
+#define XIOAPI_BINARY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "xioAPI_Types.h"
+#include "xioAPI_Protocol.h"
+
+/**
+ * Binary data message layout (before byte stuffing):
+ *
+ * | MSG ID | TIME STAMP (µs) |      PAYLOAD      | CHECKSUM |
+ * |   1B   |   8B uint64 LE  | n x 4B float32 LE |  1B CRC8 |
+ *
+ * The message ID is the ASCII ID with the most significant bit set (e.g. 'I' | 0x80).
+ * The raw message is then byte stuffed so that the frame terminator (LF) and
+ * carriage return never appear inside a frame:
+ *
+ *  0x0A -> 0xDB 0xDC
+ *  0xDB -> 0xDB 0xDD
+ *  0x0D -> 0xDB 0xDE
+ *
+ * and terminated with a single LF (0x0A).
+*/
+
+#define XIOAPI_BINARY_FRAME_END             0x0A
+#define XIOAPI_BINARY_FRAME_ESC             0xDB
+#define XIOAPI_BINARY_FRAME_ESC_END         0xDC
+#define XIOAPI_BINARY_FRAME_ESC_ESC         0xDD
+#define XIOAPI_BINARY_FRAME_ESC_CR          0xDE
+
+#define XIOAPI_BINARY_HEADER_SIZE           9   // Bytes - message ID + 64-bit timestamp
+#define XIOAPI_BINARY_MAX_PAYLOAD_SIZE      24  // Bytes - six float32 values (inertial message)
+#define XIOAPI_BINARY_MAX_RAW_SIZE          (XIOAPI_BINARY_HEADER_SIZE + XIOAPI_BINARY_MAX_PAYLOAD_SIZE + 1)
+#define XIOAPI_BINARY_MAX_FRAME_SIZE        (2 * XIOAPI_BINARY_MAX_RAW_SIZE + 1) // Worst case every byte is stuffed, plus terminator
+
+namespace xioAPI_Binary {
+
+using namespace xioAPI_Protocol;
+
+typedef enum BinaryMessageID : uint8_t {
+    INERTIAL_ID         = 'I' | 0x80,
+    MAGNETOMETER_ID     = 'M' | 0x80,
+    HIGHG_ID            = 'H' | 0x80,
+    TEMPERATURE_ID      = 'T' | 0x80,
+    QUATERNION_ID       = 'Q' | 0x80,
+    EULER_ID            = 'A' | 0x80,
+    BATTERY_ID          = 'B' | 0x80,
+    RSSI_ID             = 'W' | 0x80
+} BinaryMessageID;
+
+
+// =========================
+// === FRAMING FUNCTIONS ===
+// =========================
+
+
+uint8_t crc8(const uint8_t* data, size_t len);
+size_t encodeFrame(uint8_t* out, size_t outSize, const uint8_t* raw, size_t rawLen);
+size_t decodeFrame(const uint8_t* frame, size_t frameLen, uint8_t* raw, size_t rawSize);
+
+
+// =========================
+// === MESSAGE ENCODERS ====
+// =========================
+
+
+size_t encodeInertialMessage(uint8_t* out, size_t outSize, const InertialMessage& msg);
+size_t encodeMagnetometerMessage(uint8_t* out, size_t outSize, const MagnetometerMessage& msg);
+size_t encodeHighGAccelerometerMessage(uint8_t* out, size_t outSize, const HighGAccelerometerMessage& msg);
+size_t encodeTemperatureMessage(uint8_t* out, size_t outSize, const TemperatureMessage& msg);
+size_t encodeQuaternionMessage(uint8_t* out, size_t outSize, const QuaternionMessage& msg);
+size_t encodeEulerMessage(uint8_t* out, size_t outSize, const EulerMessage& msg);
+size_t encodeBatteryMessage(uint8_t* out, size_t outSize, const BatteryMessage& msg);
+size_t encodeRSSIMessage(uint8_t* out, size_t outSize, const RSSIMessage& msg);
+
+
+// =========================
+// === MESSAGE DECODERS ====
+// =========================
+
+
+uint8_t getMessageID(const uint8_t* raw, size_t rawLen);
+bool decodeInertialMessage(const uint8_t* raw, size_t rawLen, InertialMessage* msg);
+bool decodeMagnetometerMessage(const uint8_t* raw, size_t rawLen, MagnetometerMessage* msg);
+bool decodeHighGAccelerometerMessage(const uint8_t* raw, size_t rawLen, HighGAccelerometerMessage* msg);
+bool decodeTemperatureMessage(const uint8_t* raw, size_t rawLen, TemperatureMessage* msg);
+bool decodeQuaternionMessage(const uint8_t* raw, size_t rawLen, QuaternionMessage* msg);
+bool decodeEulerMessage(const uint8_t* raw, size_t rawLen, EulerMessage* msg);
+bool decodeBatteryMessage(const uint8_t* raw, size_t rawLen, BatteryMessage* msg);
+bool decodeRSSIMessage(const uint8_t* raw, size_t rawLen, RSSIMessage* msg);
+
+
+// ============================
+// === RAW RECORD FUNCTIONS ===
+// ============================
+
+
+size_t getRawRecordSize(uint8_t id);
+int getMessageType(uint8_t id);
+size_t encodeRawRecord(uint8_t* raw, size_t rawSize, const DataMessageRecord& record);
+bool decodeRawRecord(const uint8_t* raw, size_t rawLen, DataMessageRecord* record);
+}
+
+#endif // XIOAPI_BINARY_H
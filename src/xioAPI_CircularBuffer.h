@@ -41,6 +41,15 @@ namespace Helper {
 	};
 }
 
+/**
+ * @brief Selects what a bulk push does when the elements do not all fit in the buffer.
+ */
+typedef enum CircularBufferOverflow {
+	CIRCULAR_BUFFER_OVERWRITE = 0,	// Overwrite the oldest elements, as `push(T)` does
+	CIRCULAR_BUFFER_TRUNCATE,		// Add only the elements that fit
+	CIRCULAR_BUFFER_REJECT			// Add nothing unless every element fits
+} CircularBufferOverflow;
+
 /**
  * @brief Implements a circular buffer that supports LIFO and FIFO operations.
  *
@@ -64,6 +73,14 @@ public:
 	 */
 	using index_t = IT;
 
+	/**
+	 * @brief A contiguous, read-only region of the buffer.
+	 */
+	struct Span {
+		const T* data;
+		IT length;
+	};
+
 	/**
 	 * @brief Create an empty circular buffer.
 	 */
@@ -95,6 +112,41 @@ public:
 	 */
 	bool push(T value);
 
+	/**
+	 * @brief Adds `n` elements to the end of buffer, copying them in at most two contiguous blocks.
+	 *
+	 * If `n` is greater than the capacity, only the last `capacity` elements are kept.
+	 *
+	 * @return `false` iff the addition caused overwriting to an existing element.
+	 */
+	bool push(const T* values, size_t n);
+
+	/**
+	 * @brief Adds `n` elements to the end of buffer, handling overflow according to `policy`.
+	 *
+	 * @return The number of elements lost: existing elements overwritten, or new elements not added.
+	 */
+	size_t push(const T* values, size_t n, CircularBufferOverflow policy);
+
+	/**
+	 * @brief Exposes the stored elements, oldest first, as up to two contiguous spans.
+	 *
+	 * The spans can be written out directly (e.g. to a file) and then released with `consume()`.
+	 * `second` is empty unless the stored elements wrap around the end of the buffer.
+	 *
+	 * @warning The spans are invalidated by any push that overwrites existing elements.
+	 *
+	 * @return The total number of elements in both spans.
+	 */
+	IT spans(Span& first, Span& second) const;
+
+	/**
+	 * @brief Removes `n` elements from the beginning of the buffer without reading them.
+	 *
+	 * Removes every element if `n` is greater than the size of the buffer.
+	 */
+	void consume(IT n);
+
 	/**
 	 * @brief Removes an element from the beginning of the buffer.
 	 *
@@ -59,6 +59,85 @@ bool CircularBuffer<T,S,IT>::push(T value) {
 	}
 }
 
+template<typename T, size_t S, typename IT>
+bool CircularBuffer<T,S,IT>::push(const T* values, size_t n) {
+	return push(values, n, CIRCULAR_BUFFER_OVERWRITE) == 0;
+}
+
+template<typename T, size_t S, typename IT>
+size_t CircularBuffer<T,S,IT>::push(const T* values, size_t n, CircularBufferOverflow policy) {
+	size_t lost = 0;
+	size_t free = capacity - count;
+	if (n > free) {
+		if (policy == CIRCULAR_BUFFER_REJECT) {
+			return n;
+		}
+		if (policy == CIRCULAR_BUFFER_TRUNCATE) {
+			lost = n - free;
+			n = free;
+		}
+	}
+	if (n == 0) return lost;
+	if (n > capacity) {
+		lost += n - capacity;
+		values += n - capacity;
+		n = capacity;
+	}
+
+	T* dst = tail + 1;
+	if (dst == buffer + capacity) {
+		dst = buffer;
+	}
+	size_t first = buffer + capacity - dst;
+	if (first > n) {
+		first = n;
+	}
+	for (size_t i = 0; i < first; i++) {
+		dst[i] = values[i];
+	}
+	for (size_t i = first; i < n; i++) {
+		buffer[i - first] = values[i];
+	}
+
+	tail = buffer + (dst - buffer + n - 1) % capacity;
+	if (count == 0) {
+		head = dst;
+	}
+	if ((size_t) count + n > capacity) {
+		lost += count + n - capacity;
+		head = tail + 1;
+		if (head == buffer + capacity) {
+			head = buffer;
+		}
+		count = capacity;
+		return lost;
+	}
+	count += n;
+	return lost;
+}
+
+template<typename T, size_t S, typename IT>
+IT CircularBuffer<T,S,IT>::spans(Span& first, Span& second) const {
+	IT n = count;
+	IT contiguous = static_cast<IT>(buffer + capacity - head);
+	first.data = head;
+	first.length = n < contiguous ? n : contiguous;
+	second.data = buffer;
+	second.length = n - first.length;
+	return n;
+}
+
+template<typename T, size_t S, typename IT>
+void CircularBuffer<T,S,IT>::consume(IT n) {
+	if (n >= count) {
+		head = tail = buffer;
+		count = 0;
+		return;
+	}
+	head = buffer + (head - buffer + n) % capacity;
+	count -= n;
+}
+
 template<typename T, size_t S, typename IT>
 T CircularBuffer<T,S,IT>::shift() {
 	if (count == 0) return *head;
@@ -0,0 +1,316 @@
+/******************************************************************
+    @file       xioAPI_ColumnExport.cpp
+    @brief      Columnar export of indexed data logger files for host-side analysis
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#ifndef ARDUINO
+
+#include "xioAPI_ColumnExport.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <thread>
+#include <vector>
+
+using namespace xioAPI_Types;
+
+namespace {
+
+/**
+ * @brief The fields of a message struct, in declaration order, and where they are in the raw record payload
+*/
+struct MessageSchema {
+    const char* fileName;
+    char id;
+    uint8_t fieldCount;
+    const char* names[6];
+    uint8_t sources[6];
+};
+
+const MessageSchema schemas[NUM_DATA_MESSAGE_TYPES] = {
+    {"inertial",        'I', 6, {"ax", "ay", "az", "gx", "gy", "gz"},       {3, 4, 5, 0, 1, 2}}, // The payload is gx..gz, ax..az
+    {"magnetometer",    'M', 3, {"mx", "my", "mz"},                         {0, 1, 2}},
+    {"quaternion",      'Q', 4, {"w", "x", "y", "z"},                       {0, 1, 2, 3}},
+    {"euler",           'A', 3, {"roll", "pitch", "yaw"},                   {0, 1, 2}},
+    {"highg",           'H', 3, {"ax", "ay", "az"},                         {0, 1, 2}},
+    {"temperature",     'T', 1, {"temp"},                                   {0}},
+    {"battery",         'B', 3, {"percentCharged", "voltage", "status"},    {0, 1, 2}},
+    {"rssi",            'W', 2, {"percentage", "power"},                    {0, 1}}
+};
+
+size_t getElementSize(size_t column) {
+    return column == 0 ? sizeof(uint64_t) : sizeof(float);
+}
+
+/**
+ * @brief An open column file and where each of its columns starts
+*/
+struct ColumnFile {
+    int fd = -1;
+    uint64_t offsets[XIOAPI_COLUMN_MAX_COLUMNS];
+};
+
+uint8_t* put16(uint8_t* p, uint16_t value) {
+    *p++ = (uint8_t) value;
+    *p++ = (uint8_t) (value >> 8);
+    return p;
+}
+
+uint8_t* put32(uint8_t* p, uint32_t value) {
+    p = put16(p, (uint16_t) value);
+    return put16(p, (uint16_t) (value >> 16));
+}
+
+uint8_t* put64(uint8_t* p, uint64_t value) {
+    p = put32(p, (uint32_t) value);
+    return put32(p, (uint32_t) (value >> 32));
+}
+
+bool writeAt(int fd, const uint8_t* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t n = pwrite(fd, data, size, offset);
+        if (n <= 0) return false;
+        data += n;
+        size -= n;
+        offset += n;
+    }
+    return true;
+}
+
+/**
+ * @brief Creates a column file with room for `rows` rows and writes its header
+*/
+bool createFile(ColumnFile* file, const char* path, DataMessageType type, uint64_t rows) {
+    size_t columns = getColumnCount(type);
+    uint8_t header[XIOAPI_COLUMN_HEADER_SIZE + XIOAPI_COLUMN_MAX_COLUMNS * XIOAPI_COLUMN_DESCRIPTOR_SIZE] = {0};
+    uint8_t* p = put32(header, XIOAPI_COLUMN_MAGIC);
+    p = put16(p, XIOAPI_COLUMN_VERSION);
+    p = put16(p, type);
+    *p++ = schemas[type].id;
+    *p++ = (uint8_t) columns;
+    p = put16(p, 0);
+    put64(p, rows);
+
+    uint64_t offset = XIOAPI_COLUMN_HEADER_SIZE + columns * XIOAPI_COLUMN_DESCRIPTOR_SIZE;
+    for (size_t c=0; c<columns; c++) {
+        offset = (offset + 7) & ~(uint64_t) 7;
+        file->offsets[c] = offset;
+        uint8_t* d = header + XIOAPI_COLUMN_HEADER_SIZE + c * XIOAPI_COLUMN_DESCRIPTOR_SIZE;
+        strncpy((char*) d, getColumnName(type, c), XIOAPI_COLUMN_NAME_SIZE);
+        d[16] = c == 0 ? COLUMN_UINT64 : COLUMN_FLOAT32;
+        d[17] = (uint8_t) getElementSize(c);
+        put64(d + 24, offset);
+        offset += rows * getElementSize(c);
+    }
+
+    file->fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file->fd < 0) return false;
+    return writeAt(file->fd, header, XIOAPI_COLUMN_HEADER_SIZE + columns * XIOAPI_COLUMN_DESCRIPTOR_SIZE, 0)
+           && ftruncate(file->fd, offset) == 0;
+}
+
+/**
+ * @brief Counts the rows of each message type in a range of blocks
+*/
+void countRows(const LogReader& reader, const LogRange& range, uint64_t* rows) {
+    xioAPI_Log::BlockReader block;
+    for (size_t i=range.firstBlock; i<range.endBlock; i++) {
+        if (!block.begin(reader.getBlock(i), XIOAPI_LOG_BLOCK_SIZE)) continue;
+        size_t rawLen;
+        const uint8_t* raw;
+        while ((raw = block.next(&rawLen)) != nullptr) {
+            int type = xioAPI_Binary::getMessageType(raw[0]);
+            if (type >= 0) rows[type]++;
+        }
+    }
+}
+
+/**
+ * @brief Rows of one message type waiting to be written, stored column by column
+*/
+struct RowBuffer {
+    std::vector<uint8_t> data;
+    uint8_t* columns[XIOAPI_COLUMN_MAX_COLUMNS];
+    size_t rows = 0;
+    uint64_t fileRow = 0;   // Where the buffered rows go in the file
+};
+
+bool flush(RowBuffer& buffer, const ColumnFile& file, DataMessageType type) {
+    bool ok = true;
+    for (size_t c=0; c<getColumnCount(type); c++) {
+        size_t size = getElementSize(c);
+        ok = ok && writeAt(file.fd, buffer.columns[c], buffer.rows * size, file.offsets[c] + buffer.fileRow * size);
+    }
+    buffer.fileRow += buffer.rows;
+    buffer.rows = 0;
+    return ok;
+}
+
+/**
+ * @brief Converts a range of blocks, writing its rows from `firstRows` onwards in each file
+*/
+bool convertRows(const LogReader& reader, const LogRange& range, const ColumnFile* files, const uint64_t* firstRows, size_t* corruptBlocks) {
+    RowBuffer buffers[NUM_DATA_MESSAGE_TYPES];
+    for (size_t t=0; t<NUM_DATA_MESSAGE_TYPES; t++) {
+        size_t offset = 0;
+        buffers[t].fileRow = firstRows[t];
+        buffers[t].data.resize(XIOAPI_COLUMN_BUFFER_ROWS * (sizeof(uint64_t) + schemas[t].fieldCount * sizeof(float)));
+        for (size_t c=0; c<getColumnCount((DataMessageType) t); c++) {
+            buffers[t].columns[c] = buffers[t].data.data() + offset;
+            offset += XIOAPI_COLUMN_BUFFER_ROWS * getElementSize(c);
+        }
+    }
+
+    bool ok = true;
+    xioAPI_Log::BlockReader block;
+    for (size_t i=range.firstBlock; i<range.endBlock && ok; i++) {
+        if (!block.begin(reader.getBlock(i), XIOAPI_LOG_BLOCK_SIZE)) {
+            (*corruptBlocks)++;
+            continue;
+        }
+        size_t rawLen;
+        const uint8_t* raw;
+        while ((raw = block.next(&rawLen)) != nullptr) {
+            int type = xioAPI_Binary::getMessageType(raw[0]);
+            if (type < 0) continue;
+
+            // The record is already little-endian, so the fields are copied as they are
+            RowBuffer& buffer = buffers[type];
+            const MessageSchema& schema = schemas[type];
+            memcpy(buffer.columns[0] + buffer.rows * sizeof(uint64_t), raw + 1, sizeof(uint64_t));
+            for (size_t f=0; f<schema.fieldCount; f++) {
+                memcpy(buffer.columns[f + 1] + buffer.rows * sizeof(float), raw + XIOAPI_BINARY_HEADER_SIZE + 4 * schema.sources[f], sizeof(float));
+            }
+            if (++buffer.rows == XIOAPI_COLUMN_BUFFER_ROWS) ok = ok && flush(buffer, files[type], (DataMessageType) type);
+        }
+    }
+
+    for (size_t t=0; t<NUM_DATA_MESSAGE_TYPES; t++) {
+        if (buffers[t].rows > 0) ok = ok && flush(buffers[t], files[t], (DataMessageType) t);
+    }
+    return ok;
+}
+
+/**
+ * @brief Runs `task(i)` for each chunk, one thread per chunk
+*/
+template <typename Task>
+void runChunks(size_t count, Task task) {
+    std::vector<std::thread> threads;
+    for (size_t i=1; i<count; i++) {
+        threads.emplace_back(task, i);
+    }
+    if (count > 0) task(0);
+    for (size_t i=0; i<threads.size(); i++) {
+        threads[i].join();
+    }
+}
+}
+
+
+// =====================
+// === COLUMN EXPORT ===
+// =====================
+
+
+/**
+ * @return The name used for the column file of a message type, e.g. "inertial"
+*/
+const char* getColumnFileName(DataMessageType type) {
+    return type < NUM_DATA_MESSAGE_TYPES ? schemas[type].fileName : nullptr;
+}
+
+/**
+ * @return The number of columns of a message type, including the timestamp
+*/
+size_t getColumnCount(DataMessageType type) {
+    return type < NUM_DATA_MESSAGE_TYPES ? schemas[type].fieldCount + 1 : 0;
+}
+
+const char* getColumnName(DataMessageType type, size_t column) {
+    if (column >= getColumnCount(type)) return nullptr;
+    return column == 0 ? "timestamp" : schemas[type].names[column - 1];
+}
+
+/**
+ * @brief Converts a log file into one column file per message type, named
+ * "<outputPrefix>_<type>.col" (see `getColumnFileName()`). Message types without samples get no file.
+ *
+ * The blocks are split into one chunk per thread. The rows of each chunk are counted first, so every
+ * thread knows where its rows go and writes them straight into place. Each thread buffers at most
+ * `XIOAPI_COLUMN_BUFFER_ROWS` rows per message type.
+ *
+ * @param reader The open log file
+ * @param outputPrefix The path and file name prefix of the column files
+ * @param threads The number of threads, or 0 for one per CPU
+ * @param stats Optional. The rows written and blocks skipped.
+ *
+ * @return `false` if a column file could not be written
+*/
+bool exportColumns(const LogReader& reader, const char* outputPrefix, size_t threads, ColumnExportStats* stats) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    std::vector<LogRange> chunks(threads);
+    size_t count = reader.split(reader.getRange(), chunks.data(), threads);
+
+    std::vector<uint64_t> rows(count * NUM_DATA_MESSAGE_TYPES, 0);
+    runChunks(count, [&](size_t i) { countRows(reader, chunks[i], &rows[i * NUM_DATA_MESSAGE_TYPES]); });
+
+    // Turn the counts into the first row of each chunk
+    uint64_t totals[NUM_DATA_MESSAGE_TYPES] = {0};
+    for (size_t i=0; i<count; i++) {
+        for (size_t t=0; t<NUM_DATA_MESSAGE_TYPES; t++) {
+            uint64_t n = rows[i * NUM_DATA_MESSAGE_TYPES + t];
+            rows[i * NUM_DATA_MESSAGE_TYPES + t] = totals[t];
+            totals[t] += n;
+        }
+    }
+
+    bool ok = true;
+    ColumnFile files[NUM_DATA_MESSAGE_TYPES];
+    for (size_t t=0; t<NUM_DATA_MESSAGE_TYPES && ok; t++) {
+        if (totals[t] == 0) continue;
+        char path[256];
+        int len = snprintf(path, sizeof(path), "%s_%s.col", outputPrefix, schemas[t].fileName);
+        ok = len > 0 && len < (int) sizeof(path) && createFile(&files[t], path, (DataMessageType) t, totals[t]);
+    }
+
+    std::vector<size_t> corrupt(count, 0);
+    std::vector<char> converted(count, 1);
+    if (ok) {
+        runChunks(count, [&](size_t i) {
+            converted[i] = convertRows(reader, chunks[i], files, &rows[i * NUM_DATA_MESSAGE_TYPES], &corrupt[i]);
+        });
+    }
+
+    for (size_t t=0; t<NUM_DATA_MESSAGE_TYPES; t++) {
+        if (files[t].fd >= 0) ok = ::close(files[t].fd) == 0 && ok;
+    }
+    for (size_t i=0; i<count; i++) {
+        ok = ok && converted[i];
+    }
+
+    if (stats != nullptr) {
+        memcpy(stats->rows, totals, sizeof(totals));
+        stats->corruptBlocks = 0;
+        for (size_t i=0; i<count; i++) {
+            stats->corruptBlocks += corrupt[i];
+        }
+        stats->threads = count;
+    }
+    return ok;
+}
+
+#endif // ARDUINO
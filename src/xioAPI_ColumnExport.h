@@ -0,0 +1,68 @@
+/******************************************************************
+    @file       xioAPI_ColumnExport.h
+    @brief      Columnar export of indexed data logger files for host-side analysis
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_COLUMN_EXPORT_H
+#define XIOAPI_COLUMN_EXPORT_H
+
+#ifndef ARDUINO // Host only - requires mmap and threads
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xioAPI_Types.h"
+#include "xioAPI_LogReader.h"
+
+/**
+ * Column file layout (all fields little-endian), one file per message type:
+ *
+ * | HEADER | COLUMN DESCRIPTORS | COLUMN 0 | COLUMN 1 | ... |
+ *
+ * Header (24 B):            magic "XCOL", version, message type, ASCII message ID, column count,
+ *                           reserved, row count (64-bit), reserved
+ * Column descriptor (32 B): name (null-padded), element type, element size, reserved, file offset (64-bit)
+ * Column:                   row count elements back to back, starting on an 8 byte boundary
+ *
+ * The first column is the 64-bit timestamp (µs), followed by the fields of the message struct
+ * in declaration order (e.g. `InertialMessage`: ax, ay, az, gx, gy, gz) as float32.
+*/
+
+#define XIOAPI_COLUMN_VERSION               1
+#define XIOAPI_COLUMN_MAGIC                 0x4C4F4358 // "XCOL"
+#define XIOAPI_COLUMN_HEADER_SIZE           24
+#define XIOAPI_COLUMN_DESCRIPTOR_SIZE       32
+#define XIOAPI_COLUMN_NAME_SIZE             16
+#define XIOAPI_COLUMN_MAX_COLUMNS           7 // Timestamp and six inertial fields
+#define XIOAPI_COLUMN_BUFFER_ROWS           4096 // Rows buffered per message type and thread before they are written
+
+typedef enum ColumnType : uint8_t {
+    COLUMN_UINT64 = 0,
+    COLUMN_FLOAT32
+} ColumnType;
+
+struct ColumnExportStats {
+    uint64_t rows[xioAPI_Types::NUM_DATA_MESSAGE_TYPES];
+    size_t corruptBlocks;   // Blocks that failed their checksum and were skipped
+    size_t threads;         // Threads used
+};
+
+const char* getColumnFileName(xioAPI_Types::DataMessageType type);
+size_t getColumnCount(xioAPI_Types::DataMessageType type);
+const char* getColumnName(xioAPI_Types::DataMessageType type, size_t column);
+
+bool exportColumns(const LogReader& reader, const char* outputPrefix, size_t threads=0, ColumnExportStats* stats=nullptr);
+
+#endif // ARDUINO
+
+#endif // XIOAPI_COLUMN_EXPORT_H
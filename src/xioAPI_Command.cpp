@@ -0,0 +1,389 @@
+/******************************************************************
+    @file       xioAPI_Command.cpp
+    @brief      Allocation-free parser for xio API command messages
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "xioAPI_Command.h"
+#include <stdlib.h>
+#include <string.h>
+
+using namespace xioAPI_Types;
+
+namespace xioAPI_Command {
+
+namespace {
+
+const char* skipWhitespace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    return p;
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+/**
+ * @brief Scans a JSON number
+ *
+ * @param integer Set if the number has no fraction or exponent
+ *
+ * @return The end of the number, or `nullptr` if it is not a number
+*/
+const char* scanNumber(const char* p, const char* end, bool* integer) {
+    *integer = true;
+    if (p < end && *p == '-') p++;
+    if (p == end || !isDigit(*p)) return nullptr;
+    if (*p++ != '0') {
+        while (p < end && isDigit(*p)) p++;
+    }
+    if (p < end && *p == '.') {
+        *integer = false;
+        if (++p == end || !isDigit(*p)) return nullptr;
+        while (p < end && isDigit(*p)) p++;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        *integer = false;
+        if (++p < end && (*p == '+' || *p == '-')) p++;
+        if (p == end || !isDigit(*p)) return nullptr;
+        while (p < end && isDigit(*p)) p++;
+    }
+    return p;
+}
+
+/**
+ * @brief Reads the 4 hexadecimal digits of a `\u` escape sequence
+ *
+ * @return The code unit, or -1 if the digits are invalid
+*/
+long readHex4(const char* p, const char* end) {
+    if (end - p < 4) return -1;
+    long value = 0;
+    for (size_t i=0; i<4; i++) {
+        char c = p[i];
+        int digit = isDigit(c) ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+        if (digit < 0) return -1;
+        value = value << 4 | digit;
+    }
+    return value;
+}
+
+char* writeUTF8(char* out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        *out++ = (char) codePoint;
+    }
+    else if (codePoint < 0x800) {
+        *out++ = (char) (0xC0 | codePoint >> 6);
+        *out++ = (char) (0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000) {
+        *out++ = (char) (0xE0 | codePoint >> 12);
+        *out++ = (char) (0x80 | (codePoint >> 6 & 0x3F));
+        *out++ = (char) (0x80 | (codePoint & 0x3F));
+    }
+    else {
+        *out++ = (char) (0xF0 | codePoint >> 18);
+        *out++ = (char) (0x80 | (codePoint >> 12 & 0x3F));
+        *out++ = (char) (0x80 | (codePoint >> 6 & 0x3F));
+        *out++ = (char) (0x80 | (codePoint & 0x3F));
+    }
+    return out;
+}
+
+/**
+ * @brief Decodes a string in place, from after its opening quote, and null-terminates it.
+ * The decoded string is never longer than the encoded one.
+ *
+ * @return The position after the closing quote, or `nullptr` if the string is invalid
+*/
+char* parseString(char* p, const char* end) {
+    char* out = p;
+    while (p < end) {
+        char c = *p++;
+        if (c == '"') {
+            *out = '\0';
+            return p;
+        }
+        if ((uint8_t) c < 0x20) return nullptr;
+        if (c != '\\') {
+            *out++ = c;
+            continue;
+        }
+        if (p == end) return nullptr;
+        switch (*p++) {
+            case '"':   *out++ = '"'; break;
+            case '\\':  *out++ = '\\'; break;
+            case '/':   *out++ = '/'; break;
+            case 'b':   *out++ = '\b'; break;
+            case 'f':   *out++ = '\f'; break;
+            case 'n':   *out++ = '\n'; break;
+            case 'r':   *out++ = '\r'; break;
+            case 't':   *out++ = '\t'; break;
+            case 'u': {
+                long unit = readHex4(p, end);
+                if (unit < 0 || (unit >= 0xDC00 && unit <= 0xDFFF)) return nullptr;
+                p += 4;
+                uint32_t codePoint = unit;
+                if (unit >= 0xD800 && unit <= 0xDBFF) { // A surrogate pair: \uD8xx\uDCxx
+                    long low = end - p >= 2 && p[0] == '\\' && p[1] == 'u' ? readHex4(p + 2, end) : -1;
+                    if (low < 0xDC00 || low > 0xDFFF) return nullptr;
+                    p += 6;
+                    codePoint = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                }
+                out = writeUTF8(out, codePoint);
+                break;
+            }
+            default:
+                return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+bool matchLiteral(const char* p, const char* end, const char* literal, size_t len) {
+    return (size_t) (end - p) >= len && memcmp(p, literal, len) == 0;
+}
+
+} // namespace
+
+
+// =====================
+// === COMMAND VALUE ===
+// =====================
+
+
+/**
+ * @return Element `i` of an array, or an undefined value if there is no such element
+*/
+CommandValue CommandValue::operator[](size_t i) const {
+    CommandValue element;
+    if (_type != JSON_ARRAY || i >= _size) return element;
+
+    const char* p = _text;
+    for (; i > 0; i--) { // Elements are numbers, so the next comma ends each one
+        p = strchr(p, ',') + 1;
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    }
+    element._type = JSON_NUMBER;
+    element._text = p;
+    element._integer = strcspn(p, ".eE,]") == strcspn(p, ",]");
+    return element;
+}
+
+long long CommandValue::toInteger() const {
+    if (_type == JSON_BOOL) return _text[0] == 't';
+    if (_type != JSON_NUMBER) return 0;
+    return strtoll(_text, nullptr, 10);
+}
+
+double CommandValue::toDouble() const {
+    if (_type != JSON_NUMBER) return 0;
+    return strtod(_text, nullptr);
+}
+
+template <>
+bool CommandValue::as<bool>() const {
+    return _type == JSON_BOOL ? _text[0] == 't' : toDouble() != 0;
+}
+
+template <>
+const char* CommandValue::as<const char*>() const {
+    return _type == JSON_STRING ? _text : nullptr;
+}
+
+
+// ======================
+// === COMMAND PARSER ===
+// ======================
+
+
+/**
+ * @brief Parses a command message in place
+ *
+ * @param message The command message, without its terminator. The key and string values are
+ * decoded and null-terminated within it.
+ * @param size The length of the message
+ * @param command The parsed command, which refers to `message`
+ *
+ * @return `false` if the message is not a single-key command message
+*/
+bool parseCommand(char* message, size_t size, Command* command) {
+    const char* end = message + size;
+    char* p = (char*) skipWhitespace(message, end);
+    if (p == end || *p++ != '{') return false;
+    p = (char*) skipWhitespace(p, end);
+    if (p == end || *p++ != '"') return false;
+
+    // Key - hashed while it is scanned
+    uint32_t hash = 5381;
+    command->key = p;
+    while (p < end && *p != '"') {
+        if (*p == '\\' || (uint8_t) *p < 0x20) return false; // Keys are plain names
+        hash = (hash << 5) + hash + (uint8_t) *p++;
+    }
+    if (p == end) return false;
+    *p++ = '\0';
+    command->hash = hash;
+
+    p = (char*) skipWhitespace(p, end);
+    if (p == end || *p++ != ':') return false;
+    p = (char*) skipWhitespace(p, end);
+    if (p == end) return false;
+
+    // Value
+    CommandValue& value = command->value;
+    value = CommandValue();
+    value._text = p;
+    if (*p == '"') {
+        value._type = JSON_STRING;
+        value._text = ++p;
+        p = parseString(p, end);
+        if (p == nullptr) return false;
+    }
+    else if (*p == '[') {
+        value._type = JSON_ARRAY;
+        p = (char*) skipWhitespace(p + 1, end);
+        value._text = p;
+        if (p < end && *p == ']') {
+            p++;
+        }
+        else {
+            while (true) {
+                bool integer;
+                p = (char*) scanNumber(p, end, &integer);
+                if (p == nullptr || value._size == XIOAPI_COMMAND_MAX_ARRAY_SIZE) return false;
+                value._size++;
+                p = (char*) skipWhitespace(p, end);
+                if (p == end) return false;
+                if (*p == ']') {
+                    p++;
+                    break;
+                }
+                if (*p++ != ',') return false;
+                p = (char*) skipWhitespace(p, end);
+            }
+        }
+    }
+    else if (matchLiteral(p, end, "null", 4)) {
+        value._type = JSON_NULL;
+        p += 4;
+    }
+    else if (matchLiteral(p, end, "true", 4)) {
+        value._type = JSON_BOOL;
+        value._integer = true;
+        p += 4;
+    }
+    else if (matchLiteral(p, end, "false", 5)) {
+        value._type = JSON_BOOL;
+        value._integer = true;
+        p += 5;
+    }
+    else {
+        value._type = JSON_NUMBER;
+        p = (char*) scanNumber(p, end, &value._integer);
+        if (p == nullptr) return false;
+    }
+
+    p = (char*) skipWhitespace(p, end);
+    if (p == end || *p++ != '}') return false;
+    return skipWhitespace(p, end) == end;
+}
+
+
+
+// =====================
+// === OBJECT READER ===
+// =====================
+
+
+void ObjectReader::reset() {
+    _state = START_JSON;
+    _errors = 0;
+    beginMember();
+}
+
+/**
+ * @brief Reads the next byte of the object
+ *
+ * @param member The member that the byte completed, which refers to the reader's buffer and is valid
+ * until the next call
+ *
+ * @return `true` if a member was completed and parsed
+*/
+bool ObjectReader::read(char c, Command* member) {
+    bool whitespace = c == ' ' || c == '\t' || c == '\r' || c == '\n';
+
+    switch (_state) {
+        case START_JSON:
+            if (c == START_OBJ) {
+                _state = START_CMD;
+                beginMember();
+            }
+            else if (!whitespace) {
+                _errors++;
+            }
+            return false;
+        case START_CMD:
+            break;
+        default: // END_JSON - anything after the object is ignored
+            return false;
+    }
+
+    if (_inString) {
+        if (_escape) _escape = false;
+        else if (c == '\\') _escape = true;
+        else if (c == STRING_DELIM) _inString = false;
+    }
+    else if (c == STRING_DELIM) {
+        _inString = true;
+    }
+    else if (c == '[' || c == START_OBJ) {
+        _depth++;
+    }
+    else if (_depth > 0 && (c == ']' || c == END_OBJ)) {
+        _depth--;
+    }
+    else if (_depth == 0 && (c == ',' || c == END_OBJ)) {
+        if (c == END_OBJ) _state = END_JSON;
+        bool parsed = endMember(member);
+        beginMember();
+        return parsed;
+    }
+    else if (whitespace && _len == 1) {
+        return false; // Skip the indentation before a member
+    }
+
+    if (_len <= XIOAPI_OBJECT_MEMBER_SIZE) _member[_len++] = c;
+    else _overflow = true;
+    return false;
+}
+
+void ObjectReader::beginMember() {
+    _member[0] = START_OBJ;
+    _len = 1;
+    _depth = 0;
+    _inString = false;
+    _escape = false;
+    _overflow = false;
+}
+
+bool ObjectReader::endMember(Command* member) {
+    if (_overflow) {
+        _errors++;
+        return false;
+    }
+    if (skipWhitespace(_member + 1, _member + _len) == _member + _len) return false; // Empty object
+    _member[_len++] = END_OBJ;
+    if (parseCommand(_member, _len, member)) return true;
+    _errors++;
+    return false;
+}
+
+} // namespace xioAPI_Command
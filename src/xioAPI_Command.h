@@ -0,0 +1,115 @@
+/******************************************************************
+    @file       xioAPI_Command.h
+    @brief      Allocation-free parser for xio API command messages
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_COMMAND_H
+#define XIOAPI_COMMAND_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xioAPI_Types.h"
+
+/**
+ * Command messages are a JSON object with exactly one key:
+ *
+ * {"key":value}
+ *
+ * where the value is a string, a number, `true`, `false`, `null`, or an array of up to
+ * `XIOAPI_COMMAND_MAX_ARRAY_SIZE` numbers. Whitespace is allowed between tokens.
+ *
+ * The parser works in place in the message buffer: the key and string values are null-terminated
+ * where they lie (escape sequences are decoded in place) and numbers are converted when they are read,
+ * so nothing is copied or allocated. The key is hashed (DJB2, 32-bit) while it is scanned.
+*/
+
+#define XIOAPI_COMMAND_MAX_ARRAY_SIZE   9 // Elements - a 3x3 matrix
+#define XIOAPI_OBJECT_MEMBER_SIZE       256 // Bytes - the longest "key": value member read by `ObjectReader`
+
+namespace xioAPI_Command {
+
+struct Command;
+
+/**
+ * @brief A view of a command value in the message buffer. It is only valid while the buffer is unchanged.
+*/
+class CommandValue {
+public:
+    xioAPI_Types::ValueType getType() const { return _type; }
+    bool isNull() const { return _type == xioAPI_Types::JSON_NULL || _type == xioAPI_Types::JSON_UNDEFINED; }
+
+    /** @return The number of elements of an array, otherwise 0 */
+    size_t size() const { return _type == xioAPI_Types::JSON_ARRAY ? _size : 0; }
+    CommandValue operator[](size_t i) const;
+
+    /**
+     * @brief Converts the value like `JsonVariant::as<T>()`: numbers convert to any arithmetic type,
+     * `true` and `false` to `bool` or 1 and 0, and strings to `const char*`. Anything else is 0 or `nullptr`.
+    */
+    template <typename T>
+    T as() const { return _integer ? (T) toInteger() : (T) toDouble(); }
+
+private:
+    friend bool parseCommand(char* message, size_t size, Command* command);
+
+    long long toInteger() const;
+    double toDouble() const;
+
+    xioAPI_Types::ValueType _type = xioAPI_Types::JSON_UNDEFINED;
+    const char* _text = nullptr;    // The null-terminated string, the number, or the first array element
+    uint8_t _size = 0;              // Array elements
+    bool _integer = false;          // A number without a fraction or exponent, or a bool
+};
+
+template <> bool CommandValue::as<bool>() const;
+template <> const char* CommandValue::as<const char*>() const;
+
+struct Command {
+    const char* key;                // Null-terminated in the message buffer
+    uint32_t hash;                  // DJB2 hash of the key, as in `xioAPI_Protocol::APIKeyHashASCII`
+    CommandValue value;
+};
+
+bool parseCommand(char* message, size_t size, Command* command);
+
+/**
+ * @brief Reads the members of a flat JSON object, such as a configuration file, a byte at a time.
+ * Each `"key": value` member is parsed with the command grammar as soon as it is complete, so only one
+ * member is held in memory, however large the object is.
+*/
+class ObjectReader {
+public:
+    void reset();
+    bool read(char c, Command* member);
+
+    bool isComplete() const { return _state == xioAPI_Types::END_JSON; } // The closing brace was read
+    size_t getErrors() const { return _errors; } // Members that were malformed or too long
+
+private:
+    void beginMember();
+    bool endMember(Command* member);
+
+    char _member[XIOAPI_OBJECT_MEMBER_SIZE + 2]; // The member, wrapped in braces for `parseCommand()`
+    size_t _len = 0;
+    uint8_t _depth = 0;         // Nested arrays and objects
+    bool _inString = false;
+    bool _escape = false;
+    bool _overflow = false;
+    size_t _errors = 0;
+    xioAPI_Types::TokenState _state = xioAPI_Types::START_JSON;
+};
+
+} // namespace xioAPI_Command
+
+#endif // XIOAPI_COMMAND_H
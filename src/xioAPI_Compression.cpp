@@ -0,0 +1,231 @@
+/******************************************************************
+    @file       xioAPI_Compression.cpp
+    @brief      Delta and varint compression of raw data message records
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "xioAPI_Compression.h"
+
+namespace xioAPI_Compression {
+
+namespace {
+
+const float scales[XIOAPI_COMPRESSION_MAX_DECIMALS + 1] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+
+uint64_t get64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (size_t i=0; i<8; i++) {
+        value |= (uint64_t) p[i] << (8*i);
+    }
+    return value;
+}
+
+uint8_t* put64(uint8_t* p, uint64_t value) {
+    for (size_t i=0; i<8; i++) {
+        *p++ = (uint8_t) (value >> (8*i));
+    }
+    return p;
+}
+
+float getFloat(const uint8_t* p) {
+    uint32_t bits = (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint8_t* putFloat(uint8_t* p, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (size_t i=0; i<4; i++) {
+        *p++ = (uint8_t) (bits >> (8*i));
+    }
+    return p;
+}
+
+/**
+ * @return The number of channels in a raw record, or -1 if the ID is unknown
+*/
+int getChannelCount(uint8_t id) {
+    size_t size = xioAPI_Binary::getRawRecordSize(id);
+    if (size == 0) return -1;
+    return (size - XIOAPI_BINARY_HEADER_SIZE - 1) / 4;
+}
+}
+
+
+// ========================
+// === VARINT FUNCTIONS ===
+// ========================
+
+
+/**
+ * @brief Writes an unsigned varint
+ *
+ * @return One past the last byte written. At most 10 bytes are written.
+*/
+uint8_t* writeVarint(uint8_t* p, uint64_t value) {
+    while (value >= 0x80) {
+        *p++ = (uint8_t) value | 0x80;
+        value >>= 7;
+    }
+    *p++ = (uint8_t) value;
+    return p;
+}
+
+/**
+ * @brief Reads an unsigned varint
+ *
+ * @param p The first byte of the varint
+ * @param end One past the last readable byte
+ * @param value The decoded value
+ *
+ * @return One past the last byte read, or `nullptr` if the varint is truncated or too long
+*/
+const uint8_t* readVarint(const uint8_t* p, const uint8_t* end, uint64_t* value) {
+    uint64_t result = 0;
+    for (uint8_t shift=0; shift<64 && p < end; shift+=7) {
+        uint8_t byte = *p++;
+        result |= (uint64_t) (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Rounds a value to the nearest multiple of 10^-decimals.
+ * Values outside the range of `int32_t` saturate and NaN becomes 0.
+ *
+ * @return The value in units of 10^-decimals
+*/
+int32_t quantize(float value, uint8_t decimals) {
+    float scaled = value * scales[decimals];
+    if (scaled != scaled) return 0; // NaN
+    if (scaled >= 2147483520.0f) return INT32_MAX; // The largest float below 2^31
+    if (scaled <= -2147483648.0f) return INT32_MIN;
+    return (int32_t) (scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+}
+
+float dequantize(int32_t value, uint8_t decimals) {
+    return (float) value / scales[decimals];
+}
+
+
+// ==========================
+// === RECORD COMPRESSION ===
+// ==========================
+
+
+/**
+ * @brief Forgets the previous samples, so the next record of each type is stored in full
+ *
+ * @param decimals The quantization of the channels, up to `XIOAPI_COMPRESSION_MAX_DECIMALS`
+*/
+void Encoder::reset(uint8_t decimals) {
+    memset(&_state, 0, sizeof(_state));
+    _decimals = decimals > XIOAPI_COMPRESSION_MAX_DECIMALS ? XIOAPI_COMPRESSION_MAX_DECIMALS : decimals;
+}
+
+/**
+ * @brief Compresses a raw record. The encoder is only updated if the record fits in the output buffer,
+ * so a record that is rejected can be encoded again after `reset()`.
+ *
+ * @param raw The raw record, including its checksum
+ * @param rawLen The length of the raw record
+ * @param out The output buffer
+ * @param outSize The size of the output buffer
+ *
+ * @return The length of the compressed record, or 0 if it did not fit or the record is invalid
+*/
+size_t Encoder::encode(const uint8_t* raw, size_t rawLen, uint8_t* out, size_t outSize) {
+    int type = xioAPI_Binary::getMessageType(raw[0]);
+    int channels = getChannelCount(raw[0]);
+    if (type < 0 || rawLen != xioAPI_Binary::getRawRecordSize(raw[0])) return 0;
+
+    uint8_t buffer[XIOAPI_COMPRESSION_MAX_RECORD_SIZE];
+    uint8_t* p = buffer;
+    *p++ = raw[0];
+
+    uint64_t timestamp = get64(raw + 1);
+    p = writeVarint(p, zigzagEncode((int64_t) (timestamp - _state.timestamps[type])));
+
+    int32_t values[XIOAPI_COMPRESSION_MAX_CHANNELS];
+    for (int i=0; i<channels; i++) {
+        values[i] = quantize(getFloat(raw + XIOAPI_BINARY_HEADER_SIZE + 4*i), _decimals);
+        p = writeVarint(p, zigzagEncode((int64_t) values[i] - _state.channels[type][i]));
+    }
+
+    size_t len = p - buffer;
+    if (len > outSize) return 0;
+    memcpy(out, buffer, len);
+
+    _state.timestamps[type] = timestamp;
+    memcpy(_state.channels[type], values, channels * sizeof(int32_t));
+    return len;
+}
+
+/**
+ * @brief Forgets the previous samples. Must match the `Encoder::reset()` of the stream.
+*/
+void Decoder::reset(uint8_t decimals) {
+    memset(&_state, 0, sizeof(_state));
+    _decimals = decimals > XIOAPI_COMPRESSION_MAX_DECIMALS ? XIOAPI_COMPRESSION_MAX_DECIMALS : decimals;
+}
+
+/**
+ * @brief Restores the next raw record from a compressed stream. The channels are restored to the
+ * quantized values, so the record matches the original to within half of 10^-decimals.
+ *
+ * @param in The compressed stream
+ * @param inLen The number of bytes left in the stream
+ * @param raw The output buffer, at least `XIOAPI_BINARY_MAX_RAW_SIZE`
+ * @param rawSize The size of the output buffer
+ * @param rawLen The length of the restored raw record
+ *
+ * @return The number of compressed bytes read, or 0 if the stream is corrupt
+*/
+size_t Decoder::decode(const uint8_t* in, size_t inLen, uint8_t* raw, size_t rawSize, size_t* rawLen) {
+    if (inLen == 0) return 0;
+    int type = xioAPI_Binary::getMessageType(in[0]);
+    int channels = getChannelCount(in[0]);
+    size_t size = xioAPI_Binary::getRawRecordSize(in[0]);
+    if (type < 0 || rawSize < size) return 0;
+
+    const uint8_t* p = in + 1;
+    const uint8_t* end = in + inLen;
+    uint64_t delta;
+    if ((p = readVarint(p, end, &delta)) == nullptr) return 0;
+    uint64_t timestamp = _state.timestamps[type] + (uint64_t) zigzagDecode(delta);
+
+    int32_t values[XIOAPI_COMPRESSION_MAX_CHANNELS];
+    for (int i=0; i<channels; i++) {
+        if ((p = readVarint(p, end, &delta)) == nullptr) return 0;
+        values[i] = (int32_t) (_state.channels[type][i] + zigzagDecode(delta));
+    }
+
+    uint8_t* q = raw;
+    *q++ = in[0];
+    q = put64(q, timestamp);
+    for (int i=0; i<channels; i++) {
+        q = putFloat(q, dequantize(values[i], _decimals));
+    }
+    *q = xioAPI_Binary::crc8(raw, size - 1);
+    *rawLen = size;
+
+    _state.timestamps[type] = timestamp;
+    memcpy(_state.channels[type], values, channels * sizeof(int32_t));
+    return p - in;
+}
+}
@@ -0,0 +1,107 @@
+/******************************************************************
+    @file       xioAPI_Compression.h
+    @brief      Delta and varint compression of raw data message records
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_COMPRESSION_H
+#define XIOAPI_COMPRESSION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "xioAPI_Types.h"
+#include "xioAPI_Binary.h"
+
+/**
+ * Compressed record layout:
+ *
+ * | MSG ID |  TIME STAMP DELTA  |   CHANNEL DELTAS   |
+ * |   1B   | zigzag varint (µs) | n x zigzag varint  |
+ *
+ * Each channel is quantized to 10^-decimals (the resolution of the ASCII data messages by default)
+ * and stored as the difference from the previous sample of the same message type. The time stamp is
+ * stored the same way. The first sample of each type is stored relative to zero, so a stream can be
+ * decoded on its own once the encoder and decoder are reset at the same point (e.g. each log block).
+ *
+ * Varints store 7 bits per byte, least significant first, with the top bit set on all but the last
+ * byte. Zigzag encoding maps signed values to unsigned (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...) so small
+ * negative deltas also fit in one byte.
+*/
+
+#define XIOAPI_COMPRESSION_DECIMALS         4   // Quantization of the channels - 10^-4 matches the ASCII data messages
+#define XIOAPI_COMPRESSION_MAX_DECIMALS     9
+#define XIOAPI_COMPRESSION_MAX_CHANNELS     6
+#define XIOAPI_COMPRESSION_MAX_RECORD_SIZE  (1 + 10 + XIOAPI_COMPRESSION_MAX_CHANNELS * 5) // Bytes - ID, 64-bit and 33-bit varints
+
+namespace xioAPI_Compression {
+
+
+// ========================
+// === VARINT FUNCTIONS ===
+// ========================
+
+
+inline uint64_t zigzagEncode(int64_t value) { return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63); }
+inline int64_t zigzagDecode(uint64_t value) { return (int64_t) (value >> 1) ^ -(int64_t) (value & 1); }
+
+uint8_t* writeVarint(uint8_t* p, uint64_t value);
+const uint8_t* readVarint(const uint8_t* p, const uint8_t* end, uint64_t* value);
+
+int32_t quantize(float value, uint8_t decimals);
+float dequantize(int32_t value, uint8_t decimals);
+
+
+// ==========================
+// === RECORD COMPRESSION ===
+// ==========================
+
+
+/**
+ * @brief The previous sample of each message type, shared by the encoder and decoder
+*/
+struct DeltaState {
+    uint64_t timestamps[xioAPI_Types::NUM_DATA_MESSAGE_TYPES];
+    int32_t channels[xioAPI_Types::NUM_DATA_MESSAGE_TYPES][XIOAPI_COMPRESSION_MAX_CHANNELS];
+};
+
+/**
+ * @brief Compresses raw records (`xioAPI_Binary::encodeRawRecord()`) one at a time
+*/
+class Encoder {
+public:
+    void reset(uint8_t decimals=XIOAPI_COMPRESSION_DECIMALS);
+    size_t encode(const uint8_t* raw, size_t rawLen, uint8_t* out, size_t outSize);
+
+    uint8_t getDecimals() const { return _decimals; }
+
+private:
+    DeltaState _state;
+    uint8_t _decimals = XIOAPI_COMPRESSION_DECIMALS;
+};
+
+/**
+ * @brief Restores raw records from a stream written by `Encoder`
+*/
+class Decoder {
+public:
+    void reset(uint8_t decimals=XIOAPI_COMPRESSION_DECIMALS);
+    size_t decode(const uint8_t* in, size_t inLen, uint8_t* raw, size_t rawSize, size_t* rawLen);
+
+private:
+    DeltaState _state;
+    uint8_t _decimals = XIOAPI_COMPRESSION_DECIMALS;
+};
+}
+
+#endif // XIOAPI_COMPRESSION_H
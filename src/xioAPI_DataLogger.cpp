@@ -0,0 +1,534 @@
+/******************************************************************
+    @file       xioAPI_DataLogger.cpp
+    @brief      Block-buffered data logger with file rotation for the xio API data messages
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "xioAPI_DataLogger.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // ARDUINO
+
+#define XIOAPI_DATA_LOGGER_MAX_COUNTER 9999
+
+
+// ===============
+// === STORAGE ===
+// ===============
+
+
+#ifdef ARDUINO
+bool FSDataLoggerStorage::open(const char* path) {
+    _logFile = _fs.open(path, "w");
+    return (bool) _logFile;
+}
+
+size_t FSDataLoggerStorage::write(const uint8_t* data, size_t size) {
+    return _logFile.write(data, size);
+}
+
+void FSDataLoggerStorage::close() {
+    if (_logFile) _logFile.close();
+}
+
+bool FSDataLoggerStorage::exists(const char* path) {
+    return _fs.exists(path);
+}
+#else
+/**
+ * @param directory The directory that log file paths are relative to, without a trailing `/`
+*/
+POSIXDataLoggerStorage::POSIXDataLoggerStorage(const char* directory) {
+    strncpy(_directory, directory, sizeof(_directory) - 1);
+    _directory[sizeof(_directory) - 1] = '\0';
+}
+
+bool POSIXDataLoggerStorage::makePath(char* out, const char* path) {
+    int len = snprintf(out, 2 * XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH, "%s%s", _directory, path);
+    return len > 0 && len < 2 * XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH;
+}
+
+bool POSIXDataLoggerStorage::open(const char* path) {
+    char fullPath[2 * XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH];
+    close();
+    if (!makePath(fullPath, path)) return false;
+    _fd = ::open(fullPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    return _fd >= 0;
+}
+
+size_t POSIXDataLoggerStorage::write(const uint8_t* data, size_t size) {
+    size_t written = 0;
+    while (_fd >= 0 && written < size) {
+        ssize_t n = ::write(_fd, data + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        written += n;
+    }
+    return written;
+}
+
+void POSIXDataLoggerStorage::close() {
+    if (_fd < 0) return;
+    ::close(_fd);
+    _fd = -1;
+}
+
+bool POSIXDataLoggerStorage::exists(const char* path) {
+    char fullPath[2 * XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH];
+    return makePath(fullPath, path) && access(fullPath, F_OK) == 0;
+}
+#endif // ARDUINO
+
+
+// ===================
+// === DATA LOGGER ===
+// ===================
+
+
+/**
+ * @brief Resets the logger and sets the storage that log files are written to
+*/
+void DataLogger::begin(DataLoggerStorage* storage) {
+    _storage = storage;
+    _blocks[0].length = 0;
+    _blocks[1].length = 0;
+    _active = 0;
+    _pending = false;
+    _fileOpen = false;
+    _segmentBytes = 0;
+    _segmentStarted = false;
+    _sequence = 0;
+    _recordLength = 0;
+    _timestamps.reset();
+}
+
+/**
+ * @brief Accepts data messages for the log, writing each block to storage once it is full
+ *
+ * @param data The data messages. Each message must end with LF. In the indexed format, raw records.
+ * @param size The number of bytes
+ * @param config The file naming and rotation settings
+ * @param now The current time in milliseconds
+ *
+ * @return The number of bytes accepted. Less than `size` while both blocks are waiting for storage,
+ * in which case the caller should keep the rest of the data and try again later.
+*/
+size_t DataLogger::write(const uint8_t* data, size_t size, const DataLoggerConfig& config, uint32_t now) {
+    if (_storage == nullptr) return 0;
+    if (config.format != DATA_LOGGER_FORMAT_TEXT) return writeRecords(data, size, config, now);
+
+    size_t accepted = 0;
+    while (accepted < size) {
+        Block& block = _blocks[_active];
+        if (block.length == XIOAPI_DATA_LOGGER_BLOCK_SIZE) {
+            writePending(config);
+            if (_pending) break; // Both blocks are full
+            seal(config, now, false);
+            writePending(config);
+            continue;
+        }
+
+        size_t n = size - accepted;
+        if (n > XIOAPI_DATA_LOGGER_BLOCK_SIZE - block.length) {
+            n = XIOAPI_DATA_LOGGER_BLOCK_SIZE - block.length;
+        }
+        memcpy(block.data + block.length, data + accepted, n);
+        block.length += n;
+        accepted += n;
+
+        if (!_segmentStarted) {
+            _segmentStarted = true;
+            _segmentStart = now;
+        }
+    }
+
+    if (accepted < size) _stats.stalls++;
+    return accepted;
+}
+
+/**
+ * @brief Retries a pending block and rotates the file once `maxFilePeriod` has elapsed,
+ * even if no new data has arrived. Call this regularly.
+*/
+void DataLogger::service(const DataLoggerConfig& config, uint32_t now) {
+    if (_storage == nullptr) return;
+
+    writePending(config);
+    if (_pending || !_segmentStarted || config.maxFilePeriod == 0) return;
+    if (now - _segmentStart < config.maxFilePeriod * 1000UL) return;
+
+    if (seal(config, now, false)) writePending(config);
+}
+
+/**
+ * @brief Writes all buffered data and closes the log file
+*/
+void DataLogger::stop(const DataLoggerConfig& config, uint32_t now) {
+    if (_storage == nullptr) return;
+
+    flushPending(config);
+    if (!_pending && _blocks[_active].length > 0) {
+        seal(config, now, true);
+        flushPending(config);
+    }
+    if (_pending) { // The storage failed, so the remaining data is lost
+        _pending = false;
+    }
+    _blocks[_active].length = 0;
+    _recordLength = 0;
+    closeFile();
+    _segmentBytes = 0;
+    _segmentStarted = false;
+}
+
+/**
+ * @brief Hands the active block over to be written and starts filling the other block.
+ * If the block would take the file over `maxFileSize`, or `maxFilePeriod` has elapsed, the block is
+ * cut after the last message that fits and the file is closed after it is written. The rest of the
+ * block starts the next file.
+ *
+ * @param all Seal the whole block without rotating the file
+ *
+ * @return `false` if there was nothing to seal
+*/
+bool DataLogger::seal(const DataLoggerConfig& config, uint32_t now, bool all) {
+    Block& block = _blocks[_active];
+    Block& next = _blocks[_active ^ 1];
+    if (_pending || block.length == 0) return false;
+    if (config.format != DATA_LOGGER_FORMAT_TEXT) return sealIndexed(config, now, all);
+
+    size_t cut = block.length;
+    bool rotate = false;
+    if (!all) {
+        uint64_t maxBytes = (uint64_t) config.maxFileSize * 1024 * 1024; // 32 bits overflow at 4096 MB
+        bool sizeLimit = config.maxFileSize > 0 && _segmentBytes + block.length >= maxBytes;
+        bool periodLimit = config.maxFilePeriod > 0 && _segmentStarted && now - _segmentStart >= config.maxFilePeriod * 1000UL;
+        if (sizeLimit || periodLimit) {
+            size_t end = block.length;
+            if (sizeLimit && end > maxBytes - _segmentBytes) { // Only the messages that fit go into this file
+                end = _segmentBytes < maxBytes ? maxBytes - _segmentBytes : 0;
+            }
+            while (end > 0 && block.data[end - 1] != '\n') end--;
+
+            if (end > 0) {
+                cut = end;
+                rotate = true;
+            }
+            else if (!sizeLimit && block.length < XIOAPI_DATA_LOGGER_BLOCK_SIZE) { // Wait for the end of the message
+                return false;
+            }
+            else if (_segmentBytes > 0) { // No message in this block fits (only with messages longer than a block), so it starts the next file
+                closeFile();
+                _segmentBytes = 0;
+                _segmentStart = now;
+            }
+        }
+    }
+
+    next.length = block.length - cut; // The rest of the block is the start of the next file
+    memcpy(next.data, block.data + cut, next.length);
+    next.rotateAfter = false;
+
+    block.length = cut;
+    block.rotateAfter = rotate;
+    _pending = true;
+    _pendingOffset = 0;
+    _active ^= 1;
+
+    _segmentBytes += cut;
+    if (rotate) {
+        _segmentBytes = 0;
+        _segmentStarted = next.length > 0;
+        _segmentStart = now;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the pending block, opening a new file first if needed
+ *
+ * @return `true` if there is no longer a pending block
+*/
+bool DataLogger::writePending(const DataLoggerConfig& config) {
+    if (!_pending) return true;
+
+    if (!_fileOpen && !openNextFile(config)) {
+        _stats.writeErrors++;
+        return false;
+    }
+
+    Block& block = _blocks[_active ^ 1];
+    size_t n = _storage->write(block.data + _pendingOffset, block.length - _pendingOffset);
+    _pendingOffset += n;
+    _fileBytes += n;
+    _stats.bytesWritten += n;
+    if (_pendingOffset < block.length) {
+        _stats.writeErrors++;
+        return false;
+    }
+
+    _stats.blocksWritten++;
+    _pending = false;
+    if (_fileFormat != DATA_LOGGER_FORMAT_TEXT) _index.add(_fileBlocks++, block.header);
+    if (block.rotateAfter) closeFile();
+    return true;
+}
+
+/**
+ * @brief Writes the pending block, retrying short writes for as long as the storage accepts data
+*/
+void DataLogger::flushPending(const DataLoggerConfig& config) {
+    while (_pending) {
+        size_t offset = _pendingOffset;
+        if (writePending(config) || _pendingOffset == offset) return;
+    }
+}
+
+/**
+ * @brief Opens the next log file, named "/prefix[_YYYY-MM-DD_hh-mm-ss][_NNNN]extension".
+ * A counter is added when it is enabled or when the name is already taken, so existing files are never overwritten.
+*/
+bool DataLogger::openNextFile(const DataLoggerConfig& config) {
+    const char* prefix = config.fileNamePrefix != nullptr && config.fileNamePrefix[0] != '\0' ? config.fileNamePrefix : XIOAPI_DATA_LOGGER_DEFAULT_PREFIX;
+    const char* extension = config.fileExtension != nullptr ? config.fileExtension : "";
+
+    char base[XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH];
+    int len = snprintf(base, sizeof(base), "/%s", prefix);
+    struct tm now;
+    if (config.fileNameTimeEnabled && config.getTime != nullptr && config.getTime(&now) && len > 0 && (size_t) len < sizeof(base)) {
+        len += snprintf(base + len, sizeof(base) - len, "_%04d-%02d-%02d_%02d-%02d-%02d",
+                        now.tm_year + 1900, now.tm_mon + 1, now.tm_mday, now.tm_hour, now.tm_min, now.tm_sec);
+    }
+    if (len < 0 || (size_t) len >= sizeof(base)) return false;
+
+    bool named = false;
+    if (!config.fileNameCounterEnabled) {
+        len = snprintf(_fileName, sizeof(_fileName), "%s%s", base, extension);
+        named = len > 0 && (size_t) len < sizeof(_fileName) && !_storage->exists(_fileName);
+    }
+    while (!named && _fileCounter < XIOAPI_DATA_LOGGER_MAX_COUNTER) {
+        len = snprintf(_fileName, sizeof(_fileName), "%s_%04lu%s", base, (unsigned long) ++_fileCounter, extension);
+        if (len < 0 || (size_t) len >= sizeof(_fileName)) return false;
+        named = !_storage->exists(_fileName);
+    }
+    if (!named || !_storage->open(_fileName)) return false;
+
+    _fileOpen = true;
+    _fileFormat = config.format;
+    _fileBytes = 0;
+    _fileBlocks = 0;
+    _stats.filesOpened++;
+
+    if (_fileFormat != DATA_LOGGER_FORMAT_TEXT) {
+        _index.clear();
+        if (!writeFileHeader(config)) {
+            _storage->close();
+            _fileOpen = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Writes all of `data` to the log file
+*/
+bool DataLogger::writeFile(const uint8_t* data, size_t size) {
+    size_t n = _storage->write(data, size);
+    _fileBytes += n;
+    _stats.bytesWritten += n;
+    return n == size;
+}
+
+void DataLogger::closeFile() {
+    if (!_fileOpen) return;
+    if (_fileFormat != DATA_LOGGER_FORMAT_TEXT) writeIndex();
+    _storage->close();
+    _fileOpen = false;
+}
+
+
+// ======================
+// === INDEXED FORMAT ===
+// ======================
+
+
+/**
+ * @brief Splits a stream of raw records into whole records and packs them into log blocks.
+ * A record split between two calls is kept until the rest of it arrives.
+ *
+ * @return The number of bytes accepted
+*/
+size_t DataLogger::writeRecords(const uint8_t* data, size_t size, const DataLoggerConfig& config, uint32_t now) {
+    size_t accepted = 0;
+    while (true) {
+        size_t recordSize = _recordLength > 0 ? xioAPI_Binary::getRawRecordSize(_record[0]) : 0;
+        if (recordSize > 0 && _recordLength == recordSize) { // A complete record is waiting for space
+            if (!appendRecord(config, now)) break;
+            _recordLength = 0;
+            continue;
+        }
+        if (accepted == size) break;
+
+        if (_recordLength == 0) {
+            recordSize = xioAPI_Binary::getRawRecordSize(data[accepted]);
+            if (recordSize == 0) { // Resynchronise on the next record ID
+                accepted++;
+                _stats.recordErrors++;
+                continue;
+            }
+        }
+
+        size_t n = recordSize - _recordLength;
+        if (n > size - accepted) n = size - accepted;
+        memcpy(_record + _recordLength, data + accepted, n);
+        _recordLength += n;
+        accepted += n;
+        if (_recordLength < recordSize) continue;
+
+        if (xioAPI_Binary::crc8(_record, recordSize - 1) != _record[recordSize - 1]) {
+            _stats.recordErrors += recordSize;
+            _recordLength = 0;
+            continue;
+        }
+        uint32_t timestamp = (uint32_t) xioAPI_Log::getRecordTimestamp(_record);
+        xioAPI_Log::setRecordTimestamp(_record, recordSize, _timestamps.extend(timestamp));
+    }
+
+    if (accepted < size) _stats.stalls++;
+    return accepted;
+}
+
+/**
+ * @brief Appends the complete record in `_record` to the active block, sealing the block first if it is full
+ *
+ * @return `false` if both blocks are waiting for storage
+*/
+bool DataLogger::appendRecord(const DataLoggerConfig& config, uint32_t now) {
+    uint64_t timestamp = xioAPI_Log::getRecordTimestamp(_record);
+    bool compressed = config.format == DATA_LOGGER_FORMAT_COMPRESSED;
+    if (_blocks[_active].length == 0) _builder.begin(_blocks[_active].data, _sequence, compressed);
+    size_t payloadLength = _builder.getHeader().payloadLength;
+
+    if (!_builder.append(_record, _recordLength, timestamp)) {
+        writePending(config);
+        if (_pending) return false;
+        seal(config, now, false);
+        writePending(config);
+
+        _builder.begin(_blocks[_active].data, _sequence, compressed);
+        _builder.append(_record, _recordLength, timestamp);
+        payloadLength = 0;
+    }
+    _blocks[_active].length = XIOAPI_LOG_BLOCK_HEADER_SIZE + _builder.getHeader().payloadLength;
+    _stats.recordBytes += _recordLength;
+    _stats.payloadBytes += _builder.getHeader().payloadLength - payloadLength;
+
+    if (!_segmentStarted) {
+        _segmentStarted = true;
+        _segmentStart = now;
+    }
+    return true;
+}
+
+/**
+ * @brief Finishes the active log block and hands it over to be written. The file is closed after
+ * the block if the next block would take it over `maxFileSize` (including its header and the
+ * largest index) or `maxFilePeriod` has elapsed.
+*/
+bool DataLogger::sealIndexed(const DataLoggerConfig& config, uint32_t now, bool all) {
+    Block& block = _blocks[_active];
+    Block& next = _blocks[_active ^ 1];
+
+    block.header = _builder.getHeader();
+    block.length = _builder.finish();
+
+    bool rotate = false;
+    if (!all) {
+        uint32_t overhead = xioAPI_Log::getHeaderBlocks(config.settingsSize) * XIOAPI_LOG_BLOCK_SIZE
+                            + XIOAPI_LOG_INDEX_CAPACITY * XIOAPI_LOG_INDEX_ENTRY_SIZE + XIOAPI_LOG_FOOTER_SIZE;
+        bool sizeLimit = config.maxFileSize > 0 && overhead + _segmentBytes + 2 * XIOAPI_LOG_BLOCK_SIZE > (uint64_t) config.maxFileSize * 1024 * 1024;
+        bool periodLimit = config.maxFilePeriod > 0 && _segmentStarted && now - _segmentStart >= config.maxFilePeriod * 1000UL;
+        rotate = sizeLimit || periodLimit;
+    }
+
+    next.length = 0;
+    next.rotateAfter = false;
+    block.rotateAfter = rotate;
+    _pending = true;
+    _pendingOffset = 0;
+    _active ^= 1;
+    _sequence++;
+
+    _segmentBytes += XIOAPI_LOG_BLOCK_SIZE;
+    if (rotate) {
+        _segmentBytes = 0;
+        _segmentStarted = false;
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the file header, the settings snapshot and the padding up to the first block
+*/
+bool DataLogger::writeFileHeader(const DataLoggerConfig& config) {
+    static const uint8_t zeros[64] = {0};
+    uint32_t settingsSize = config.settings != nullptr ? config.settingsSize : 0;
+
+    xioAPI_Log::FileHeader header;
+    header.version = XIOAPI_LOG_VERSION;
+    header.headerBlocks = xioAPI_Log::getHeaderBlocks(settingsSize);
+    header.blockSize = XIOAPI_LOG_BLOCK_SIZE;
+    header.settingsSize = settingsSize;
+    header.settingsCRC = xioAPI_Log::crc32((const uint8_t*) config.settings, settingsSize);
+    header.firstSequence = _blocks[_active ^ 1].header.sequence; // The pending block opens the file
+
+    uint8_t buffer[XIOAPI_LOG_FILE_HEADER_SIZE];
+    if (!writeFile(buffer, xioAPI_Log::writeFileHeader(buffer, header))) return false;
+    if (settingsSize > 0 && !writeFile((const uint8_t*) config.settings, settingsSize)) return false;
+
+    size_t padding = (size_t) header.headerBlocks * XIOAPI_LOG_BLOCK_SIZE - XIOAPI_LOG_FILE_HEADER_SIZE - settingsSize;
+    while (padding > 0) {
+        size_t n = padding < sizeof(zeros) ? padding : sizeof(zeros);
+        if (!writeFile(zeros, n)) return false;
+        padding -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Appends the block index and footer to the log file
+*/
+void DataLogger::writeIndex() {
+    xioAPI_Log::Footer footer;
+    footer.indexOffset = _fileBytes;
+    footer.entryCount = _index.getEntryCount();
+    footer.blockCount = _fileBlocks;
+
+    uint8_t buffer[XIOAPI_LOG_INDEX_ENTRY_SIZE];
+    uint32_t crc = 0;
+    for (size_t i=0; i<_index.getEntryCount(); i++) {
+        size_t n = xioAPI_Log::writeIndexEntry(buffer, _index.getEntry(i));
+        crc = xioAPI_Log::crc32(buffer, n, crc);
+        if (!writeFile(buffer, n)) return;
+    }
+
+    uint8_t end[XIOAPI_LOG_FOOTER_SIZE];
+    writeFile(end, xioAPI_Log::writeFooter(end, footer, crc));
+}
@@ -0,0 +1,209 @@
+/******************************************************************
+    @file       xioAPI_DataLogger.h
+    @brief      Block-buffered data logger with file rotation for the xio API data messages
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_DATA_LOGGER_H
+#define XIOAPI_DATA_LOGGER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include "xioAPI_Log.h"
+
+#ifdef ARDUINO
+#include <FS.h>
+#endif // ARDUINO
+
+#define XIOAPI_DATA_LOGGER_BLOCK_SIZE       XIOAPI_LOG_BLOCK_SIZE // Bytes - a flash erase sector and a multiple of the 512 byte SD card sector
+#define XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH  64
+#define XIOAPI_DATA_LOGGER_DEFAULT_PREFIX   "log"
+
+
+// ===============
+// === STORAGE ===
+// ===============
+
+
+/**
+ * @brief A file system that the data logger writes its log files to.
+ * Only one file is open at a time.
+*/
+class DataLoggerStorage {
+public:
+    virtual ~DataLoggerStorage() {}
+
+    /** @brief Creates (or truncates) a file and opens it for writing */
+    virtual bool open(const char* path) = 0;
+
+    /** @return The number of bytes written, which is less than `size` on error */
+    virtual size_t write(const uint8_t* data, size_t size) = 0;
+
+    virtual void close() = 0;
+    virtual bool exists(const char* path) = 0;
+};
+
+#ifdef ARDUINO
+/**
+ * @brief Stores log files on an Arduino file system such as `SPIFFS` or `SD`
+*/
+class FSDataLoggerStorage : public DataLoggerStorage {
+public:
+    FSDataLoggerStorage(fs::FS& fs) : _fs(fs) {}
+
+    bool open(const char* path) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    void close() override;
+    bool exists(const char* path) override;
+
+private:
+    fs::FS& _fs;
+    fs::File _logFile;
+};
+#else
+/**
+ * @brief Stores log files in a directory using POSIX file I/O, for running the data logger on a host
+*/
+class POSIXDataLoggerStorage : public DataLoggerStorage {
+public:
+    POSIXDataLoggerStorage(const char* directory);
+    ~POSIXDataLoggerStorage() override { close(); }
+
+    bool open(const char* path) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    void close() override;
+    bool exists(const char* path) override;
+
+private:
+    bool makePath(char* out, const char* path);
+
+    char _directory[XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH];
+    int _fd = -1;
+};
+#endif // ARDUINO
+
+
+// ===================
+// === DATA LOGGER ===
+// ===================
+
+
+typedef enum DataLoggerFormat {
+    DATA_LOGGER_FORMAT_TEXT = 0,    // The data messages exactly as sent (ASCII or binary frames)
+    DATA_LOGGER_FORMAT_INDEXED,     // Raw records in indexed log blocks, see `xioAPI_Log.h`
+    DATA_LOGGER_FORMAT_COMPRESSED   // The indexed format with delta and varint compressed records, see `xioAPI_Compression.h`
+} DataLoggerFormat;
+
+/**
+ * @brief The `dataLogger*` settings that control file naming and rotation
+*/
+struct DataLoggerConfig {
+    DataLoggerFormat format;
+    const char* fileNamePrefix;     // Empty for `XIOAPI_DATA_LOGGER_DEFAULT_PREFIX`
+    bool fileNameTimeEnabled;       // Requires `getTime`
+    bool fileNameCounterEnabled;    // Also used when rotating files that would otherwise have the same name
+    uint32_t maxFileSize;           // MB - 0 for unlimited
+    uint32_t maxFilePeriod;         // Seconds - 0 for unlimited
+    const char* fileExtension;      // e.g. ".txt" for ASCII or ".bin" for binary data messages
+    bool (*getTime)(struct tm* now); // Optional. Returns the calendar time for file names, or `false` if it is not known
+    const void* settings;           // Indexed format - the settings snapshot for each file header
+    uint32_t settingsSize;
+};
+
+struct DataLoggerStats {
+    uint32_t filesOpened;
+    uint32_t blocksWritten;
+    uint64_t bytesWritten;
+    uint32_t writeErrors;   // Failed opens and short writes; the data is retried on the next call
+    uint32_t stalls;        // Calls that could not accept all of the data because both blocks were waiting for storage
+    uint32_t recordErrors;  // Indexed format - bytes skipped because they did not start a known raw record
+    uint64_t recordBytes;   // Indexed format - raw records logged
+    uint64_t payloadBytes;  // Indexed format - block payload used by the records; `recordBytes / payloadBytes` is the compression ratio
+};
+
+/**
+ * @brief Writes a stream of data messages to log files in whole storage blocks.
+ *
+ * Data is copied into one of two `XIOAPI_DATA_LOGGER_BLOCK_SIZE` blocks. When a block is full it
+ * is sealed and written while the other block keeps accepting data, so a slow or busy storage
+ * device does not stop the data message buffer from being drained until both blocks are waiting.
+ * Every write except the last in a file is a whole, block-aligned block.
+ *
+ * Files are rotated when the next block would exceed `maxFileSize` or when `maxFilePeriod` has
+ * elapsed since the first data in the file. Blocks are only cut after a message terminator (LF,
+ * which ends both ASCII and binary data messages), so no message is split between two files.
+ *
+ * In the indexed format the data is a stream of raw records (`xioAPI_Binary::encodeRawRecord()`),
+ * which are packed whole into log blocks. Each file starts with a header and settings snapshot
+ * and ends with an index of its blocks, written when the file is closed. The compressed format
+ * stores the records in the same blocks with delta and varint compression.
+*/
+class DataLogger {
+public:
+    void begin(DataLoggerStorage* storage);
+    size_t write(const uint8_t* data, size_t size, const DataLoggerConfig& config, uint32_t now);
+    void service(const DataLoggerConfig& config, uint32_t now);
+    void stop(const DataLoggerConfig& config, uint32_t now);
+
+    bool isLogging() const { return _fileOpen; }
+    const char* getFileName() const { return _fileName; }
+    const DataLoggerStats& getStats() const { return _stats; }
+
+private:
+    struct Block {
+        uint8_t data[XIOAPI_DATA_LOGGER_BLOCK_SIZE];
+        size_t length;
+        bool rotateAfter;   // Close the file once this block is written
+        xioAPI_Log::BlockHeader header; // Indexed format
+    };
+
+    size_t writeRecords(const uint8_t* data, size_t size, const DataLoggerConfig& config, uint32_t now);
+    bool appendRecord(const DataLoggerConfig& config, uint32_t now);
+    bool seal(const DataLoggerConfig& config, uint32_t now, bool all);
+    bool sealIndexed(const DataLoggerConfig& config, uint32_t now, bool all);
+    bool writePending(const DataLoggerConfig& config);
+    void flushPending(const DataLoggerConfig& config);
+    bool openNextFile(const DataLoggerConfig& config);
+    bool writeFileHeader(const DataLoggerConfig& config);
+    bool writeFile(const uint8_t* data, size_t size);
+    void closeFile();
+    void writeIndex();
+
+    DataLoggerStorage* _storage = nullptr;
+    Block _blocks[2];
+    uint8_t _active = 0;        // The block being filled; the other block is written when `_pending` is set
+    bool _pending = false;
+    size_t _pendingOffset = 0;  // Bytes of the pending block already written
+
+    bool _fileOpen = false;
+    char _fileName[XIOAPI_DATA_LOGGER_MAX_PATH_LENGTH] = {0};
+    uint32_t _fileCounter = 0;
+    DataLoggerFormat _fileFormat = DATA_LOGGER_FORMAT_TEXT;
+    uint32_t _fileBytes = 0;
+    uint32_t _fileBlocks = 0;   // Indexed format - data blocks written to the current file
+
+    xioAPI_Log::BlockBuilder _builder;
+    xioAPI_Log::Index _index;
+    xioAPI_Log::TimestampExtender _timestamps;
+    uint32_t _sequence = 0;
+    uint8_t _record[XIOAPI_BINARY_MAX_RAW_SIZE];
+    size_t _recordLength = 0;
+
+    uint64_t _segmentBytes = 0;     // Bytes sealed for the current file
+    uint32_t _segmentStart = 0;     // When the first byte of the current file was accepted
+    bool _segmentStarted = false;
+    DataLoggerStats _stats = {0, 0, 0, 0, 0, 0, 0, 0};
+};
+
+#endif // XIOAPI_DATA_LOGGER_H
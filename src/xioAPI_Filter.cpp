@@ -0,0 +1,118 @@
+/******************************************************************
+    @file       xioAPI_Filter.cpp
+    @brief      Anti-aliasing decimation filters for rate-divided data messages
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "xioAPI_Filter.h"
+
+/**
+ * @brief Configures the filter and clears its state
+ *
+ * @param order The number of CIC stages, limited to `XIOAPI_DECIMATION_MAX_ORDER`. 0 drops samples without filtering.
+ * @param factor The decimation factor (the message rate divisor), limited to `XIOAPI_DECIMATION_MAX_FACTOR`
+ * @param channels The number of values filtered per sample, limited to `XIOAPI_DECIMATION_MAX_CHANNELS`
+*/
+void DecimationFilter::configure(uint8_t order, uint16_t factor, uint8_t channels) {
+    _order = order < XIOAPI_DECIMATION_MAX_ORDER ? order : XIOAPI_DECIMATION_MAX_ORDER;
+    _factor = factor > 0 ? (factor < XIOAPI_DECIMATION_MAX_FACTOR ? factor : XIOAPI_DECIMATION_MAX_FACTOR) : 1;
+    _channels = channels < XIOAPI_DECIMATION_MAX_CHANNELS ? channels : XIOAPI_DECIMATION_MAX_CHANNELS;
+
+    _gain = 1.0f;
+    for (uint8_t i=0; i<_order; i++) { // The DC gain of the unnormalised filter is R^N
+        _gain /= _factor;
+    }
+    reset();
+}
+
+/**
+ * @brief Clears the partial outputs and restarts the decimation phase
+*/
+void DecimationFilter::reset() {
+    for (uint8_t j=0; j<XIOAPI_DECIMATION_MAX_ORDER; j++) {
+        for (uint8_t c=0; c<XIOAPI_DECIMATION_MAX_CHANNELS; c++) {
+            _acc[j][c] = 0.0f;
+        }
+    }
+    _phase = 0;
+}
+
+/**
+ * @brief Filters one input sample
+ *
+ * @param in The input sample, with one value per channel
+ * @param out The output sample. Only written when the function returns `true`. May alias `in`.
+ *
+ * @return `true` once every `factor` samples, when a decimated output is available
+*/
+bool DecimationFilter::update(const float* in, float* out) {
+    // A sample at phase p contributes to the output j periods later with the impulse response tap jR + R - 1 - p
+    for (uint8_t j=0; j<_order; j++) {
+        float w = weight((uint32_t) j * _factor + _factor - 1 - _phase);
+        if (w == 0.0f) continue;
+        for (uint8_t c=0; c<_channels; c++) {
+            _acc[j][c] += w * in[c];
+        }
+    }
+
+    if (++_phase < _factor) return false;
+    _phase = 0;
+
+    if (_order == 0) { // Plain sample dropping
+        for (uint8_t c=0; c<_channels; c++) {
+            out[c] = in[c];
+        }
+        return true;
+    }
+
+    for (uint8_t c=0; c<_channels; c++) {
+        out[c] = _acc[0][c] * _gain;
+    }
+    for (uint8_t j=0; j+1<_order; j++) { // Shift the partial outputs along by one output period
+        for (uint8_t c=0; c<_channels; c++) {
+            _acc[j][c] = _acc[j+1][c];
+        }
+    }
+    if (_order > 0) {
+        for (uint8_t c=0; c<_channels; c++) {
+            _acc[_order-1][c] = 0.0f;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns tap n of the unnormalised CIC impulse response:
+ * h(n) = sum_k (-1)^k C(N, k) C(n - kR + N - 1, N - 1) for n - kR >= 0
+*/
+float DecimationFilter::weight(uint32_t n) const {
+    static const int32_t binomial[XIOAPI_DECIMATION_MAX_ORDER + 1][XIOAPI_DECIMATION_MAX_ORDER + 1] = {
+        {1, 0, 0, 0},
+        {1, 1, 0, 0},
+        {1, 2, 1, 0},
+        {1, 3, 3, 1}
+    };
+
+    int32_t h = 0;
+    for (uint8_t k=0; k<=_order; k++) {
+        if (n < (uint32_t) k * _factor) break;
+        int32_t m = (int32_t) (n - (uint32_t) k * _factor);
+        int32_t taps; // C(m + N - 1, N - 1)
+        switch (_order) {
+            case 1:  taps = 1; break;
+            case 2:  taps = m + 1; break;
+            default: taps = (m + 1) * (m + 2) / 2; break;
+        }
+        h += (k % 2 ? -1 : 1) * binomial[_order][k] * taps;
+    }
+    return (float) h;
+}
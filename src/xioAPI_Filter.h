@@ -0,0 +1,57 @@
+/******************************************************************
+    @file       xioAPI_Filter.h
+    @brief      Anti-aliasing decimation filters for rate-divided data messages
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_FILTER_H
+#define XIOAPI_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define XIOAPI_DECIMATION_MAX_ORDER     3
+#define XIOAPI_DECIMATION_MAX_CHANNELS  6
+#define XIOAPI_DECIMATION_MAX_FACTOR    1024 // Keeps the order 3 impulse response taps within 32 bits
+
+/**
+ * @brief Cascaded integrator-comb (CIC) decimation filter computed in polyphase form.
+ *
+ * An order N filter decimating by R has the response ((1 - z^-R) / (1 - z^-1))^N / R^N,
+ * which places N zeros on every multiple of the output rate so that energy which would
+ * alias onto DC is removed. Each input sample is weighted into N partial outputs, so the
+ * state is N x channels floats and no input history is stored. The partial outputs are
+ * cleared as they are emitted, so the float integrators never accumulate drift.
+ *
+ * An order of 1 is a plain average of the last R samples.
+*/
+class DecimationFilter {
+public:
+    void configure(uint8_t order, uint16_t factor, uint8_t channels);
+    bool isConfigured(uint8_t order, uint16_t factor) const { return _order == order && _factor == factor; }
+    void reset();
+    void disable() { _order = 0; } // The next `configure()` starts again from a cleared state
+    bool update(const float* in, float* out);
+
+private:
+    float weight(uint32_t n) const;
+
+    float _acc[XIOAPI_DECIMATION_MAX_ORDER][XIOAPI_DECIMATION_MAX_CHANNELS] = {{0}};
+    float _gain = 1.0f;
+    uint16_t _factor = 0;
+    uint16_t _phase = 0;
+    uint8_t _order = 0;
+    uint8_t _channels = 0;
+};
+
+#endif // XIOAPI_FILTER_H
@@ -0,0 +1,103 @@
+/******************************************************************
+    @file       xioAPI_Format.cpp
+    @brief      Allocation-free ASCII formatting for the xio API data messages
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+
+    Credit - Derived from the xIMU3 User Manual
+            (https://x-io.co.uk/downloads/x-IMU3-User-Manual-v1.1.pdf).
+******************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include "xioAPI_Format.h"
+
+namespace xioAPI_Format {
+
+namespace {
+
+/**
+ * @brief Writes exactly four decimal digits of `value` (0-9999), including leading zeros
+*/
+char* formatFraction(char* out, uint32_t value) {
+    out[3] = '0' + value % 10; value /= 10;
+    out[2] = '0' + value % 10; value /= 10;
+    out[1] = '0' + value % 10; value /= 10;
+    out[0] = '0' + value;
+    return out + 4;
+}
+
+char* formatUnsigned64(char* out, uint64_t value) {
+    char digits[20];
+    size_t n = 0;
+
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+
+    while (n > 0) *out++ = digits[--n];
+    return out;
+}
+}
+
+/**
+ * @brief Formats an unsigned integer in decimal, matching `printf("%lu")`
+*/
+char* formatUnsigned(char* out, uint32_t value) {
+    char digits[XIOAPI_MAX_UNSIGNED_LENGTH];
+    size_t n = 0;
+
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+
+    while (n > 0) *out++ = digits[--n];
+    return out;
+}
+
+/**
+ * @brief Formats a float with four decimal places, matching `printf("%0.4f")`
+ *
+ * Multiplying a float by 10000 is exact in double precision (24 + 14 significant bits),
+ * so rounding the scaled value half-to-even gives the same digits as a correctly
+ * rounded printf. Non-finite values and values too large for 64-bit integer digit
+ * generation fall back to `snprintf`.
+*/
+char* formatFixed4(char* out, float value) {
+    double scaled = fabs((double) value * 10000.0);
+
+    if (!(scaled < 1.8e19)) { // Also catches NaN and infinity
+        int len = snprintf(out, XIOAPI_MAX_FIXED4_LENGTH + 1, "%0.4f", value);
+        return out + (len > 0 ? len : 0);
+    }
+
+    // Round half to even, exactly as printf does in the default rounding mode
+    double whole = floor(scaled);
+    double remainder = scaled - whole;
+    uint64_t digits = (uint64_t) whole;
+    if (remainder > 0.5 || (remainder == 0.5 && (digits & 1))) digits++;
+
+    if (signbit(value)) *out++ = '-';
+
+    if (digits < 0xFFFFFFFFULL) { // Fast path: avoid 64-bit division on 32-bit targets
+        uint32_t digits32 = (uint32_t) digits;
+        out = formatUnsigned(out, digits32 / 10000);
+        *out++ = '.';
+        return formatFraction(out, digits32 % 10000);
+    }
+
+    out = formatUnsigned64(out, digits / 10000);
+    *out++ = '.';
+    return formatFraction(out, (uint32_t) (digits % 10000));
+}
+}
@@ -0,0 +1,158 @@
+/******************************************************************
+    @file       xioAPI_Format.h
+    @brief      Allocation-free ASCII formatting for the xio API data messages
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+    Credit - Derived from the xIMU3 User Manual
+            (https://x-io.co.uk/downloads/x-IMU3-User-Manual-v1.1.pdf).
+
+******************************************************************/
+
+#ifndef XIOAPI_FORMAT_H
+#define XIOAPI_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xioAPI_Types.h"
+#include "xioAPI_Protocol.h"
+
+#define XIOAPI_MAX_UNSIGNED_LENGTH  10  // Characters - "4294967295"
+#define XIOAPI_MAX_FIXED4_LENGTH    46  // Characters - "-" + 39 integer digits (FLT_MAX) + "." + 4 decimals
+
+namespace xioAPI_Format {
+
+/**
+ * These functions produce byte-identical output to `printf("%lu")` and `printf("%0.4f")`
+ * without going through the printf parser or the locale, and without using the heap.
+ * Each function writes at most its `XIOAPI_MAX_*_LENGTH` characters, does NOT null-terminate,
+ * and returns a pointer to the character following the last one written.
+*/
+
+char* formatUnsigned(char* out, uint32_t value);
+char* formatFixed4(char* out, float value);
+
+/**
+ * @brief A string field that is copied up to `N` characters into a message
+*/
+template <size_t N>
+struct BoundedText {
+    BoundedText(const char* s) : str(s) {}
+    const char* str;
+};
+
+/**
+ * @brief Maximum number of characters each field type can produce
+*/
+template <typename T> struct FieldTraits;
+template <> struct FieldTraits<uint32_t> { static constexpr size_t maxLength = XIOAPI_MAX_UNSIGNED_LENGTH; };
+template <> struct FieldTraits<float> { static constexpr size_t maxLength = XIOAPI_MAX_FIXED4_LENGTH; };
+template <size_t N> struct FieldTraits<BoundedText<N>> { static constexpr size_t maxLength = N; };
+
+/**
+ * @brief Appends a comma and an unsigned integer field to a data message
+*/
+inline char* appendField(char* out, uint32_t value) {
+    *out++ = ',';
+    return formatUnsigned(out, value);
+}
+
+/**
+ * @brief Appends a comma and a 4-decimal floating point field to a data message
+*/
+inline char* appendField(char* out, float value) {
+    *out++ = ',';
+    return formatFixed4(out, value);
+}
+
+/**
+ * @brief Appends a comma and at most `N` characters of a string to a message
+*/
+template <size_t N>
+inline char* appendField(char* out, BoundedText<N> text) {
+    *out++ = ',';
+    const char* s = text.str;
+    for (size_t i=0; i<N && s[i] != '\0'; i++) {
+        *out++ = s[i];
+    }
+    return out;
+}
+
+inline char* appendFields(char* out) { return out; }
+
+template <typename Field, typename... Fields>
+inline char* appendFields(char* out, Field field, Fields... fields) {
+    return appendFields(appendField(out, field), fields...);
+}
+
+/**
+ * @brief Sums the comma and maximum length of every field in a message
+*/
+template <typename... Fields> struct FieldsLength;
+template <> struct FieldsLength<> { static constexpr size_t value = 0; };
+template <typename Field, typename... Fields>
+struct FieldsLength<Field, Fields...> {
+    static constexpr size_t value = 1 + FieldTraits<Field>::maxLength + FieldsLength<Fields...>::value;
+};
+
+/**
+ * @brief Compile-time description of a comma-separated ASCII message: "ID,field,field,..."
+ * 
+ * The field sequence is fixed by the template arguments, so `format()` expands to
+ * straight-line code and `bufferSize` is the exact worst-case size of the message.
+ * 
+ * @tparam ID The message ID character
+ * @tparam Fields The field types, in order (`uint32_t`, `float` or `BoundedText<N>`)
+*/
+template <char ID, typename... Fields>
+struct MessageLayout {
+    static constexpr char id = ID;
+    static constexpr size_t maxLength = 1 + FieldsLength<Fields...>::value;
+    static constexpr size_t bufferSize = maxLength + 1; // Includes the null terminator
+
+    /**
+     * @brief Formats a message into `out`, which must hold at least `bufferSize` characters
+     * 
+     * @return The length of the message, excluding the null terminator
+    */
+    static size_t format(char* out, Fields... fields) {
+        char* p = out;
+        *p++ = ID;
+        p = appendFields(p, fields...);
+        *p = xioAPI_Protocol::NULL_TERMINATOR;
+        return p - out;
+    }
+};
+
+
+// ================================
+// === DATA MESSAGE DEFINITIONS ===
+// ================================
+
+
+typedef MessageLayout<'I', uint32_t, float, float, float, float, float, float>  InertialLayout;     // "I,timestamp (µs),gx,gy,gz,ax,ay,az"
+typedef MessageLayout<'M', uint32_t, float, float, float>                       MagnetometerLayout; // "M,timestamp (µs),mx,my,mz"
+typedef MessageLayout<'H', uint32_t, float, float, float>                       HighGAccelerometerLayout; // "H,timestamp (µs),ax,ay,az"
+typedef MessageLayout<'T', uint32_t, float>                                     TemperatureLayout;  // "T,timestamp (µs),temperature (°C)"
+typedef MessageLayout<'Q', uint32_t, float, float, float, float>                QuaternionLayout;   // "Q,timestamp (µs),w,x,y,z"
+typedef MessageLayout<'A', uint32_t, float, float, float>                       EulerLayout;        // "A,timestamp (µs),roll,pitch,yaw"
+typedef MessageLayout<'B', uint32_t, float, float, uint32_t>                    BatteryLayout;      // "B,timestamp (µs),percentCharged,voltage,status"
+typedef MessageLayout<'W', uint32_t, float, float>                              RSSILayout;         // "W,timestamp (µs),percent,power (dBm)"
+typedef MessageLayout<'N', uint32_t, BoundedText<NOTE_SIZE>>                    NotificationLayout; // "N,timestamp (µs),note"
+typedef MessageLayout<'F', uint32_t, BoundedText<NOTE_SIZE>>                    ErrorLayout;        // "F,timestamp (µs),errorMessage"
+
+/**
+ * @brief Size of a buffer that fits any of the data message layouts
+*/
+#define XIOAPI_DATA_MESSAGE_SIZE (xioAPI_Format::InertialLayout::bufferSize)
+}
+
+#endif // XIOAPI_FORMAT_H
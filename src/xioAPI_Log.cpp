@@ -0,0 +1,432 @@
+/******************************************************************
+    @file       xioAPI_Log.cpp
+    @brief      Indexed, block-structured binary log file format for the xio API data messages
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "xioAPI_Log.h"
+
+namespace xioAPI_Log {
+
+namespace {
+
+uint8_t* put16(uint8_t* p, uint16_t value) {
+    *p++ = (uint8_t) value;
+    *p++ = (uint8_t) (value >> 8);
+    return p;
+}
+
+uint8_t* put32(uint8_t* p, uint32_t value) {
+    for (size_t i=0; i<4; i++) {
+        *p++ = (uint8_t) (value >> (8*i));
+    }
+    return p;
+}
+
+uint8_t* put64(uint8_t* p, uint64_t value) {
+    for (size_t i=0; i<8; i++) {
+        *p++ = (uint8_t) (value >> (8*i));
+    }
+    return p;
+}
+
+uint16_t get16(const uint8_t* p) {
+    return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+uint32_t get32(const uint8_t* p) {
+    uint32_t value = 0;
+    for (size_t i=0; i<4; i++) {
+        value |= (uint32_t) p[i] << (8*i);
+    }
+    return value;
+}
+
+uint64_t get64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (size_t i=0; i<8; i++) {
+        value |= (uint64_t) p[i] << (8*i);
+    }
+    return value;
+}
+}
+
+
+// ========================
+// === FORMAT FUNCTIONS ===
+// ========================
+
+
+/**
+ * @brief Computes the CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) of a block of data
+ *
+ * @param crc The CRC of the preceding data, to checksum data in pieces
+*/
+uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc) {
+    static const uint32_t table[16] = { // One nibble at a time
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Returns the number of blocks taken by the file header and a settings snapshot of `settingsSize` bytes
+*/
+uint16_t getHeaderBlocks(uint32_t settingsSize) {
+    return (uint16_t) ((XIOAPI_LOG_FILE_HEADER_SIZE + settingsSize + XIOAPI_LOG_BLOCK_SIZE - 1) / XIOAPI_LOG_BLOCK_SIZE);
+}
+
+/**
+ * @return The number of bytes written, `XIOAPI_LOG_FILE_HEADER_SIZE`
+*/
+size_t writeFileHeader(uint8_t* out, const FileHeader& header) {
+    uint8_t* p = put32(out, XIOAPI_LOG_FILE_MAGIC);
+    p = put16(p, header.version);
+    p = put16(p, header.headerBlocks);
+    p = put32(p, header.blockSize);
+    p = put32(p, header.settingsSize);
+    p = put32(p, header.settingsCRC);
+    p = put32(p, header.firstSequence);
+    p = put32(p, 0);
+    put32(p, crc32(out, XIOAPI_LOG_FILE_HEADER_SIZE - 4));
+    return XIOAPI_LOG_FILE_HEADER_SIZE;
+}
+
+/**
+ * @return `false` if the data is not a log file header of a supported version
+*/
+bool readFileHeader(const uint8_t* data, size_t size, FileHeader* header) {
+    if (size < XIOAPI_LOG_FILE_HEADER_SIZE || get32(data) != XIOAPI_LOG_FILE_MAGIC) return false;
+    if (crc32(data, XIOAPI_LOG_FILE_HEADER_SIZE - 4) != get32(data + XIOAPI_LOG_FILE_HEADER_SIZE - 4)) return false;
+
+    header->version = get16(data + 4);
+    header->headerBlocks = get16(data + 6);
+    header->blockSize = get32(data + 8);
+    header->settingsSize = get32(data + 12);
+    header->settingsCRC = get32(data + 16);
+    header->firstSequence = get32(data + 20);
+    return header->version == XIOAPI_LOG_VERSION && header->blockSize == XIOAPI_LOG_BLOCK_SIZE;
+}
+
+/**
+ * @brief Reads and verifies the header of a log block
+ *
+ * @param block The start of the block
+ * @param size The number of bytes available at `block`
+ * @param verify Verify the checksum of the whole block
+ *
+ * @return `false` if the block is incomplete, empty or corrupt
+*/
+bool readBlockHeader(const uint8_t* block, size_t size, BlockHeader* header, bool verify) {
+    if (size < XIOAPI_LOG_BLOCK_HEADER_SIZE || get32(block) != XIOAPI_LOG_BLOCK_MAGIC) return false;
+
+    header->sequence = get32(block + 4);
+    header->firstTimestamp = get64(block + 8);
+    header->lastTimestamp = get64(block + 16);
+    header->recordCount = get16(block + 24);
+    header->payloadLength = get16(block + 26);
+    header->typeMask = get16(block + 28);
+    header->flags = block[30];
+    header->decimals = block[31];
+    if (header->payloadLength > XIOAPI_LOG_MAX_PAYLOAD_SIZE || size < XIOAPI_LOG_BLOCK_HEADER_SIZE + (size_t) header->payloadLength) return false;
+    if (!verify) return true;
+
+    uint32_t crc = crc32(block, XIOAPI_LOG_BLOCK_HEADER_SIZE - 4);
+    crc = crc32(block + XIOAPI_LOG_BLOCK_HEADER_SIZE, header->payloadLength, crc);
+    return crc == get32(block + XIOAPI_LOG_BLOCK_HEADER_SIZE - 4);
+}
+
+/**
+ * @return The number of bytes written, `XIOAPI_LOG_INDEX_ENTRY_SIZE`
+*/
+size_t writeIndexEntry(uint8_t* out, const IndexEntry& entry) {
+    uint8_t* p = put32(out, entry.firstBlock);
+    p = put32(p, entry.blockCount);
+    p = put16(p, entry.typeMask);
+    p = put16(p, 0);
+    p = put32(p, entry.firstSequence);
+    p = put64(p, entry.firstTimestamp);
+    put64(p, entry.lastTimestamp);
+    return XIOAPI_LOG_INDEX_ENTRY_SIZE;
+}
+
+bool readIndexEntry(const uint8_t* data, IndexEntry* entry) {
+    entry->firstBlock = get32(data);
+    entry->blockCount = get32(data + 4);
+    entry->typeMask = get16(data + 8);
+    entry->firstSequence = get32(data + 12);
+    entry->firstTimestamp = get64(data + 16);
+    entry->lastTimestamp = get64(data + 24);
+    return entry->blockCount > 0;
+}
+
+/**
+ * @param indexCRC The CRC-32 of the serialized index entries
+ *
+ * @return The number of bytes written, `XIOAPI_LOG_FOOTER_SIZE`
+*/
+size_t writeFooter(uint8_t* out, const Footer& footer, uint32_t indexCRC) {
+    uint8_t* p = put32(out, XIOAPI_LOG_INDEX_MAGIC);
+    p = put32(p, footer.indexOffset);
+    p = put32(p, footer.entryCount);
+    p = put32(p, footer.blockCount);
+    p = put32(p, 0);
+    put32(p, crc32(out, XIOAPI_LOG_FOOTER_SIZE - 4, indexCRC));
+    return XIOAPI_LOG_FOOTER_SIZE;
+}
+
+/**
+ * @brief Reads the footer from the last `XIOAPI_LOG_FOOTER_SIZE` bytes of a log file
+ *
+ * @param indexCRC The CRC-32 of the index entries that precede the footer. The fields are read even
+ *                 if it does not match, so the index can be located before it is checksummed.
+ *
+ * @return `false` if the file has no valid footer, in which case the blocks must be scanned
+*/
+bool readFooter(const uint8_t* data, Footer* footer, uint32_t indexCRC) {
+    if (get32(data) != XIOAPI_LOG_INDEX_MAGIC) return false;
+    footer->indexOffset = get32(data + 4);
+    footer->entryCount = get32(data + 8);
+    footer->blockCount = get32(data + 12);
+    return crc32(data, XIOAPI_LOG_FOOTER_SIZE - 4, indexCRC) == get32(data + XIOAPI_LOG_FOOTER_SIZE - 4);
+}
+
+/**
+ * @brief Returns the 64-bit timestamp of a raw record
+*/
+uint64_t getRecordTimestamp(const uint8_t* raw) {
+    return get64(raw + 1);
+}
+
+/**
+ * @brief Replaces the timestamp of a raw record and updates its checksum
+*/
+void setRecordTimestamp(uint8_t* raw, size_t rawLen, uint64_t timestamp) {
+    put64(raw + 1, timestamp);
+    raw[rawLen - 1] = xioAPI_Binary::crc8(raw, rawLen - 1);
+}
+
+
+// =====================
+// === BLOCK BUILDER ===
+// =====================
+
+
+/**
+ * @brief Starts a new block
+ *
+ * @param block The block buffer, `XIOAPI_LOG_BLOCK_SIZE` bytes
+ * @param sequence The sequence number of the block
+ * @param compressed Compress the records with `xioAPI_Compression`
+*/
+void BlockBuilder::begin(uint8_t* block, uint32_t sequence, bool compressed) {
+    _block = block;
+    memset(&_header, 0, sizeof(_header));
+    _header.sequence = sequence;
+    if (compressed) {
+        _header.flags |= XIOAPI_LOG_BLOCK_COMPRESSED;
+        _header.decimals = XIOAPI_COMPRESSION_DECIMALS;
+        _encoder.reset(_header.decimals);
+    }
+}
+
+/**
+ * @brief Appends a raw record to the block
+ *
+ * @param raw The record, with its 64-bit timestamp already set
+ * @param rawLen The length of the record
+ * @param timestamp The 64-bit timestamp of the record
+ *
+ * @return `false` if the block is full
+*/
+bool BlockBuilder::append(const uint8_t* raw, size_t rawLen, uint64_t timestamp) {
+    uint8_t* end = _block + XIOAPI_LOG_BLOCK_HEADER_SIZE + _header.payloadLength;
+    size_t space = XIOAPI_LOG_MAX_PAYLOAD_SIZE - _header.payloadLength;
+    if (_header.flags & XIOAPI_LOG_BLOCK_COMPRESSED) {
+        size_t len = _encoder.encode(raw, rawLen, end, space);
+        if (len == 0) return false;
+        _header.payloadLength += len;
+    }
+    else {
+        if (rawLen > space) return false;
+        memcpy(end, raw, rawLen);
+        _header.payloadLength += rawLen;
+    }
+
+    if (_header.recordCount == 0 || timestamp < _header.firstTimestamp) _header.firstTimestamp = timestamp;
+    if (_header.recordCount == 0 || timestamp > _header.lastTimestamp) _header.lastTimestamp = timestamp;
+    _header.recordCount++;
+
+    int type = xioAPI_Binary::getMessageType(raw[0]);
+    if (type >= 0) _header.typeMask |= 1 << type;
+    return true;
+}
+
+/**
+ * @brief Writes the block header and checksum and zeroes the unused space
+ *
+ * @return The size of the block, `XIOAPI_LOG_BLOCK_SIZE`
+*/
+size_t BlockBuilder::finish() {
+    memset(_block + XIOAPI_LOG_BLOCK_HEADER_SIZE + _header.payloadLength, 0, XIOAPI_LOG_MAX_PAYLOAD_SIZE - _header.payloadLength);
+
+    uint8_t* p = put32(_block, XIOAPI_LOG_BLOCK_MAGIC);
+    p = put32(p, _header.sequence);
+    p = put64(p, _header.firstTimestamp);
+    p = put64(p, _header.lastTimestamp);
+    p = put16(p, _header.recordCount);
+    p = put16(p, _header.payloadLength);
+    p = put16(p, _header.typeMask);
+    *p++ = _header.flags;
+    *p++ = _header.decimals;
+    p = put32(p, 0);
+
+    uint32_t crc = crc32(_block, XIOAPI_LOG_BLOCK_HEADER_SIZE - 4);
+    crc = crc32(_block + XIOAPI_LOG_BLOCK_HEADER_SIZE, _header.payloadLength, crc);
+    put32(p, crc);
+    return XIOAPI_LOG_BLOCK_SIZE;
+}
+
+
+// ====================
+// === BLOCK READER ===
+// ====================
+
+
+/**
+ * @brief Verifies a log block and starts reading its records
+ *
+ * @param block The start of the block
+ * @param size The number of bytes available at `block`
+ *
+ * @return `false` if the block is incomplete, empty or corrupt
+*/
+bool BlockReader::begin(const uint8_t* block, size_t size) {
+    _payload = nullptr;
+    _offset = 0;
+    _corrupt = false;
+    if (!readBlockHeader(block, size, &_header)) return false;
+
+    _payload = block + XIOAPI_LOG_BLOCK_HEADER_SIZE;
+    _decoder.reset(_header.decimals);
+    return true;
+}
+
+/**
+ * @brief Returns the next raw record of the block, with its 64-bit timestamp and checksum.
+ * The record is valid until the next call.
+ *
+ * @param rawLen The length of the record
+ *
+ * @return The record, or `nullptr` at the end of the block or if a record is corrupt (`isCorrupt()`)
+*/
+const uint8_t* BlockReader::next(size_t* rawLen) {
+    if (_payload == nullptr || _corrupt || _offset >= _header.payloadLength) return nullptr;
+    const uint8_t* p = _payload + _offset;
+    size_t remaining = _header.payloadLength - _offset;
+
+    if (_header.flags & XIOAPI_LOG_BLOCK_COMPRESSED) {
+        size_t n = _decoder.decode(p, remaining, _raw, sizeof(_raw), rawLen);
+        if (n == 0) {
+            _corrupt = true;
+            return nullptr;
+        }
+        _offset += n;
+        return _raw;
+    }
+
+    size_t n = xioAPI_Binary::getRawRecordSize(p[0]);
+    if (n == 0 || n > remaining) {
+        _corrupt = true;
+        return nullptr;
+    }
+    _offset += n;
+    *rawLen = n;
+    return p;
+}
+
+
+// =================
+// === LOG INDEX ===
+// =================
+
+
+void Index::clear() {
+    _count = 0;
+    _blocksPerEntry = 1;
+}
+
+/**
+ * @brief Adds a written block to the index
+ *
+ * @param blockNumber The number of the block after the header blocks
+ * @param header The header of the block
+*/
+void Index::add(uint32_t blockNumber, const BlockHeader& header) {
+    if (_count == XIOAPI_LOG_INDEX_CAPACITY && _entries[_count - 1].blockCount >= _blocksPerEntry) {
+        for (size_t i=0; i<_count/2; i++) { // Merge neighbouring entries
+            IndexEntry& a = _entries[2*i];
+            const IndexEntry& b = _entries[2*i + 1];
+            a.blockCount += b.blockCount;
+            a.typeMask |= b.typeMask;
+            if (b.firstTimestamp < a.firstTimestamp) a.firstTimestamp = b.firstTimestamp;
+            if (b.lastTimestamp > a.lastTimestamp) a.lastTimestamp = b.lastTimestamp;
+            _entries[i] = a;
+        }
+        _count /= 2;
+        _blocksPerEntry *= 2;
+    }
+
+    if (_count > 0 && _entries[_count - 1].blockCount < _blocksPerEntry) {
+        IndexEntry& entry = _entries[_count - 1];
+        entry.blockCount++;
+        entry.typeMask |= header.typeMask;
+        if (header.firstTimestamp < entry.firstTimestamp) entry.firstTimestamp = header.firstTimestamp;
+        if (header.lastTimestamp > entry.lastTimestamp) entry.lastTimestamp = header.lastTimestamp;
+        return;
+    }
+
+    IndexEntry& entry = _entries[_count++];
+    entry.firstBlock = blockNumber;
+    entry.blockCount = 1;
+    entry.typeMask = header.typeMask;
+    entry.firstSequence = header.sequence;
+    entry.firstTimestamp = header.firstTimestamp;
+    entry.lastTimestamp = header.lastTimestamp;
+}
+
+/**
+ * @brief Returns the 64-bit equivalent of a 32-bit timestamp, counting the wrap-arounds so far
+*/
+uint64_t TimestampExtender::extend(uint32_t timestamp) {
+    if (!_started) {
+        _started = true;
+        _last = timestamp;
+        return _last;
+    }
+
+    int32_t delta = (int32_t) (timestamp - (uint32_t) _last);
+    if (delta >= 0) {
+        _last += delta;
+        return _last;
+    }
+    uint64_t age = (uint64_t) -(int64_t) delta; // An older sample from another message type
+    return age > _last ? 0 : _last - age;
+}
+}
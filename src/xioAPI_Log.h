@@ -0,0 +1,206 @@
+/******************************************************************
+    @file       xioAPI_Log.h
+    @brief      Indexed, block-structured binary log file format for the xio API data messages
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_LOG_H
+#define XIOAPI_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "xioAPI_Types.h"
+#include "xioAPI_Protocol.h"
+#include "xioAPI_Binary.h"
+#include "xioAPI_Compression.h"
+
+/**
+ * Log file layout (all fields little-endian):
+ *
+ * | FILE HEADER | SETTINGS | padding | BLOCK 0 | BLOCK 1 | ... | INDEX ENTRIES | FOOTER |
+ *  \________ header blocks ________/  \__ XIOAPI_LOG_BLOCK_SIZE each __/
+ *
+ * File header (32 B): magic "XLOG", version, header block count, block size, settings size,
+ *                     settings CRC-32, first block sequence number, reserved, header CRC-32
+ * Settings:           a raw snapshot of the device settings struct when the file was opened
+ * Block header (40 B): magic "XBLK", sequence number, first and last timestamp (µs, 64-bit),
+ *                     record count, payload length, message type mask, flags, decimals, reserved, CRC-32
+ * Block payload:      raw records (`xioAPI_Binary::encodeRawRecord()`) back to back, then zero padding.
+ *                     Blocks flagged `XIOAPI_LOG_BLOCK_COMPRESSED` hold compressed records instead
+ *                     (`xioAPI_Compression`), quantized to 10^-decimals and reset at each block.
+ * Index entry (32 B): first block, block count, message type mask, first sequence number,
+ *                     first and last timestamp (µs, 64-bit), reserved
+ * Footer (24 B):      magic "XIDX", index offset, entry count, block count, reserved, CRC-32
+ *
+ * Every block is self-describing and protected by its own CRC, so a file that was not closed
+ * (e.g. power loss) is recovered by scanning the blocks; only the block being written is lost.
+ * Record timestamps are extended to 64 bits by the writer so they never wrap within a log.
+ * The message type mask has bit `1 << DataMessageType` set for each type in the block(s).
+*/
+
+#define XIOAPI_LOG_VERSION              1
+#define XIOAPI_LOG_BLOCK_SIZE           4096 // Bytes
+#define XIOAPI_LOG_FILE_MAGIC           0x474F4C58 // "XLOG"
+#define XIOAPI_LOG_BLOCK_MAGIC          0x4B4C4258 // "XBLK"
+#define XIOAPI_LOG_INDEX_MAGIC          0x58444958 // "XIDX"
+#define XIOAPI_LOG_FILE_HEADER_SIZE     32
+#define XIOAPI_LOG_BLOCK_HEADER_SIZE    40
+#define XIOAPI_LOG_INDEX_ENTRY_SIZE     32
+#define XIOAPI_LOG_FOOTER_SIZE          24
+#define XIOAPI_LOG_MAX_PAYLOAD_SIZE     (XIOAPI_LOG_BLOCK_SIZE - XIOAPI_LOG_BLOCK_HEADER_SIZE)
+#define XIOAPI_LOG_INDEX_CAPACITY       128 // Entries - the index is coarsened to stay within this
+#define XIOAPI_LOG_BLOCK_COMPRESSED     0x01 // Block flag
+
+namespace xioAPI_Log {
+
+struct FileHeader {
+    uint16_t version;
+    uint16_t headerBlocks;      // Blocks taken by the file header and settings snapshot
+    uint32_t blockSize;
+    uint32_t settingsSize;
+    uint32_t settingsCRC;
+    uint32_t firstSequence;
+};
+
+struct BlockHeader {
+    uint32_t sequence;          // Counts blocks across all files of a logging session
+    uint64_t firstTimestamp;    // Smallest record timestamp
+    uint64_t lastTimestamp;     // Largest record timestamp
+    uint16_t recordCount;
+    uint16_t payloadLength;
+    uint16_t typeMask;
+    uint8_t flags;
+    uint8_t decimals;           // Compressed blocks - the quantization of the channels
+};
+
+struct IndexEntry {
+    uint32_t firstBlock;        // Block number after the header blocks
+    uint32_t blockCount;
+    uint16_t typeMask;
+    uint32_t firstSequence;
+    uint64_t firstTimestamp;
+    uint64_t lastTimestamp;
+};
+
+struct Footer {
+    uint32_t indexOffset;       // File offset of the first index entry
+    uint32_t entryCount;
+    uint32_t blockCount;
+};
+
+
+// ========================
+// === FORMAT FUNCTIONS ===
+// ========================
+
+
+uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc=0);
+uint16_t getHeaderBlocks(uint32_t settingsSize);
+
+size_t writeFileHeader(uint8_t* out, const FileHeader& header);
+bool readFileHeader(const uint8_t* data, size_t size, FileHeader* header);
+bool readBlockHeader(const uint8_t* block, size_t size, BlockHeader* header, bool verify=true);
+size_t writeIndexEntry(uint8_t* out, const IndexEntry& entry);
+bool readIndexEntry(const uint8_t* data, IndexEntry* entry);
+size_t writeFooter(uint8_t* out, const Footer& footer, uint32_t indexCRC);
+bool readFooter(const uint8_t* data, Footer* footer, uint32_t indexCRC);
+
+uint64_t getRecordTimestamp(const uint8_t* raw);
+void setRecordTimestamp(uint8_t* raw, size_t rawLen, uint64_t timestamp);
+
+
+// =====================
+// === BLOCK BUILDER ===
+// =====================
+
+
+/**
+ * @brief Packs raw records into a log block in place
+*/
+class BlockBuilder {
+public:
+    void begin(uint8_t* block, uint32_t sequence, bool compressed=false);
+    bool append(const uint8_t* raw, size_t rawLen, uint64_t timestamp);
+    size_t finish();
+
+    bool isEmpty() const { return _header.recordCount == 0; }
+    const BlockHeader& getHeader() const { return _header; }
+
+private:
+    uint8_t* _block = nullptr;
+    BlockHeader _header;
+    xioAPI_Compression::Encoder _encoder;
+};
+
+/**
+ * @brief Reads the raw records of a log block, decompressing them if needed
+*/
+class BlockReader {
+public:
+    bool begin(const uint8_t* block, size_t size);
+    const uint8_t* next(size_t* rawLen);
+
+    const BlockHeader& getHeader() const { return _header; }
+    bool isCorrupt() const { return _corrupt; }
+
+private:
+    const uint8_t* _payload = nullptr;
+    size_t _offset = 0;
+    BlockHeader _header;
+    bool _corrupt = false;
+    xioAPI_Compression::Decoder _decoder;
+    uint8_t _raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+};
+
+
+// =================
+// === LOG INDEX ===
+// =================
+
+
+/**
+ * @brief Builds the trailing index of a log file in a fixed amount of memory.
+ * Each entry starts out covering one block. When the index is full, neighbouring entries are
+ * merged so that each covers twice as many blocks, keeping the whole file indexed.
+*/
+class Index {
+public:
+    void clear();
+    void add(uint32_t blockNumber, const BlockHeader& header);
+
+    size_t getEntryCount() const { return _count; }
+    const IndexEntry& getEntry(size_t i) const { return _entries[i]; }
+
+private:
+    IndexEntry _entries[XIOAPI_LOG_INDEX_CAPACITY];
+    size_t _count = 0;
+    uint32_t _blocksPerEntry = 1;
+};
+
+/**
+ * @brief Extends 32-bit microsecond timestamps to 64 bits across wrap-arounds.
+ * Tolerates samples that are slightly out of order between message types.
+*/
+class TimestampExtender {
+public:
+    uint64_t extend(uint32_t timestamp);
+    void reset() { _started = false; }
+
+private:
+    uint64_t _last = 0;
+    bool _started = false;
+};
+}
+
+#endif // XIOAPI_LOG_H
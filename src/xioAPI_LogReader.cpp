@@ -0,0 +1,187 @@
+/******************************************************************
+    @file       xioAPI_LogReader.cpp
+    @brief      Memory-mapped reader of indexed data logger files for host-side analysis
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#ifndef ARDUINO
+
+#include "xioAPI_LogReader.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+// ==================
+// === LOG READER ===
+// ==================
+
+
+/**
+ * @brief Maps a log file and locates its blocks
+ *
+ * @return `false` if the file cannot be mapped or is not an indexed log file
+*/
+bool LogReader::open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= XIOAPI_LOG_FILE_HEADER_SIZE) {
+        data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd); // The mapping keeps the file open
+    if (data == MAP_FAILED) return false;
+    _data = (const uint8_t*) data;
+    _size = st.st_size;
+
+    size_t dataOffset = 0;
+    if (xioAPI_Log::readFileHeader(_data, _size, &_header)) {
+        dataOffset = (size_t) _header.headerBlocks * XIOAPI_LOG_BLOCK_SIZE;
+    }
+    if (dataOffset == 0 || dataOffset > _size) {
+        close();
+        return false;
+    }
+    _blocks = _data + dataOffset;
+
+    // The index and footer are only trusted if they describe this file exactly
+    xioAPI_Log::Footer footer = {0, 0, 0};
+    const uint8_t* end = _data + _size - XIOAPI_LOG_FOOTER_SIZE;
+    if (_size >= dataOffset + XIOAPI_LOG_FOOTER_SIZE) {
+        xioAPI_Log::readFooter(end, &footer, 0); // Locates the index; the checksum is verified below
+        size_t indexSize = (size_t) footer.entryCount * XIOAPI_LOG_INDEX_ENTRY_SIZE;
+        bool located = footer.indexOffset >= dataOffset
+                       && footer.indexOffset == dataOffset + (size_t) footer.blockCount * XIOAPI_LOG_BLOCK_SIZE
+                       && footer.indexOffset + indexSize + XIOAPI_LOG_FOOTER_SIZE == _size;
+        if (located && xioAPI_Log::readFooter(end, &footer, xioAPI_Log::crc32(_data + footer.indexOffset, indexSize))) {
+            _index = _data + footer.indexOffset;
+            _indexCount = footer.entryCount;
+            _blockCount = footer.blockCount;
+            return true;
+        }
+    }
+
+    // Recover a file that was not closed: every whole block up to the first that is not a log block
+    while (dataOffset + (_blockCount + 1) * XIOAPI_LOG_BLOCK_SIZE <= _size && memcmp(getBlock(_blockCount), "XBLK", 4) == 0) {
+        _blockCount++;
+    }
+    return true;
+}
+
+void LogReader::close() {
+    if (_data != nullptr) munmap((void*) _data, _size);
+    _data = nullptr;
+    _size = 0;
+    _blocks = nullptr;
+    _blockCount = 0;
+    _index = nullptr;
+    _indexCount = 0;
+}
+
+/**
+ * @return The settings snapshot from when the file was opened (`FileHeader::settingsSize` bytes),
+ * or `nullptr` if it is missing or corrupt
+*/
+const uint8_t* LogReader::getSettings() const {
+    if (_data == nullptr || _header.settingsSize == 0 || XIOAPI_LOG_FILE_HEADER_SIZE + (size_t) _header.settingsSize > _size) return nullptr;
+    const uint8_t* settings = _data + XIOAPI_LOG_FILE_HEADER_SIZE;
+    return xioAPI_Log::crc32(settings, _header.settingsSize) == _header.settingsCRC ? settings : nullptr;
+}
+
+/**
+ * @brief Reads the header of a block without verifying the block checksum
+ *
+ * @return `false` if the block is not a log block
+*/
+bool LogReader::getBlockHeader(size_t i, xioAPI_Log::BlockHeader* header) const {
+    return i < _blockCount && xioAPI_Log::readBlockHeader(getBlock(i), XIOAPI_LOG_BLOCK_SIZE, header, false);
+}
+
+/**
+ * @return All blocks and timestamps of the file
+*/
+LogRange LogReader::getRange() const {
+    LogRange range = {0, _blockCount, 0, UINT64_MAX};
+    return range;
+}
+
+/**
+ * @brief Finds the blocks that hold the samples from `from` to `to`, inclusive
+*/
+LogRange LogReader::getRange(uint64_t from, uint64_t to) const {
+    LogRange range = {findBlock(from), 0, from, to};
+    size_t end = to == UINT64_MAX ? _blockCount : findBlock(to + 1);
+    xioAPI_Log::BlockHeader header;
+    while (end < _blockCount && getBlockHeader(end, &header) && header.firstTimestamp <= to) { // Samples of other types can overlap the next block
+        end++;
+    }
+    range.endBlock = end < range.firstBlock ? range.firstBlock : end;
+    return range;
+}
+
+/**
+ * @brief Splits a range into disjoint chunks of about the same number of blocks, e.g. one per thread
+ *
+ * @param chunks The output, at least `count` ranges
+ *
+ * @return The number of chunks, which is less than `count` if the range has fewer blocks
+*/
+size_t LogReader::split(const LogRange& range, LogRange* chunks, size_t count) const {
+    size_t blocks = range.endBlock - range.firstBlock;
+    if (count > blocks) count = blocks;
+    for (size_t i=0; i<count; i++) {
+        chunks[i] = range;
+        chunks[i].firstBlock = range.firstBlock + blocks * i / count;
+        chunks[i].endBlock = range.firstBlock + blocks * (i + 1) / count;
+    }
+    return count;
+}
+
+/**
+ * @brief Binary searches the index, then the blocks it points to, for the first block with
+ * samples at or after `timestamp`. Blocks are in time order.
+*/
+size_t LogReader::findBlock(uint64_t timestamp) const {
+    size_t lo = 0;
+    size_t hi = _blockCount;
+
+    if (_indexCount > 0) {
+        size_t first = 0;
+        size_t last = _indexCount;
+        xioAPI_Log::IndexEntry entry;
+        while (first < last) {
+            size_t mid = first + (last - first) / 2;
+            xioAPI_Log::readIndexEntry(_index + mid * XIOAPI_LOG_INDEX_ENTRY_SIZE, &entry);
+            if (entry.lastTimestamp < timestamp) first = mid + 1;
+            else last = mid;
+        }
+        if (first == _indexCount) return _blockCount;
+        xioAPI_Log::readIndexEntry(_index + first * XIOAPI_LOG_INDEX_ENTRY_SIZE, &entry);
+        lo = entry.firstBlock < _blockCount ? entry.firstBlock : _blockCount;
+        hi = lo + entry.blockCount < _blockCount ? lo + entry.blockCount : _blockCount;
+    }
+
+    xioAPI_Log::BlockHeader header;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (getBlockHeader(mid, &header) && header.lastTimestamp < timestamp) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+#endif // ARDUINO
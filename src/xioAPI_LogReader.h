@@ -0,0 +1,191 @@
+/******************************************************************
+    @file       xioAPI_LogReader.h
+    @brief      Memory-mapped reader of indexed data logger files for host-side analysis
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_LOG_READER_H
+#define XIOAPI_LOG_READER_H
+
+#ifndef ARDUINO // Host only - requires mmap
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xioAPI_Types.h"
+#include "xioAPI_Protocol.h"
+#include "xioAPI_Log.h"
+
+
+// =====================
+// === MESSAGE TYPES ===
+// =====================
+
+
+/**
+ * @brief Maps a data message struct to its `DataMessageType` and raw record decoder.
+ * Records are decoded without their checksum, which is covered by the block checksum.
+*/
+template <typename Message> struct LogMessageTraits;
+
+#define XIOAPI_LOG_MESSAGE_TRAITS(Message, messageType, decoder) \
+    template <> struct LogMessageTraits<xioAPI_Protocol::Message> { \
+        static const xioAPI_Types::DataMessageType type = xioAPI_Types::messageType; \
+        static bool decode(const uint8_t* raw, size_t rawLen, xioAPI_Protocol::Message* msg) { return xioAPI_Binary::decoder(raw, rawLen - 1, msg); } \
+    };
+
+XIOAPI_LOG_MESSAGE_TRAITS(InertialMessage, INERTIAL_MESSAGE, decodeInertialMessage)
+XIOAPI_LOG_MESSAGE_TRAITS(MagnetometerMessage, MAGNETOMETER_MESSAGE, decodeMagnetometerMessage)
+XIOAPI_LOG_MESSAGE_TRAITS(QuaternionMessage, QUATERNION_MESSAGE, decodeQuaternionMessage)
+XIOAPI_LOG_MESSAGE_TRAITS(EulerMessage, EULER_MESSAGE, decodeEulerMessage)
+XIOAPI_LOG_MESSAGE_TRAITS(HighGAccelerometerMessage, HIGHG_ACCELEROMETER_MESSAGE, decodeHighGAccelerometerMessage)
+XIOAPI_LOG_MESSAGE_TRAITS(TemperatureMessage, TEMPERATURE_MESSAGE, decodeTemperatureMessage)
+XIOAPI_LOG_MESSAGE_TRAITS(BatteryMessage, BATTERY_MESSAGE, decodeBatteryMessage)
+XIOAPI_LOG_MESSAGE_TRAITS(RSSIMessage, RSSI_MESSAGE, decodeRSSIMessage)
+
+#undef XIOAPI_LOG_MESSAGE_TRAITS
+
+
+// ==================
+// === LOG READER ===
+// ==================
+
+
+/**
+ * @brief A run of log blocks and the timestamps to read from them
+*/
+struct LogRange {
+    size_t firstBlock;
+    size_t endBlock;        // One past the last block
+    uint64_t from;          // µs - the first timestamp to read
+    uint64_t to;            // µs - the last timestamp to read
+};
+
+/**
+ * @brief Maps an indexed or compressed data logger file (`xioAPI_Log.h`) into memory.
+ *
+ * Blocks are read in place from the mapping. The trailing index is used to find timestamps when
+ * the file was closed; a file without a valid index is recovered by scanning its blocks once when
+ * it is opened. Once open, the reader is not modified, so any number of threads can read from it
+ * with their own `LogCursor`, e.g. over the disjoint chunks returned by `split()`.
+*/
+class LogReader {
+public:
+    ~LogReader() { close(); }
+
+    bool open(const char* path);
+    void close();
+
+    bool isOpen() const { return _data != nullptr; }
+    bool isRecovered() const { return _indexCount == 0; } // The file has no valid index
+    const xioAPI_Log::FileHeader& getFileHeader() const { return _header; }
+    const uint8_t* getSettings() const;
+
+    size_t getBlockCount() const { return _blockCount; }
+    const uint8_t* getBlock(size_t i) const { return _blocks + i * XIOAPI_LOG_BLOCK_SIZE; }
+    bool getBlockHeader(size_t i, xioAPI_Log::BlockHeader* header) const;
+
+    LogRange getRange() const;
+    LogRange getRange(uint64_t from, uint64_t to) const;
+    size_t split(const LogRange& range, LogRange* chunks, size_t count) const;
+
+private:
+    size_t findBlock(uint64_t timestamp) const;
+
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+    xioAPI_Log::FileHeader _header;
+    const uint8_t* _blocks = nullptr;
+    size_t _blockCount = 0;
+    const uint8_t* _index = nullptr;
+    size_t _indexCount = 0;
+};
+
+
+// ==================
+// === LOG CURSOR ===
+// ==================
+
+
+/**
+ * @brief Reads the samples of one message type from a range of log blocks, in file order.
+ * Blocks without the message type or outside the timestamp range are skipped without being decoded.
+ *
+ * @tparam Message The message struct, e.g. `InertialMessage`
+*/
+template <typename Message>
+class LogCursor {
+public:
+    LogCursor(const LogReader& reader, const LogRange& range) :
+        _reader(reader), _range(range), _block(range.firstBlock) {}
+
+    /**
+     * @brief Reads the next sample
+     *
+     * @param message The sample. Its `timestamp` holds the lower 32 bits of `timestamp`.
+     * @param timestamp The 64-bit timestamp of the sample (µs)
+     *
+     * @return `false` at the end of the range
+    */
+    bool next(Message* message, uint64_t* timestamp) {
+        while (true) {
+            size_t rawLen;
+            const uint8_t* raw = _open ? _blockReader.next(&rawLen) : nullptr;
+            if (raw == nullptr) {
+                if (!openNextBlock()) return false;
+                continue;
+            }
+            if (xioAPI_Binary::getMessageType(raw[0]) != LogMessageTraits<Message>::type) continue;
+
+            uint64_t t = xioAPI_Log::getRecordTimestamp(raw);
+            if (t < _range.from || t > _range.to) continue;
+
+            if (!LogMessageTraits<Message>::decode(raw, rawLen, message)) continue;
+            *timestamp = t;
+            return true;
+        }
+    }
+
+    /** @return The number of blocks that failed their checksum */
+    size_t getCorruptBlocks() const { return _corruptBlocks; }
+
+private:
+    bool openNextBlock() {
+        const uint16_t mask = 1 << LogMessageTraits<Message>::type;
+        _open = false;
+        while (_block < _range.endBlock) {
+            const uint8_t* block = _reader.getBlock(_block++);
+            xioAPI_Log::BlockHeader header;
+            if (xioAPI_Log::readBlockHeader(block, XIOAPI_LOG_BLOCK_SIZE, &header, false)) { // Checksum only the blocks that are read
+                if (!(header.typeMask & mask) || header.lastTimestamp < _range.from || header.firstTimestamp > _range.to) continue;
+            }
+            if (!_blockReader.begin(block, XIOAPI_LOG_BLOCK_SIZE)) {
+                _corruptBlocks++;
+                continue;
+            }
+            _open = true;
+            return true;
+        }
+        return false;
+    }
+
+    const LogReader& _reader;
+    LogRange _range;
+    size_t _block;
+    bool _open = false;
+    size_t _corruptBlocks = 0;
+    xioAPI_Log::BlockReader _blockReader;
+};
+
+#endif // ARDUINO
+
+#endif // XIOAPI_LOG_READER_H
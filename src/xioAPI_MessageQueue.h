@@ -0,0 +1,93 @@
+/******************************************************************
+    @file       xioAPI_MessageQueue.h
+    @brief      Bounded lock-free multi-producer/single-consumer queue
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_MESSAGE_QUEUE_H
+#define XIOAPI_MESSAGE_QUEUE_H
+
+#if defined(__AVR__)
+#error "MPSCQueue requires <atomic>, which is not available on AVR"
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * @brief A bounded FIFO queue of fixed-size records that many producers and one consumer can use without locks.
+ *
+ * Every slot carries a sequence number. A producer claims the next slot by advancing the shared
+ * enqueue position with a compare-and-swap, copies its record in and then publishes the slot by
+ * storing the next sequence number with release ordering. The consumer acquires the sequence number
+ * before reading the record and hands the slot back to the producers one lap later.
+ * A full queue is reported to the producer instead of waiting for space.
+ *
+ *  - Producers (any task): `push()`
+ *  - Consumer (one task): `pop()`
+ *
+ * @note A producer that is pre-empted between claiming and publishing a slot delays the consumer
+ * at that slot until it resumes; no other producer is blocked.
+ *
+ * @tparam T The record type. Copied with assignment.
+ * @tparam S The number of slots, a power of two.
+ */
+template<typename T, size_t S> class MPSCQueue {
+	static_assert(S >= 2 && (S & (S - 1)) == 0, "MPSCQueue size must be a power of two");
+
+public:
+	static constexpr size_t capacity = S;
+
+	MPSCQueue();
+
+	/** @private */
+	MPSCQueue(const MPSCQueue&) = delete;
+	/** @private */
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+	/**
+	 * @brief Adds a record to the end of the queue. Safe to call from any number of tasks.
+	 *
+	 * @return `false` iff the queue was full and the record was not added.
+	 */
+	bool push(const T& value);
+
+	/**
+	 * @brief Removes the record at the beginning of the queue. Consumer only.
+	 *
+	 * @return `false` iff the queue was empty or the next record has not been published yet.
+	 */
+	bool pop(T& value);
+
+	/**
+	 * @brief Returns the number of claimed slots. A snapshot that may be stale.
+	 */
+	size_t size() const;
+	bool isEmpty() const { return size() == 0; }
+
+private:
+	static constexpr size_t mask = S - 1;
+
+	struct Cell {
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	Cell cells[S];
+	std::atomic<size_t> enqueuePos;	// Next slot to claim, shared by the producers
+	std::atomic<size_t> dequeuePos;	// Next slot to read, only written by the consumer
+};
+
+#include "xioAPI_MessageQueue.tpp"
+#endif // XIOAPI_MESSAGE_QUEUE_H
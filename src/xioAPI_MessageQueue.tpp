@@ -0,0 +1,65 @@
+/******************************************************************
+    @file       xioAPI_MessageQueue.tpp
+    @brief      Bounded lock-free multi-producer/single-consumer queue
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+template<typename T, size_t S>
+MPSCQueue<T,S>::MPSCQueue() :
+		enqueuePos(0), dequeuePos(0) {
+	for (size_t i = 0; i < S; i++) {
+		cells[i].sequence.store(i, std::memory_order_relaxed);	// Slot i is free for the producer at position i
+	}
+}
+
+template<typename T, size_t S>
+bool MPSCQueue<T,S>::push(const T& value) {
+	size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	Cell* cell;
+	for (;;) {
+		cell = &cells[pos & mask];
+		size_t seq = cell->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+		if (diff == 0) {											// The slot is free for this lap, try to claim it
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+		}
+		else if (diff < 0) {										// The slot has not been read since the last lap
+			return false;
+		}
+		else {														// Another producer claimed the slot first
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->value = value;
+	cell->sequence.store(pos + 1, std::memory_order_release);	// Publish the record to the consumer
+	return true;
+}
+
+template<typename T, size_t S>
+bool MPSCQueue<T,S>::pop(T& value) {
+	size_t pos = dequeuePos.load(std::memory_order_relaxed);
+	Cell* cell = &cells[pos & mask];
+	if (cell->sequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+	value = cell->value;
+	cell->sequence.store(pos + S, std::memory_order_release);	// Return the slot to the producers for the next lap
+	dequeuePos.store(pos + 1, std::memory_order_relaxed);
+	return true;
+}
+
+template<typename T, size_t S>
+size_t MPSCQueue<T,S>::size() const {
+	size_t head = dequeuePos.load(std::memory_order_relaxed);	// Read first so the tail is never behind it
+	size_t tail = enqueuePos.load(std::memory_order_relaxed);
+	return tail - head < S ? tail - head : S;
+}
@@ -22,6 +22,9 @@
 #ifndef xioAPI_Protocol_h
 #define xioAPI_Protocol_h
 
+#include <stdint.h>
+#include <stddef.h>
+
 //  Based on API v1.1 - https://x-io.co.uk/downloads/x-IMU3-User-Manual-v1.1.pdf
 
 #define xioAPI_VERSION_MAJOR     1
@@ -30,122 +33,183 @@
 
 namespace xioAPI_Protocol {
 
+/**
+ * @brief Hashes an API key with the DJB2 hash function, in 32 bits so that the result is the same on
+ * every architecture. Usable in constant expressions, e.g. `XIOAPI_KEY_HASH("deviceName")`.
+*/
+constexpr uint32_t hashKey(const char* key, uint32_t hash=5381) {
+    return *key == '\0' ? hash : hashKey(key + 1, (hash << 5) + hash + (uint8_t) *key);
+}
+
+template <uint32_t Hash>
+struct KeyHash { static constexpr uint32_t value = Hash; };
+
+// The hash of a constant key, always computed by the compiler
+#define XIOAPI_KEY_HASH(key) (xioAPI_Protocol::KeyHash<xioAPI_Protocol::hashKey(key)>::value)
+
+/**
+ * Keys of the API messages.
+ * Consult the x-IMU3 user manual for specifics on each setting type
+*/
+#define XIOAPI_SETTING_KEYS(KEY) \
+    KEY(CALIBRATION_DATE,                            "calibrationDate") \
+    KEY(GYROSCOPE_MISALIGNMENT,                      "gyroscopeMisalignment") \
+    KEY(GYROSCOPE_SENSITIVITY,                       "gyroscopeSensitivity") \
+    KEY(GYROSCOPE_OFFSET,                            "gyroscopeOffset") \
+    KEY(ACCELEROMETER_MISALIGNMENT,                  "accelerometerMisalignment") \
+    KEY(ACCELEROMETER_SENSITIVITY,                   "accelerometerSensitivity") \
+    KEY(ACCELEROMETER_OFFSET,                        "accelerometerOffset") \
+    KEY(SOFT_IRON_MATRIX,                            "softIronMatrix") \
+    KEY(HARD_IRON_OFFSET,                            "hardIronOffset") \
+    KEY(HIGHG_ACCELEROMETER_MISALIGNMENT,            "highGAccelerometerMisalignment") \
+    KEY(HIGHG_ACCELEROMETER_SENSITIVITY,             "highGAccelerometerSensitivity") \
+    KEY(HIGHG_ACCELEROMETER_OFFSET,                  "highGAccelerometerOffset") \
+    KEY(DEVICE_NAME,                                 "deviceName") \
+    KEY(SERIAL_NUMBER,                               "serialNumber") \
+    KEY(FIRMWARE_VERSION,                            "firmwareVersion") \
+    KEY(BOOTLOADER_VERSION,                          "bootloaderVersion") \
+    KEY(HARDWARE_VERSION,                            "hardwareVersion") \
+    KEY(SERIAL_MODE,                                 "serialMode") \
+    KEY(SERIAL_BAUD_RATE,                            "serialBaudRate") \
+    KEY(SERIAL_RTS_CTS_ENABLED,                      "serialRtsCtsEnabled") \
+    KEY(SERIAL_ACCESSORY_NUMBER_OF_BYTES,            "serialAccessoryNumberOfBytes") \
+    KEY(SERIAL_ACCESSORY_TERMINATION_BYTE,           "serialAccessoryTerminationByte") \
+    KEY(SERIAL_ACCESSORY_TIMEOUT,                    "serialAccessoryTimeout") \
+    KEY(WIRELESS_MODE,                               "wirelessMode") \
+    KEY(WIRELESS_FIRMWARE_VERSION,                   "wirelessFirmwareVersion") \
+    KEY(EXTERNAL_ANTENNAE_ENABLED,                   "externalAntennaeEnabled") \
+    KEY(WIFI_REGION,                                 "wiFiRegion") \
+    KEY(WIFI_MAC_ADDRESS,                            "wiFiMacAddress") \
+    KEY(WIFI_IP_ADDRESS,                             "wiFiIPAddress") \
+    KEY(WIFI_CLIENT_SSID,                            "wiFiClientSsid") \
+    KEY(WIFI_CLIENT_KEY,                             "wiFiClientKey") \
+    KEY(WIFI_CLIENT_CHANNEL,                         "wiFiClientChannel") \
+    KEY(WIFI_CLIENT_DHCP_ENABLED,                    "wiFiClientDhcpEnabled") \
+    KEY(WIFI_CLIENT_IP_ADDRESS,                      "wiFiClientIPAddress") \
+    KEY(WIFI_CLIENT_NETMASK,                         "wiFiClientNetmask") \
+    KEY(WIFI_CLIENT_GATEWAY,                         "wiFiClientGateway") \
+    KEY(WIFI_AP_SSID,                                "wiFiAPSsid") \
+    KEY(WIFI_AP_KEY,                                 "wiFiAPKey") \
+    KEY(WIFI_AP_CHANNEL,                             "wiFiAPChannel") \
+    KEY(TCP_PORT,                                    "tcpPort") \
+    KEY(UDP_IP_ADDRESS,                              "udpIPAddress") \
+    KEY(UDP_SEND_PORT,                               "udpSendPort") \
+    KEY(UDP_RECEIVE_PORT,                            "udpReceivePort") \
+    KEY(SYNCHRONISATION_ENABLED,                     "synchronisationEnabled") \
+    KEY(SYNCHRONISATION_NETWORK_LATENCY,             "synchronisationNetworkLatency") \
+    KEY(BLUETOOTH_ADDRESS,                           "bluetoothAddress") \
+    KEY(BLUETOOTH_NAME,                              "bluetoothName") \
+    KEY(BLUETOOTH_PIN_CODE,                          "bluetoothPinCode") \
+    KEY(BLUETOOTH_DISCOVERY_MODE,                    "bluetoothDiscoveryMode") \
+    KEY(BLUETOOTH_PAIRED_ADDRESS,                    "bluetoothPairedAddress") \
+    KEY(BLUETOOTH_PAIRED_LINK_KEY,                   "bluetoothPairedLinkKey") \
+    KEY(DATA_LOGGER_ENABLED,                         "dataLoggerEnabled") \
+    KEY(DATA_LOGGER_FILE_NAME_PREFIX,                "dataLoggerFileNamePrefix") \
+    KEY(DATA_LOGGER_FILE_NAME_TIME_ENABLED,          "dataLoggerFileNameTimeEnabled") \
+    KEY(DATA_LOGGER_FILE_NAME_COUNTER_ENABLED,       "dataLoggerFileNameCounterEnabled") \
+    KEY(DATA_LOGGER_MAX_FILE_SIZE,                   "dataLoggerMaxFileSize") \
+    KEY(DATA_LOGGER_MAX_FILE_PERIOD,                 "dataLoggerMaxFilePeriod") \
+    KEY(AXES_ALIGNMENT,                              "axesAlignment") \
+    KEY(GYROSCOPE_OFFSET_CORRECTION_ENABLED,         "gyroscopeOffsetCorrectionEnabled") \
+    KEY(AHRS_AXES_CONVENTION,                        "ahrsAxesConvention") \
+    KEY(AHRS_GAIN,                                   "ahrsGain") \
+    KEY(AHRS_IGNORE_MAGNETOMETER,                    "ahrsIgnoreMagnetometer") \
+    KEY(AHRS_ACCELERATION_REJECTION_ENABLED,         "ahrsAccelerationRejectionEnabled") \
+    KEY(AHRS_MAGNETIC_REJECTION_ENABLED,             "ahrsMagneticRejectionEnabled") \
+    KEY(BINARY_MODE_ENABLED,                         "binaryModeEnabled") \
+    KEY(USB_DATA_MESSAGES_ENABLED,                   "usbDataMessagesEnabled") \
+    KEY(SERIAL_DATA_MESSAGES_ENABLED,                "serialDataMessagesEnabled") \
+    KEY(TCP_DATA_MESSAGES_ENABLED,                   "tcpDataMessagesEnabled") \
+    KEY(UDP_DATA_MESSAGES_ENABLED,                   "udpDataMessagesEnabled") \
+    KEY(BLUETOOTH_DATA_MESSAGES_ENABLED,             "bluetoothDataMessagesEnabled") \
+    KEY(DATA_LOGGER_DATA_MESSAGES_ENABLED,           "dataLoggerDataMessagesEnabled") \
+    KEY(AHRS_MESSAGE_TYPE,                           "ahrsMessageType") \
+    KEY(INERTIAL_MESSAGE_RATE_DIVISOR,               "inertialMessageRateDivisor") \
+    KEY(MAGNETOMETER_MESSAGE_RATE_DIVISOR,           "magnetometerMessageRateDivisor") \
+    KEY(AHRS_MESSAGE_RATE_DIVISOR,                   "ahrsMessageRateDivisor") \
+    KEY(HIGHG_ACCELEROMETER_MESSAGE_RATE_DIVISOR,    "highGAccelerometerMessageRateDivisor") \
+    KEY(TEMPERATURE_MESSAGE_RATE_DIVISOR,            "temperatureMessageRateDivisor") \
+    KEY(BATTERY_MESSAGE_RATE_DIVISOR,                "batteryMessageRateDivisor") \
+    KEY(RSSI_MESSAGE_RATE_DIVISOR,                   "rssiMessageRateDivisor") \
+    KEY(INERTIAL_DECIMATION_FILTER_ORDER,            "inertialDecimationFilterOrder") \
+    KEY(MAGNETOMETER_DECIMATION_FILTER_ORDER,        "magnetometerDecimationFilterOrder") \
+    KEY(HIGHG_ACCELEROMETER_DECIMATION_FILTER_ORDER, "highGAccelerometerDecimationFilterOrder")
+
+#define XIOAPI_COMMAND_KEYS(KEY) \
+    KEY(XIO_DEFAULT,                                 "default") \
+    KEY(APPLY,                                       "apply") \
+    KEY(SAVE,                                        "save") \
+    KEY(TIME,                                        "time") \
+    KEY(PING,                                        "ping") \
+    KEY(RESET,                                       "reset") \
+    KEY(SHUTDOWN,                                    "shutdown") \
+    KEY(STROBE,                                      "strobe") \
+    KEY(COLOUR,                                      "colour") \
+    KEY(HEADING,                                     "heading") \
+    KEY(ACCESSORY,                                   "accessory") \
+    KEY(NOTE,                                        "note") \
+    KEY(FORMAT,                                      "format") \
+    KEY(TEST,                                        "test") \
+    KEY(BOOTLOADER,                                  "bootloader") \
+    KEY(FACTORY,                                     "factory") \
+    KEY(ERASE,                                       "erase") \
+    KEY(READ_ALL,                                    "readAll") \
+    KEY(READ_JSON,                                   "readJson")
+
 /**
  * Hash table for the keys in API messages
  * This makes evaluating the keys received from the API requests much easier.
- * Consult the x-IMU3 user manual for specifics on each setting type
  * 
- * (Hashed using the DJB2 hash function)
+ * (Hashed using the DJB2 hash function at compile time)
 */
-enum APIKeyHashASCII {
-    // ----------------
-    // --- SETTINGS ---
-    // ----------------
-
-    CALIBRATION_DATE                            = 0x69AE1A4B,
-    GYROSCOPE_MISALIGNMENT                      = 0xC6E2FB88,
-    GYROSCOPE_SENSITIVITY                       = 0x1B3D340B,
-    GYROSCOPE_OFFSET                            = 0x54042907,
-    ACCELEROMETER_MISALIGNMENT                  = 0x05F233A8,
-    ACCELEROMETER_SENSITIVITY                   = 0x5B35E82B,
-    ACCELEROMETER_OFFSET                        = 0x1E93C927,
-    SOFT_IRON_MATRIX                            = 0x48A77FAE,
-    HARD_IRON_OFFSET                            = 0x604CAF63,
-    HIGHG_ACCELEROMETER_MISALIGNMENT            = 0xA3C1348F,
-    HIGHG_ACCELEROMETER_SENSITIVITY             = 0xFB24E832,
-    HIGHG_ACCELEROMETER_OFFSET                  = 0x0749E8CE,
-    DEVICE_NAME                                 = 0x26210236,
-    SERIAL_NUMBER                               = 0x4440862E,
-    FIRMWARE_VERSION                            = 0x905952C8,
-    BOOTLOADER_VERSION                          = 0x6B037A96,
-    HARDWARE_VERSION                            = 0x445818D9,
-    SERIAL_MODE                                 = 0xAD8C37EA,
-    SERIAL_BAUD_RATE                            = 0x529AE1ED,
-    SERIAL_RTS_CTS_ENABLED                      = 0x1B98A393,
-    SERIAL_ACCESSORY_NUMBER_OF_BYTES            = 0x2288AC96,
-    SERIAL_ACCESSORY_TERMINATION_BYTE           = 0x724D8BCF,
-    SERIAL_ACCESSORY_TIMEOUT                    = 0x526AD0D8,
-    WIRELESS_MODE                               = 0xADA4E258,
-    WIRELESS_FIRMWARE_VERSION                   = 0x7B099616,
-    EXTERNAL_ANTENNAE_ENABLED                   = 0x6ABC8B5D,
-    WIFI_REGION                                 = 0xD0E9C698,
-    WIFI_MAC_ADDRESS                            = 0x6EB6736B,
-    WIFI_IP_ADDRESS                             = 0x0DD70133,
-    WIFI_CLIENT_SSID                            = 0xBCC58466,
-    WIFI_CLIENT_KEY                             = 0x3443E7FC,
-    WIFI_CLIENT_CHANNEL                         = 0xA16900CC,
-    WIFI_CLIENT_DHCP_ENABLED                    = 0x438902FD,
-    WIFI_CLIENT_IP_ADDRESS                      = 0x7D2203B2,
-    WIFI_CLIENT_NETMASK                         = 0xEA8132E6,
-    WIFI_CLIENT_GATEWAY                         = 0xC650DF65,
-    WIFI_AP_SSID                                = 0xA7BB4378,
-    WIFI_AP_KEY                                 = 0x05150CCE,
-    WIFI_AP_CHANNEL                             = 0x0D043E9E,
-    TCP_PORT                                    = 0xD42A5931,
-    UDP_IP_ADDRESS                              = 0x1CE09BAD,
-    UDP_SEND_PORT                               = 0x69438A3D,
-    UDP_RECEIVE_PORT                            = 0xCB83F816,
-    SYNCHRONISATION_ENABLED                     = 0x35988A1B,
-    SYNCHRONISATION_NETWORK_LATENCY             = 0x71194A2A,
-    BLUETOOTH_ADDRESS                           = 0xB26E05C1,
-    BLUETOOTH_NAME                              = 0xB11E1DDC,
-    BLUETOOTH_PIN_CODE                          = 0x415CB7FD,
-    BLUETOOTH_DISCOVERY_MODE                    = 0xDE0C0138,
-    BLUETOOTH_PAIRED_ADDRESS                    = 0xF726EDB6,
-    BLUETOOTH_PAIRED_LINK_KEY                   = 0x52420327,
-    DATA_LOGGER_ENABLED                         = 0xE7FE4A2A,
-    DATA_LOGGER_FILE_NAME_PREFIX                = 0x8644900E,
-    DATA_LOGGER_FILE_NAME_TIME_ENABLED          = 0xDD8AF43A,
-    DATA_LOGGER_FILE_NAME_COUNTER_ENABLED       = 0xB6038E0B,
-    DATA_LOGGER_MAX_FILE_SIZE                   = 0xB50949E0,
-    DATA_LOGGER_MAX_FILE_PERIOD                 = 0x153722A8,
-    AXES_ALIGNMENT                              = 0xAAAD3615,
-    GYROSCOPE_OFFSET_CORRECTION_ENABLED         = 0x5F5F04EA,
-    AHRS_AXES_CONVENTION                        = 0x02CF05E7,
-    AHRS_GAIN                                   = 0x588354D2,
-    AHRS_IGNORE_MAGNETOMETER                    = 0xD45325FF,
-    AHRS_ACCELERATION_REJECTION_ENABLED         = 0x564448AB,
-    AHRS_MAGNETIC_REJECTION_ENABLED             = 0x59D809E9,
-    BINARY_MODE_ENABLED                         = 0x22FA119A,
-    USB_DATA_MESSAGES_ENABLED                   = 0xCAE8216C,
-    SERIAL_DATA_MESSAGES_ENABLED                = 0x3FA9FCA2,
-    TCP_DATA_MESSAGES_ENABLED                   = 0x7190B809,
-    UDP_DATA_MESSAGES_ENABLED                   = 0x3549FD2B,
-    BLUETOOTH_DATA_MESSAGES_ENABLED             = 0x96ED95D8,
-    DATA_LOGGER_DATA_MESSAGES_ENABLED           = 0x49B88A9C,
-    AHRS_MESSAGE_TYPE                           = 0x2BE1B53A,
-    INERTIAL_MESSAGE_RATE_DIVISOR               = 0x4F84ED4E,
-    MAGNETOMETER_MESSAGE_RATE_DIVISOR           = 0x271938DE,
-    AHRS_MESSAGE_RATE_DIVISOR                   = 0xCD61B2E4,
-    HIGHG_ACCELEROMETER_MESSAGE_RATE_DIVISOR    = 0x74C3AB38,
-    TEMPERATURE_MESSAGE_RATE_DIVISOR            = 0x632401C4,
-    BATTERY_MESSAGE_RATE_DIVISOR                = 0xF781B9D1,
-    RSSI_MESSAGE_RATE_DIVISOR                   = 0xCA009AF7,
-
-    // ----------------
-    // --- COMMANDS ---
-    // ----------------
-
-    XIO_DEFAULT = 0x0885548A,
-    APPLY       = 0x0F199E4B,
-    SAVE        = 0x7C9DCB54,
-    TIME        = 0x7C9E7894,
-    PING        = 0x7C9C4733,
-    RESET       = 0x10474288,
-    SHUTDOWN    = 0xFC460361,
-    STROBE      = 0x1C93C7F4,
-    COLOUR      = 0xF6E37B99,
-    HEADING     = 0x3C153F55,
-    ACCESSORY   = 0x2B792E11,
-    NOTE        = 0x7C9B48BB,
-    FORMAT      = 0xFDE634AE,
-    TEST        = 0x7C9E6865,
-    BOOTLOADER  = 0x9999EDD0,
-    FACTORY     = 0x98F9347D,
-    ERASE       = 0x0F62DA15,
-    READ_ALL    = 0x3DDAF47A,
-    READ_JSON   = 0xF93E91BB
+#define XIOAPI_KEY_ENUM(name, key) name = hashKey(key),
+enum APIKeyHashASCII : uint32_t {
+    XIOAPI_SETTING_KEYS(XIOAPI_KEY_ENUM)
+    XIOAPI_COMMAND_KEYS(XIOAPI_KEY_ENUM)
 };
+#undef XIOAPI_KEY_ENUM
+
+/**
+ * Perfect hash of the API keys. Every `APIKeyHashASCII` value maps to its own slot of a table of
+ * `XIOAPI_KEY_SLOTS` entries, so a key is found, or known to be absent, with a single probe.
+ * The multiplier was found by searching odd 32-bit constants. If a new key collides, the static_assert
+ * below fails and a new multiplier must be found.
+*/
+#define XIOAPI_KEY_SLOT_BITS        9
+#define XIOAPI_KEY_SLOTS            (1 << XIOAPI_KEY_SLOT_BITS)
+#define XIOAPI_KEY_HASH_MULTIPLIER  0xE25129CDu
+
+constexpr uint32_t getKeySlot(uint32_t hash) {
+    return (uint32_t) (hash * XIOAPI_KEY_HASH_MULTIPLIER) >> (32 - XIOAPI_KEY_SLOT_BITS);
+}
+
+#define XIOAPI_KEY_LIST(name, key) name,
+constexpr APIKeyHashASCII API_KEYS[] = {
+    XIOAPI_SETTING_KEYS(XIOAPI_KEY_LIST)
+    XIOAPI_COMMAND_KEYS(XIOAPI_KEY_LIST)
+};
+#undef XIOAPI_KEY_LIST
+
+constexpr size_t NUM_API_KEYS = sizeof(API_KEYS) / sizeof(API_KEYS[0]);
+
+constexpr bool isKeySlotUnique(size_t key, size_t other=0) {
+    return other == key || (getKeySlot(API_KEYS[other]) != getKeySlot(API_KEYS[key]) && isKeySlotUnique(key, other + 1));
+}
+
+constexpr bool areKeySlotsUnique(size_t key=0) {
+    return key == NUM_API_KEYS || (isKeySlotUnique(key) && areKeySlotsUnique(key + 1));
+}
+
+constexpr bool isKeyHashUnique(size_t key, size_t other=0) {
+    return other == key || (API_KEYS[other] != API_KEYS[key] && isKeyHashUnique(key, other + 1));
+}
+
+constexpr bool areKeyHashesUnique(size_t key=0) {
+    return key == NUM_API_KEYS || (isKeyHashUnique(key) && areKeyHashesUnique(key + 1));
+}
+
+static_assert(areKeyHashesUnique(), "Two API keys have the same hash - rename one of them");
+static_assert(areKeySlotsUnique(), "Two API keys share a slot - choose a new XIOAPI_KEY_HASH_MULTIPLIER");
 
 /******************************************************************
  *
@@ -195,6 +259,11 @@ struct MagnetometerMessage {
     uint32_t  timestamp;
 };
 
+struct HighGAccelerometerMessage {
+    float ax, ay, az;     // High-g acceleration in g
+    uint32_t timestamp;   // System timestamp in microseconds
+};
+
 struct TemperatureMessage {
     float temp;           // IMU temperature in degrees Celsius 
     uint32_t  timestamp;  // System timestamp in microseconds
@@ -213,6 +282,24 @@ struct RSSIMessage {
     uint32_t timestamp;
 };
 
+/**
+ * @brief A data message sample tagged with its type, copied as-is by the data message senders
+ * and formatted later by the transmit task
+*/
+struct DataMessageRecord {
+    xioAPI_Types::DataMessageType type;
+    union {
+        InertialMessage inertial;
+        MagnetometerMessage magnetometer;
+        QuaternionMessage quaternion;
+        EulerMessage euler;
+        HighGAccelerometerMessage highG;
+        TemperatureMessage temperature;
+        BatteryMessage battery;
+        RSSIMessage rssi;
+    };
+};
+
 struct BatteryData {
     float percentCharged; 
     float voltage;
@@ -0,0 +1,275 @@
+/******************************************************************
+    @file       xioAPI_Replay.cpp
+    @brief      Paced replay of recorded data logger files
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "xioAPI_Replay.h"
+#include <string.h>
+
+#ifndef ARDUINO
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // ARDUINO
+
+
+// ==============
+// === SOURCE ===
+// ==============
+
+
+#ifdef ARDUINO
+bool FSReplaySource::open(const char* path) {
+    close();
+    _logFile = _fs.open(path, "r");
+    return (bool) _logFile;
+}
+
+size_t FSReplaySource::read(uint8_t* data, size_t size) {
+    return _logFile.read(data, size);
+}
+
+void FSReplaySource::close() {
+    if (_logFile) _logFile.close();
+}
+#else
+bool POSIXReplaySource::open(const char* path) {
+    close();
+    _fd = ::open(path, O_RDONLY);
+    return _fd >= 0;
+}
+
+size_t POSIXReplaySource::read(uint8_t* data, size_t size) {
+    while (_fd >= 0) {
+        ssize_t n = ::read(_fd, data, size);
+        if (n >= 0) return n;
+        if (errno != EINTR) break;
+    }
+    return 0;
+}
+
+void POSIXReplaySource::close() {
+    if (_fd < 0) return;
+    ::close(_fd);
+    _fd = -1;
+}
+#endif // ARDUINO
+
+
+// ==============
+// === REPLAY ===
+// ==============
+
+
+/**
+ * @brief Starts replaying a log file from its beginning
+ *
+ * @param source The open log file. It is closed when the replay ends.
+ * @param speed The replay speed: 1 for real time, N for N times real time, or
+ *              `XIOAPI_REPLAY_SPEED_MAX` for as fast as possible
+ *
+ * @return `false` if there is no source
+*/
+bool LogReplay::begin(ReplaySource* source, float speed) {
+    stop();
+    if (source == nullptr) return false;
+
+    _source = source;
+    _speed = speed > 0 ? speed : XIOAPI_REPLAY_SPEED_MAX;
+    _start = 0;
+    _end = 0;
+    _fetched = false;
+    _started = false;
+    _clock = 0;
+    _timestamps.reset();
+    _block.begin(nullptr, 0);
+    memset(&_stats, 0, sizeof(_stats));
+
+    // Indexed logs start with a file header; anything else is read as a text log
+    _end = fill(_buffer, XIOAPI_LOG_FILE_HEADER_SIZE);
+    xioAPI_Log::FileHeader header;
+    _indexed = xioAPI_Log::readFileHeader(_buffer, _end, &header);
+    if (_indexed) {
+        size_t skip = (size_t) header.headerBlocks * XIOAPI_LOG_BLOCK_SIZE - XIOAPI_LOG_FILE_HEADER_SIZE;
+        while (skip > 0) {
+            size_t n = fill(_buffer, skip < sizeof(_buffer) ? skip : sizeof(_buffer));
+            if (n == 0) break;
+            skip -= n;
+        }
+        _end = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the next message once it is due. Call this regularly with the current time.
+ * The replay stops by itself at the end of the log file.
+ *
+ * @param now The current time in microseconds (e.g. `micros()`)
+ * @param message The message. Text log data is valid until the next call.
+ *
+ * @return `true` if a message is due
+*/
+bool LogReplay::next(uint32_t now, ReplayMessage* message) {
+    if (_source == nullptr) return false;
+    if (!_fetched) {
+        if (!fetch()) {
+            stop();
+            return false;
+        }
+        _fetched = true;
+    }
+
+    if (!_started) {
+        _started = true;
+        _firstTimestamp = _message.timestamp;
+        _lastNow = now;
+    }
+    _clock += (uint32_t) (now - _lastNow);
+    _lastNow = now;
+
+    if (_speed > 0) {
+        uint64_t offset = _message.timestamp > _firstTimestamp ? _message.timestamp - _firstTimestamp : 0;
+        uint64_t due = (uint64_t) (offset / (double) _speed);
+        if (due > _clock) return false;
+        if (_clock - due > _stats.lag) _stats.lag = _clock - due;
+    }
+
+    *message = _message;
+    _fetched = false;
+    _stats.messages++;
+    _stats.bytes += _message.size;
+    _stats.elapsed = _clock;
+    return true;
+}
+
+/**
+ * @brief Ends the replay and closes the log file. The statistics are kept until the next replay.
+*/
+void LogReplay::stop() {
+    if (_source == nullptr) return;
+    _source->close();
+    _source = nullptr;
+}
+
+/**
+ * @return The messages replayed per second since the first message
+*/
+float LogReplay::getMessageRate() const {
+    if (_stats.elapsed == 0) return 0;
+    return _stats.messages * 1e6f / _stats.elapsed;
+}
+
+/**
+ * @brief Reads the next message of the log file into `_message`
+ *
+ * @return `false` at the end of the file
+*/
+bool LogReplay::fetch() {
+    return _indexed ? fetchRecord() : fetchLine();
+}
+
+/**
+ * @brief Reads the next ASCII message or binary frame of a text log
+*/
+bool LogReplay::fetchLine() {
+    while (true) {
+        const uint8_t* lf = (const uint8_t*) memchr(_buffer + _start, '\n', _end - _start);
+        if (lf == nullptr) {
+            if (_start == 0 && _end == sizeof(_buffer)) { // No message is this long
+                _stats.errors++;
+                _end = 0;
+            }
+            memmove(_buffer, _buffer + _start, _end - _start);
+            _end -= _start;
+            _start = 0;
+
+            size_t n = _source->read(_buffer + _end, sizeof(_buffer) - _end);
+            if (n == 0) return false; // A partial last line is not replayed
+            _end += n;
+            continue;
+        }
+
+        const uint8_t* line = _buffer + _start;
+        size_t len = lf - line + 1;
+        _start += len;
+
+        uint32_t timestamp = 0;
+        bool valid = false;
+        if (line[0] & 0x80) { // Binary frame
+            uint8_t raw[XIOAPI_BINARY_MAX_RAW_SIZE];
+            if (xioAPI_Binary::decodeFrame(line, len, raw, sizeof(raw)) > XIOAPI_BINARY_HEADER_SIZE) {
+                timestamp = (uint32_t) raw[1] | (uint32_t) raw[2] << 8 | (uint32_t) raw[3] << 16 | (uint32_t) raw[4] << 24;
+                valid = true;
+            }
+        }
+        else if (len > 2 && line[1] == ',') { // ASCII message: "X,timestamp,..."
+            for (size_t i=2; i<len && line[i] >= '0' && line[i] <= '9'; i++) {
+                timestamp = timestamp * 10 + (line[i] - '0');
+                valid = true;
+            }
+        }
+        if (!valid) {
+            _stats.errors++;
+            continue;
+        }
+
+        _message.data = line;
+        _message.size = len;
+        _message.timestamp = _timestamps.extend(timestamp);
+        return true;
+    }
+}
+
+/**
+ * @brief Reads the next sample of an indexed log, one block at a time
+*/
+bool LogReplay::fetchRecord() {
+    while (true) {
+        size_t rawLen;
+        const uint8_t* raw = _block.next(&rawLen);
+        if (raw != nullptr) {
+            if (!xioAPI_Binary::decodeRawRecord(raw, rawLen, &_message.record)) {
+                _stats.errors++;
+                continue;
+            }
+            _message.data = nullptr;
+            _message.size = 0;
+            _message.timestamp = xioAPI_Log::getRecordTimestamp(raw);
+            return true;
+        }
+        if (_block.isCorrupt()) _stats.errors++;
+
+        size_t n = fill(_buffer, XIOAPI_LOG_BLOCK_SIZE);
+        if (n < XIOAPI_LOG_BLOCK_SIZE) return false; // The end of the file, or a block cut short by power loss
+        if (!_block.begin(_buffer, n)) {
+            if (memcmp(_buffer, "XBLK", 4) != 0) return false; // The index follows the last block
+            _stats.errors++; // A damaged block
+        }
+    }
+}
+
+/**
+ * @brief Reads until `size` bytes have been read or the file ends
+ *
+ * @return The number of bytes read
+*/
+size_t LogReplay::fill(uint8_t* data, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        size_t n = _source->read(data + total, size - total);
+        if (n == 0) break;
+        total += n;
+    }
+    return total;
+}
@@ -0,0 +1,152 @@
+/******************************************************************
+    @file       xioAPI_Replay.h
+    @brief      Paced replay of recorded data logger files
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_REPLAY_H
+#define XIOAPI_REPLAY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xioAPI_Types.h"
+#include "xioAPI_Protocol.h"
+#include "xioAPI_Log.h"
+
+#ifdef ARDUINO
+#include <FS.h>
+#endif // ARDUINO
+
+#define XIOAPI_REPLAY_BUFFER_SIZE   XIOAPI_LOG_BLOCK_SIZE // Bytes - one indexed log block, or a run of text log lines
+#define XIOAPI_REPLAY_SPEED_MAX     0.0f // Replay as fast as possible
+
+
+// ==============
+// === SOURCE ===
+// ==============
+
+
+/**
+ * @brief A recorded log file that is read from start to end
+*/
+class ReplaySource {
+public:
+    virtual ~ReplaySource() {}
+
+    /** @return The number of bytes read, which is 0 at the end of the file or on error */
+    virtual size_t read(uint8_t* data, size_t size) = 0;
+
+    virtual void close() = 0;
+};
+
+#ifdef ARDUINO
+/**
+ * @brief Reads a log file from an Arduino file system such as `SPIFFS` or `SD`
+*/
+class FSReplaySource : public ReplaySource {
+public:
+    FSReplaySource(fs::FS& fs) : _fs(fs) {}
+
+    bool open(const char* path);
+    size_t read(uint8_t* data, size_t size) override;
+    void close() override;
+
+private:
+    fs::FS& _fs;
+    fs::File _logFile;
+};
+#else
+/**
+ * @brief Reads a log file using POSIX file I/O, for replaying logs on a host
+*/
+class POSIXReplaySource : public ReplaySource {
+public:
+    ~POSIXReplaySource() override { close(); }
+
+    bool open(const char* path);
+    size_t read(uint8_t* data, size_t size) override;
+    void close() override;
+
+private:
+    int _fd = -1;
+};
+#endif // ARDUINO
+
+
+// ==============
+// === REPLAY ===
+// ==============
+
+
+/**
+ * @brief A replayed data message. Text logs give the message exactly as it was logged;
+ * indexed logs give the decoded sample.
+*/
+struct ReplayMessage {
+    const uint8_t* data;    // Text logs - the ASCII message or binary frame, including its terminator
+    size_t size;            // 0 for an indexed log sample
+    xioAPI_Protocol::DataMessageRecord record; // Indexed logs
+    uint64_t timestamp;     // µs
+};
+
+struct ReplayStats {
+    uint32_t messages;      // Messages replayed
+    uint64_t bytes;         // Bytes of text log messages replayed
+    uint32_t errors;        // Lines, frames or blocks that could not be read
+    uint64_t elapsed;       // µs since the first message
+    uint64_t lag;           // µs - the largest delay of a message behind its schedule
+};
+
+/**
+ * @brief Reads a data logger file with streaming I/O and releases its messages at the pace of their
+ * original timestamps, scaled by a speed factor.
+ *
+ * Both log formats are read: text logs (ASCII messages or binary frames, one per line) and
+ * indexed or compressed logs (`xioAPI_Log.h`), which are detected by their file header. Only one
+ * buffer of `XIOAPI_REPLAY_BUFFER_SIZE` bytes is held in memory.
+*/
+class LogReplay {
+public:
+    bool begin(ReplaySource* source, float speed=1.0f);
+    bool next(uint32_t now, ReplayMessage* message);
+    void stop();
+
+    bool isRunning() const { return _source != nullptr; }
+    const ReplayStats& getStats() const { return _stats; }
+    float getMessageRate() const;
+
+private:
+    bool fetch();
+    bool fetchLine();
+    bool fetchRecord();
+    size_t fill(uint8_t* data, size_t size);
+
+    ReplaySource* _source = nullptr;
+    float _speed = 1.0f;
+    bool _indexed = false;
+    uint8_t _buffer[XIOAPI_REPLAY_BUFFER_SIZE];
+    size_t _start = 0;          // Text logs - the first unread byte of `_buffer`
+    size_t _end = 0;
+    xioAPI_Log::BlockReader _block;
+
+    ReplayMessage _message;
+    bool _fetched = false;      // `_message` is waiting for its time
+    bool _started = false;
+    uint64_t _firstTimestamp = 0;
+    uint64_t _clock = 0;        // µs since the first message was released
+    uint32_t _lastNow = 0;
+    xioAPI_Log::TimestampExtender _timestamps; // Text logs have 32-bit timestamps
+    ReplayStats _stats = {0, 0, 0, 0, 0};
+};
+
+#endif // XIOAPI_REPLAY_H
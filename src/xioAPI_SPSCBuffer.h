@@ -0,0 +1,132 @@
+/******************************************************************
+    @file       xioAPI_SPSCBuffer.h
+    @brief      Lock-free single-producer/single-consumer circular buffer
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_SPSC_BUFFER_H
+#define XIOAPI_SPSC_BUFFER_H
+
+#if defined(__AVR__)
+#error "SPSCCircularBuffer requires <atomic>, which is not available on AVR"
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "xioAPI_CircularBuffer.h"
+
+/**
+ * @brief A FIFO circular buffer that one producer and one consumer can use concurrently without locks.
+ *
+ * The producer only writes the tail index and the consumer only writes the head index.
+ * Elements are published with a release store of the tail and acquired by the consumer before
+ * it reads them; space is returned with a release store of the head. Neither side ever waits.
+ *
+ * The API mirrors the FIFO subset of `CircularBuffer` so the two can be swapped:
+ *  - Producer: `push()`
+ *  - Consumer: `shift()`, `spans()`, `consume()`, `clear()`
+ *  - Either: `size()`, `available()`, `isEmpty()`, `isFull()` (a snapshot that may be stale)
+ *
+ * @note The producer cannot overwrite elements the consumer may be reading, so
+ * `CIRCULAR_BUFFER_OVERWRITE` behaves as `CIRCULAR_BUFFER_TRUNCATE`.
+ *
+ * @tparam T The type of the data to store in the buffer.
+ * @tparam S The maximum number of elements that can be stored in the buffer.
+ */
+template<typename T, size_t S> class SPSCCircularBuffer {
+public:
+	static constexpr size_t capacity = S;
+
+	using index_t = size_t;
+
+	struct Span {
+		const T* data;
+		size_t length;
+	};
+
+	constexpr SPSCCircularBuffer();
+
+	/** @private */
+	SPSCCircularBuffer(const SPSCCircularBuffer&) = delete;
+	/** @private */
+	SPSCCircularBuffer(SPSCCircularBuffer&&) = delete;
+	/** @private */
+	SPSCCircularBuffer& operator=(const SPSCCircularBuffer&) = delete;
+	/** @private */
+	SPSCCircularBuffer& operator=(SPSCCircularBuffer&&) = delete;
+
+	/**
+	 * @brief Adds an element to the end of buffer. Producer only.
+	 *
+	 * @return `false` iff the buffer was full and the element was not added.
+	 */
+	bool push(T value);
+
+	/**
+	 * @brief Adds `n` elements to the end of buffer. Producer only.
+	 *
+	 * @return `false` iff any element was not added.
+	 */
+	bool push(const T* values, size_t n);
+
+	/**
+	 * @brief Adds `n` elements to the end of buffer, handling overflow according to `policy`. Producer only.
+	 *
+	 * @return The number of new elements that were not added.
+	 */
+	size_t push(const T* values, size_t n, CircularBufferOverflow policy);
+
+	/**
+	 * @brief Removes an element from the beginning of the buffer. Consumer only.
+	 *
+	 * @return `false` iff the buffer was empty.
+	 */
+	bool shift(T& value);
+
+	/**
+	 * @brief Exposes the readable elements, oldest first, as up to two contiguous spans. Consumer only.
+	 *
+	 * The spans stay valid until they are released with `consume()`.
+	 *
+	 * @return The total number of elements in both spans.
+	 */
+	size_t spans(Span& first, Span& second) const;
+
+	/**
+	 * @brief Releases `n` elements from the beginning of the buffer. Consumer only.
+	 */
+	void consume(size_t n);
+
+	/**
+	 * @brief Discards every readable element. Consumer only.
+	 */
+	void clear();
+
+	size_t size() const;
+	size_t available() const;
+	bool isEmpty() const;
+	bool isFull() const;
+
+private:
+	static constexpr size_t slots = S + 1; // One slot is always left empty to tell full from empty
+
+	size_t advance(size_t index, size_t n) const { return index + n >= slots ? index + n - slots : index + n; }
+
+	T buffer[slots];
+	std::atomic<size_t> head;	// Next element to read, written by the consumer
+	std::atomic<size_t> tail;	// Next slot to write, written by the producer
+};
+
+#include "xioAPI_SPSCBuffer.tpp"
+#endif // XIOAPI_SPSC_BUFFER_H
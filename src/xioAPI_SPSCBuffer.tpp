@@ -0,0 +1,118 @@
+/******************************************************************
+    @file       xioAPI_SPSCBuffer.tpp
+    @brief      Lock-free single-producer/single-consumer circular buffer
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+template<typename T, size_t S>
+constexpr SPSCCircularBuffer<T,S>::SPSCCircularBuffer() :
+		buffer(), head(0), tail(0) {
+}
+
+template<typename T, size_t S>
+bool SPSCCircularBuffer<T,S>::push(T value) {
+	return push(&value, 1, CIRCULAR_BUFFER_REJECT) == 0;
+}
+
+template<typename T, size_t S>
+bool SPSCCircularBuffer<T,S>::push(const T* values, size_t n) {
+	return push(values, n, CIRCULAR_BUFFER_TRUNCATE) == 0;
+}
+
+template<typename T, size_t S>
+size_t SPSCCircularBuffer<T,S>::push(const T* values, size_t n, CircularBufferOverflow policy) {
+	size_t t = tail.load(std::memory_order_relaxed);			// Only the producer writes the tail
+	size_t h = head.load(std::memory_order_acquire);			// Slots before the head have been read
+	size_t free = (h + slots - t - 1) % slots;
+
+	size_t lost = 0;
+	if (n > free) {
+		if (policy == CIRCULAR_BUFFER_REJECT) {
+			return n;
+		}
+		lost = n - free;
+		n = free;
+	}
+	if (n == 0) return lost;
+
+	size_t first = slots - t;
+	if (first > n) {
+		first = n;
+	}
+	for (size_t i = 0; i < first; i++) {
+		buffer[t + i] = values[i];
+	}
+	for (size_t i = first; i < n; i++) {
+		buffer[i - first] = values[i];
+	}
+
+	tail.store(advance(t, n), std::memory_order_release);		// Publish the elements to the consumer
+	return lost;
+}
+
+template<typename T, size_t S>
+bool SPSCCircularBuffer<T,S>::shift(T& value) {
+	size_t h = head.load(std::memory_order_relaxed);			// Only the consumer writes the head
+	if (h == tail.load(std::memory_order_acquire)) return false;
+	value = buffer[h];
+	head.store(advance(h, 1), std::memory_order_release);		// Return the slot to the producer
+	return true;
+}
+
+template<typename T, size_t S>
+size_t SPSCCircularBuffer<T,S>::spans(Span& first, Span& second) const {
+	size_t h = head.load(std::memory_order_relaxed);
+	size_t t = tail.load(std::memory_order_acquire);
+	size_t n = (t + slots - h) % slots;
+	size_t contiguous = slots - h;
+
+	first.data = buffer + h;
+	first.length = n < contiguous ? n : contiguous;
+	second.data = buffer;
+	second.length = n - first.length;
+	return n;
+}
+
+template<typename T, size_t S>
+void SPSCCircularBuffer<T,S>::consume(size_t n) {
+	size_t h = head.load(std::memory_order_relaxed);
+	size_t readable = (tail.load(std::memory_order_acquire) + slots - h) % slots;
+	if (n > readable) {
+		n = readable;
+	}
+	head.store(advance(h, n), std::memory_order_release);
+}
+
+template<typename T, size_t S>
+void SPSCCircularBuffer<T,S>::clear() {
+	head.store(tail.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+template<typename T, size_t S>
+size_t SPSCCircularBuffer<T,S>::size() const {
+	return (tail.load(std::memory_order_acquire) + slots - head.load(std::memory_order_acquire)) % slots;
+}
+
+template<typename T, size_t S>
+size_t SPSCCircularBuffer<T,S>::available() const {
+	return capacity - size();
+}
+
+template<typename T, size_t S>
+bool SPSCCircularBuffer<T,S>::isEmpty() const {
+	return size() == 0;
+}
+
+template<typename T, size_t S>
+bool SPSCCircularBuffer<T,S>::isFull() const {
+	return size() == capacity;
+}
@@ -0,0 +1,177 @@
+/******************************************************************
+    @file       xioAPI_SettingJSON.cpp
+    @brief      Allocation-free JSON writer for xio API setting messages
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "xioAPI_SettingJSON.h"
+#include <stdio.h>
+#include <string.h>
+
+using namespace xioAPI_Types;
+
+namespace xioAPI_SettingJSON {
+
+namespace {
+
+bool appendJSON(char** p, const char* end, const char* text, size_t len) {
+    if ((size_t) (end - *p) < len) return false;
+    memcpy(*p, text, len);
+    *p += len;
+    return true;
+}
+
+bool appendJSONFloat(char** p, const char* end, float value) {
+    if (!(value - value == 0)) return appendJSON(p, end, "null", 4); // NaN or infinity, which JSON cannot represent
+    char number[24];
+    int len = snprintf(number, sizeof(number), "%.9g", value); // Enough digits to read back the same float
+    return len > 0 && appendJSON(p, end, number, len);
+}
+
+bool appendJSONString(char** p, const char* end, const char* text, size_t maxLen) {
+    if (!appendJSON(p, end, "\"", 1)) return false;
+    for (size_t i=0; i<maxLen && text[i] != '\0'; i++) {
+        char c = text[i];
+        char escape[7];
+        if (c == '"' || c == '\\') {
+            escape[0] = '\\';
+            escape[1] = c;
+            if (!appendJSON(p, end, escape, 2)) return false;
+        }
+        else if ((uint8_t) c < 0x20) {
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            if (!appendJSON(p, end, escape, 6)) return false;
+        }
+        else if (!appendJSON(p, end, &c, 1)) {
+            return false;
+        }
+    }
+    return appendJSON(p, end, "\"", 1);
+}
+}
+
+
+// ========================
+// === SETTING MESSAGES ===
+// ========================
+
+
+/**
+ * @brief Writes a setting as a `"key":value` object member
+ * 
+ * @return The length of the member, or 0 if it does not fit in the buffer or the setting type is unknown
+*/
+size_t writeSettingMember(char* out, size_t size, const settingTableEntry* entry) {
+    char* p = out;
+    const char* end = out + size;
+    const float* array;
+    size_t count;
+    char number[12];
+    bool ok = appendJSONString(&p, end, entry->key, SIZE_MAX) && appendJSON(&p, end, ":", 1);
+
+    switch (entry->type) {
+        case BOOL:
+            ok = ok && (*(bool*) entry->value ? appendJSON(&p, end, "true", 4) : appendJSON(&p, end, "false", 5));
+            break;
+        case CHAR:
+            ok = ok && appendJSON(&p, end, number, snprintf(number, sizeof(number), "%u", *(uint8_t*) entry->value));
+            break;
+        case INT:
+            ok = ok && appendJSON(&p, end, number, snprintf(number, sizeof(number), "%d", *(int*) entry->value));
+            break;
+        case FLOAT:
+            ok = ok && appendJSONFloat(&p, end, *(float*) entry->value);
+            break;
+        case VECTOR:
+        case MATRIX:
+            array = entry->type == VECTOR ? static_cast<xioVector*>(entry->value)->array : &static_cast<xioMatrix*>(entry->value)->array[0][0];
+            count = entry->type == VECTOR ? 3 : 9;
+            ok = ok && appendJSON(&p, end, "[", 1);
+            for (size_t i=0; i<count; i++) {
+                ok = ok && (i == 0 || appendJSON(&p, end, ",", 1)) && appendJSONFloat(&p, end, array[i]);
+            }
+            ok = ok && appendJSON(&p, end, "]", 1);
+            break;
+        case CHAR_ARRAY:
+            ok = ok && appendJSONString(&p, end, (const char*) entry->value, entry->len);
+            break;
+        default:
+            return 0;
+    }
+    return ok ? p - out : 0;
+}
+
+/**
+ * @brief Writes a setting as a `{"key":value}` setting message, without a terminator.
+ * This is the single formatter of setting messages, used by `sendSetting()` and `sendSettingTable()`.
+ * 
+ * @param out The buffer to write to
+ * @param size The size of the buffer
+ * 
+ * @return The length of the message, or 0 if it does not fit in the buffer or the setting type is unknown
+*/
+size_t writeSettingJSON(char* out, size_t size, const settingTableEntry* entry) {
+    if (size < 2) return 0;
+    out[0] = '{';
+    size_t len = writeSettingMember(out + 1, size - 2, entry);
+    if (len == 0) return 0;
+    out[len + 1] = '}';
+    return len + 2;
+}
+
+/**
+ * @brief Writes the settings of a setting table as a JSON configuration file, one member per line.
+ * Each member is written to `write` as soon as it is formatted, so only one setting is held in memory.
+ * Settings of an unknown type are left out.
+ * 
+ * @param table The setting table. Entries without a key are skipped.
+ * @param count The number of entries of the table
+ * @param write Called with each part of the file, in order. Returns `false` to stop writing.
+ * @param context Passed to `write`
+ * 
+ * @return `false` if `write` failed
+*/
+bool writeConfigurationJSON(const settingTableEntry* table, size_t count, ConfigurationWriter write, void* context) {
+    char part[XIOAPI_SETTING_MESSAGE_SIZE];
+    size_t members = 0;
+    if (!write("{", 1, context)) return false;
+
+    for (size_t i=0; i<count; i++) {
+        if (table[i].key == nullptr) continue;
+
+        const char* separator = members == 0 ? "\n    " : ",\n    ";
+        size_t len = strlen(separator);
+        memcpy(part, separator, len);
+        size_t memberLen = writeSettingMember(part + len, sizeof(part) - len, &table[i]);
+        if (memberLen == 0) continue;
+        if (!write(part, len + memberLen, context)) return false;
+        members++;
+    }
+    return write("\n}", 2, context);
+}
+
+/**
+ * @brief Appends a setting message and its CRLF terminator to the batch
+ * 
+ * @return `false` if the message and terminator do not fit in the space left, which leaves the batch unchanged
+*/
+bool SettingBatch::add(const settingTableEntry* entry) {
+    if (_capacity - _len < 3) return false; // No room for a message as well as the terminator
+    size_t messageLen = writeSettingJSON(_buffer + _len, _capacity - _len - 2, entry);
+    if (messageLen == 0) return false;
+    _len += messageLen;
+    _buffer[_len++] = '\r';
+    _buffer[_len++] = '\n';
+    return true;
+}
+
+} // namespace xioAPI_SettingJSON
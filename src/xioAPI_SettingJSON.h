@@ -0,0 +1,56 @@
+/******************************************************************
+    @file       xioAPI_SettingJSON.h
+    @brief      Allocation-free JSON writer for xio API setting messages
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_SETTING_JSON_H
+#define XIOAPI_SETTING_JSON_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "xioAPI_Types.h"
+
+#define XIOAPI_SETTING_MESSAGE_SIZE 512 // Bytes - the longest {"key":value} setting message, with room for escaped strings
+
+namespace xioAPI_SettingJSON {
+
+typedef bool (*ConfigurationWriter)(const char* data, size_t size, void* context);
+
+size_t writeSettingMember(char* out, size_t size, const xioAPI_Types::settingTableEntry* entry);
+size_t writeSettingJSON(char* out, size_t size, const xioAPI_Types::settingTableEntry* entry);
+bool writeConfigurationJSON(const xioAPI_Types::settingTableEntry* table, size_t count, ConfigurationWriter write, void* context);
+
+/**
+ * @brief Packs CRLF-terminated setting messages into a buffer, such as one datagram of a `readAll` response
+*/
+class SettingBatch {
+public:
+    SettingBatch(char* buffer, size_t capacity) : _buffer(buffer), _capacity(capacity) {}
+
+    bool add(const xioAPI_Types::settingTableEntry* entry);
+    void clear() { _len = 0; }
+
+    const char* data() const { return _buffer; }
+    size_t size() const { return _len; }
+    bool isEmpty() const { return _len == 0; }
+
+private:
+    char* _buffer;
+    size_t _capacity;
+    size_t _len = 0;
+};
+
+} // namespace xioAPI_SettingJSON
+
+#endif // XIOAPI_SETTING_JSON_H
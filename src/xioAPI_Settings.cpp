@@ -25,7 +25,6 @@
 #include "xioAPI_Settings.h"
 
 File _file;
-StaticJsonDocument<6144> _jsonConfigDoc;
 device_settings_t settings;
 bool _factoryMode = false;
 settingTableEntry settingTable[SETTING_TABLE_SIZE] = {
@@ -108,125 +107,374 @@ settingTableEntry settingTable[SETTING_TABLE_SIZE] = {
     {"temperatureMessageRateDivisor", TEMPERATURE_MESSAGE_RATE_DIVISOR, &settings.temperatureMessageRateDivisor, INT},
     {"batteryMessageRateDivisor", BATTERY_MESSAGE_RATE_DIVISOR, &settings.batteryMessageRateDivisor, INT},
     {"rssiMessageRateDivisor", RSSI_MESSAGE_RATE_DIVISOR, &settings.rssiMessageRateDivisor, INT},
+    {"inertialDecimationFilterOrder", INERTIAL_DECIMATION_FILTER_ORDER, &settings.inertialDecimationFilterOrder, INT},
+    {"magnetometerDecimationFilterOrder", MAGNETOMETER_DECIMATION_FILTER_ORDER, &settings.magnetometerDecimationFilterOrder, INT},
+    {"highGAccelerometerDecimationFilterOrder", HIGHG_ACCELEROMETER_DECIMATION_FILTER_ORDER, &settings.highGAccelerometerDecimationFilterOrder, INT},
 };
+uint16_t _settingIndex[XIOAPI_KEY_SLOTS]; // Setting table position + 1 of each key slot, 0 if empty
+bool _settingIndexed = false;
+uint8_t _settingDirty[(SETTING_TABLE_SIZE + 7) / 8]; // One bit per setting table entry changed since the last save
+bool _savePending = false;
+uint32_t _saveDeadline = 0;
+#if defined(ARDUINO) && defined(XIOAPI_USE_EEPROM)
+xioAPI_Snapshot::EEPROMSnapshotStorage _eepromSnapshot(XIOAPI_SNAPSHOT_EEPROM_ADDRESS);
+xioAPI_Snapshot::SnapshotStorage* _snapshotStorage = &_eepromSnapshot;
+#else
+xioAPI_Snapshot::SnapshotStorage* _snapshotStorage = nullptr;
+#endif // defined(ARDUINO) && defined(XIOAPI_USE_EEPROM)
 
+static bool getFileStamp(const char* filename, uint32_t* size, uint32_t* stamp);
+static bool writeSnapshot(uint32_t fileSize, uint32_t fileStamp);
+
+static void setSettingDirty(const settingTableEntry* entry, bool dirty) {
+    size_t i = entry - settingTable;
+    if (i >= SETTING_TABLE_SIZE) return; // Not in the setting table
+    if (dirty) _settingDirty[i / 8] |= 1 << (i % 8);
+    else _settingDirty[i / 8] &= ~(1 << (i % 8));
+}
+
+/**
+ * @brief Loads the settings from a JSON configuration file with `loadConfigurations()`
+ * 
+ * @param checkFile Kept for compatibility. The configuration is no longer held in a JSON document, so
+ * it is always read from `filename`.
+*/
 bool loadConfigurationsFromJSON(bool checkFile, const char* filename) {
-    if (checkFile) {
-        _file = SPIFFS.open(filename, "r");
-        if (!_file) {
-            return false;
-        }
+    (void) checkFile;
+    return loadConfigurations(filename);
+}
 
-        // Read and parse the JSON data
-        DeserializationError error = deserializeJson(_jsonConfigDoc, _file);
-        if (error) {
-            return false;
-        }
+/**
+ * @brief Loads the settings from a JSON configuration file. The file is read in chunks of
+ * `XIOAPI_CONFIG_CHUNK_SIZE` bytes and each setting is applied as soon as it has been read, so the
+ * file is never held in memory as a whole.
+ * 
+ * The settings of `CONFIG_FILE_NAME` are loaded from the settings snapshot instead when it is valid
+ * and was made from the file as it is now (`loadConfigurationsFromSnapshot()`). Otherwise the file is
+ * read and a new snapshot is written from it.
+ * 
+ * Settings loaded from `CONFIG_FILE_NAME` are not marked as changed, so they are not saved again.
+ * If the configuration file is missing but a complete temporary file from an interrupted save
+ * (`CONFIG_TEMP_FILE_NAME`) exists, the temporary file is restored first.
+ * 
+ * @return `false` if the file cannot be opened, is incomplete, or has malformed settings.
+ * The settings read before an error are still applied.
+*/
+bool loadConfigurations(const char* filename) {
+    bool configFile = strcmp(filename, CONFIG_FILE_NAME) == 0;
+    if (configFile && !SPIFFS.exists(CONFIG_FILE_NAME) && SPIFFS.exists(CONFIG_TEMP_FILE_NAME)) {
+        SPIFFS.rename(CONFIG_TEMP_FILE_NAME, CONFIG_FILE_NAME); // A save was interrupted after its file was complete
+    }
 
-        // Close the file
-        _file.close();
+    if (configFile && loadConfigurationsFromSnapshot()) {
+        return true;
     }
 
-    JsonObject root = _jsonConfigDoc.as<JsonObject>();
+    File file = SPIFFS.open(filename, "r");
+    if (!file) {
+        return false;
+    }
 
-    for (JsonPair kv : root) {
-        unsigned long _jsonKeyHash = hash(kv.key().c_str());
-        for (size_t i=0; i<SETTING_TABLE_SIZE; i++) { // Check all keys in the hash table
-            if (_jsonKeyHash == settingTable[i].hash) {
-                updateSetting(&settingTable[i], kv.value());
-                break;
-            }
+    xioAPI_Command::ObjectReader reader;
+    xioAPI_Command::Command member;
+    reader.reset();
+
+    uint8_t chunk[XIOAPI_CONFIG_CHUNK_SIZE];
+    size_t len;
+    while (!reader.isComplete() && (len = file.read(chunk, sizeof(chunk))) > 0) {
+        for (size_t i=0; i<len; i++) {
+            if (!reader.read((char) chunk[i], &member)) continue;
+            settingTableEntry* entry = getSettingEntry(member.hash);
+            if (entry == nullptr) continue; // Unknown keys are ignored
+            updateSetting(entry, member.value);
+            if (configFile) setSettingDirty(entry, false); // The setting matches the file
         }
     }
+    uint32_t fileSize = file.size();
+    uint32_t fileStamp = file.getLastWrite();
+    file.close();
 
-    // Clear the JSON buffer
-    // _jsonConfigDoc.clear();
-    return true;
+    bool loaded = reader.isComplete() && reader.getErrors() == 0;
+    if (loaded && configFile) writeSnapshot(fileSize, fileStamp); // Replace the missing or stale snapshot
+    return loaded;
 }
 
+static bool writeConfigurationFile(const char* data, size_t size, void* context) {
+    return static_cast<File*>(context)->write((const uint8_t*) data, size) == size;
+}
+
+/**
+ * @brief Saves the settings to `CONFIG_FILE_NAME`.
+ * The settings are written to `CONFIG_TEMP_FILE_NAME` first, which replaces the configuration file only
+ * once it is complete, so an interrupted save never leaves a partial configuration file.
+ * 
+ * @return `false` if the file could not be written
+*/
 bool saveConfigurations() {
-    _file = SPIFFS.open(CONFIG_FILE_NAME, "w");
+    _savePending = false;
+    _file = SPIFFS.open(CONFIG_TEMP_FILE_NAME, "w");
 
     if (!_file) {
         return false;
     }
 
-    JsonObject root = _jsonConfigDoc.as<JsonObject>();
+    // Write the settings straight from the setting table to the file
+    if (!xioAPI_SettingJSON::writeConfigurationJSON(settingTable, SETTING_TABLE_SIZE, writeConfigurationFile, &_file)) {
+        _file.close();
+        SPIFFS.remove(CONFIG_TEMP_FILE_NAME);
+        return false;
+    }
 
-    for (size_t i=0; i<SETTING_TABLE_SIZE; i++) {
-        settingTableEntry entry = settingTable[i];
-        const char* key = entry.key;
-        
-        if (key == nullptr) continue; // Skip past the rest of the loop if the key (entry) is empty
-
-        // Determine the value type and add it to the JSON object
-        xioMatrix* _matrix;
-        xioVector* _vector;
-        JsonArray jsonArray;
-        
-        switch (entry.type) {
-            case INT:
-                root[key] = *(int*)entry.value;
-                break;
-            case FLOAT:
-                root[key] = *(float*)entry.value;
-                break;
-            case BOOL:
-                root[key] = *(bool*)entry.value;
-                break;
-            case CHAR:
-                root[key] = *(uint8_t*)entry.value;
-                break;
-            case VECTOR:
-                jsonArray = root.createNestedArray(key);
-                _vector = static_cast<xioVector*>(entry.value);
-                for (size_t i=0; i<3; i++) {
-                    jsonArray.add(_vector->array[i]);
-                }
-                break;
-            case MATRIX:
-                jsonArray = root.createNestedArray(key);
-                _matrix = static_cast<xioMatrix*>(entry.value);
-                for (size_t i=0; i<9; i++) {
-                    jsonArray.add(_matrix->array[i/3][i%3]);
-                }
-                break;
-            case CHAR_ARRAY:
-                root[key] = (const char*)entry.value;
-                break;
-            default:
-                // TODO: Error handling
-                break;
-        }
+    // Close the file and empty buffer
+    _file.close();
+
+    // Replace the configuration file. SPIFFS cannot rename over an existing file; if the save is
+    // interrupted between these steps, `loadConfigurations()` restores the temporary file.
+    SPIFFS.remove(CONFIG_FILE_NAME);
+    if (!SPIFFS.rename(CONFIG_TEMP_FILE_NAME, CONFIG_FILE_NAME)) {
+        return false;
     }
 
+    memset(_settingDirty, 0, sizeof(_settingDirty));
+    uint32_t fileSize, fileStamp;
+    if (getFileStamp(CONFIG_FILE_NAME, &fileSize, &fileStamp)) {
+        writeSnapshot(fileSize, fileStamp); // A snapshot that cannot be written is invalidated, so the file is read next time
+    }
+    return true;
+}
 
-    // Serialize the JSON document to the file
-    if (!serializeJson(_jsonConfigDoc, _file)) {
-        Serial.println("Failed to serialize JSON");
+/**
+ * @brief Requests a save of the settings, as the `save` command does. Unlike `saveConfigurations()`, the
+ * file is only written if a setting has changed since it was loaded or last saved (`markSettingDirty()`).
+ * With a delay, the save is written by `serviceConfigurations()` once no other save has been requested
+ * for `delay` ms, so a burst of setting writes and saves is written to flash once.
+ * 
+ * @param delay ms, 0 to save immediately
+*/
+void requestSaveConfigurations(uint32_t delay) {
+    if (delay == 0) {
+        if (getDirtySettingCount() > 0) saveConfigurations();
+        return;
+    }
+    _savePending = true;
+    _saveDeadline = millis() + delay;
+}
+
+/**
+ * @brief Writes a requested save once its delay has expired. Call this regularly, e.g. from `loop()`
+ * 
+ * @return `true` if the settings were saved
+*/
+bool serviceConfigurations() {
+    if (!_savePending || (int32_t) (millis() - _saveDeadline) < 0) {
+        return false;
+    }
+    if (getDirtySettingCount() == 0) { // Nothing to write
+        _savePending = false;
         return false;
     }
+    return saveConfigurations();
+}
 
-    // Close the file and empty buffer
-    _file.close();
+/**
+ * @brief Sets where the settings snapshot is kept, or `nullptr` to only use the configuration file.
+ * There is no snapshot by default. With `XIOAPI_USE_EEPROM` defined, it is kept in EEPROM at `XIOAPI_SNAPSHOT_EEPROM_ADDRESS`.
+ * Call this before `loadConfigurations()`, and keep `storage` alive for as long as it is used.
+*/
+void setSnapshotStorage(xioAPI_Snapshot::SnapshotStorage* storage) {
+    _snapshotStorage = storage;
+}
 
+/**
+ * @return The size of a setting value in memory, or the capacity of a character array
+*/
+static size_t getSettingSize(const settingTableEntry* entry) {
+    switch (entry->type) {
+        case BOOL:          return sizeof(bool);
+        case CHAR:          return sizeof(uint8_t);
+        case FLOAT:         return sizeof(float);
+        case INT:           return sizeof(int);
+        case VECTOR:        return sizeof(xioVector);
+        case MATRIX:        return sizeof(xioMatrix);
+        case CHAR_ARRAY:    return entry->len;
+        default:            return 0;
+    }
+}
+
+/**
+ * @brief Finds the size and last write time of a file, which tie the settings snapshot to the
+ * configuration file. Neither needs the file to be read.
+ * 
+ * @return `false` if the file cannot be opened
+*/
+static bool getFileStamp(const char* filename, uint32_t* size, uint32_t* stamp) {
+    File file = SPIFFS.open(filename, "r");
+    if (!file) return false;
+
+    *size = file.size();
+    *stamp = file.getLastWrite();
+    file.close();
     return true;
 }
 
+/**
+ * @brief Loads the settings from the settings snapshot with a single read. The snapshot is only used if
+ * it was made from `CONFIG_FILE_NAME` as it is now: the size and last write time of the file must match
+ * the ones stored in the snapshot, so a file that was edited or replaced (e.g. by a new file system
+ * image) is read instead. The file itself is not read.
+ * 
+ * @return `false` if there is no valid snapshot of the current configuration file, or it is stale: a
+ * setting of the setting table is missing from it or has changed type. The settings of a stale snapshot
+ * are still applied.
+*/
+bool loadConfigurationsFromSnapshot() {
+    if (_snapshotStorage == nullptr) return false;
+
+    uint8_t data[XIOAPI_SNAPSHOT_MAX_SIZE];
+    xioAPI_Snapshot::SnapshotReader reader;
+    if (!reader.open(data, _snapshotStorage->read(data, sizeof(data)))) {
+        return false;
+    }
+
+    uint32_t fileSize, fileStamp;
+    if (!getFileStamp(CONFIG_FILE_NAME, &fileSize, &fileStamp) || fileSize != reader.getSourceSize() || fileStamp != reader.getSourceStamp()) {
+        return false; // The snapshot is not of the current configuration file
+    }
+
+    xioAPI_Snapshot::SnapshotField field;
+    size_t loaded = 0;
+    while (reader.next(&field)) {
+        settingTableEntry* entry = getSettingEntry(field.hash);
+        if (entry == nullptr || field.type != entry->type) continue; // Removed or changed setting
+
+        size_t size = getSettingSize(entry);
+        if (entry->type == CHAR_ARRAY) {
+            if (field.size >= size) continue;
+            memcpy(entry->value, field.value, field.size);
+            static_cast<char*>(entry->value)[field.size] = '\0';
+        }
+        else {
+            if (field.size != size) continue;
+            memcpy(entry->value, field.value, size);
+        }
+        setSettingDirty(entry, false);
+        loaded++;
+    }
+
+    size_t settingCount = 0;
+    for (size_t i=0; i<SETTING_TABLE_SIZE; i++) {
+        if (settingTable[i].key != nullptr) settingCount++;
+    }
+    return loaded == settingCount;
+}
+
+/**
+ * @brief Writes every setting of the setting table to the settings snapshot, as a copy of
+ * `CONFIG_FILE_NAME`. Only call this when the settings match the configuration file.
+ * 
+ * @return `false` if there is no snapshot storage or configuration file, or the snapshot could not be
+ * written, in which case the snapshot is invalidated
+*/
+bool saveConfigurationsToSnapshot() {
+    if (_snapshotStorage == nullptr) return false;
+
+    uint32_t fileSize, fileStamp;
+    if (!getFileStamp(CONFIG_FILE_NAME, &fileSize, &fileStamp)) return false;
+    return writeSnapshot(fileSize, fileStamp);
+}
+
+/**
+ * @brief Writes the settings snapshot of a configuration file of the given size and last write time.
+ * Values are stored as they are in memory; character arrays are stored without their unused capacity.
+ * If the snapshot cannot be written, the old snapshot is invalidated so that it is never loaded in
+ * place of the file.
+*/
+static bool writeSnapshot(uint32_t fileSize, uint32_t fileStamp) {
+    if (_snapshotStorage == nullptr) return false;
+
+    uint8_t data[XIOAPI_SNAPSHOT_MAX_SIZE];
+    xioAPI_Snapshot::SnapshotWriter writer(data, sizeof(data));
+    writer.setSource(fileSize, fileStamp);
+    for (size_t i=0; i<SETTING_TABLE_SIZE; i++) {
+        const settingTableEntry* entry = &settingTable[i];
+        if (entry->key == nullptr) continue; // Skip empty entries
+
+        size_t size = entry->type == CHAR_ARRAY ? strnlen((const char*) entry->value, entry->len - 1) : getSettingSize(entry);
+        writer.add(entry->hash, entry->type, entry->value, size);
+    }
+
+    size_t size = writer.finish();
+    if (size > 0 && _snapshotStorage->write(data, size)) return true;
+
+    memset(data, 0, XIOAPI_SNAPSHOT_HEADER_SIZE); // No magic, so the reader rejects it
+    _snapshotStorage->write(data, XIOAPI_SNAPSHOT_HEADER_SIZE);
+    return false;
+}
+
+/**
+ * @brief Marks a setting as changed since the settings were last saved
+*/
+void markSettingDirty(const settingTableEntry* entry) {
+    setSettingDirty(entry, true);
+}
+
+bool isSettingDirty(const settingTableEntry* entry) {
+    size_t i = entry - settingTable;
+    return i < SETTING_TABLE_SIZE && (_settingDirty[i / 8] >> (i % 8) & 1);
+}
+
+/**
+ * @return The number of settings changed since the settings were last saved
+*/
+size_t getDirtySettingCount() {
+    size_t count = 0;
+    for (size_t i=0; i<sizeof(_settingDirty); i++) {
+        for (uint8_t bits = _settingDirty[i]; bits != 0; bits &= bits - 1) count++;
+    }
+    return count;
+}
+
 settingTableEntry* getSettingEntry(const char* key) {
-    unsigned long _hash = hash(key);
-    return getSettingEntry(_hash);
+    return getSettingEntry(hash(key));
 }
 
+/**
+ * @brief Finds a setting by its key hash. Each API key has its own slot of the index (`getKeySlot()`),
+ * so this is a single probe; only settings added to the table by the user can share a slot, and they
+ * continue to the following slots.
+ * 
+ * @return The setting table entry, or `nullptr` if the key is not a setting
+*/
 settingTableEntry* getSettingEntry(unsigned long hash) {
-    for (size_t i=0; i<SETTING_TABLE_SIZE; i++) {
-        if (settingTable[i].key == nullptr) continue; // Check if the setting table entry is empty
-        if (settingTable[i].hash == hash) return &settingTable[i];
+    if (!_settingIndexed) indexSettingTable();
+
+    for (uint32_t slot = getKeySlot(hash); _settingIndex[slot] != 0; slot = (slot + 1) & (XIOAPI_KEY_SLOTS - 1)) {
+        settingTableEntry* entry = &settingTable[_settingIndex[slot] - 1];
+        if ((uint32_t) entry->hash == (uint32_t) hash) return entry;
     }
     return nullptr;
 }
 
-void updateSetting(const settingTableEntry* entry, JsonVariant newValue) {
+/**
+ * @brief Builds the key index of the setting table. It is built on the first lookup, and must be
+ * rebuilt if entries are added to the table after that.
+*/
+void indexSettingTable() {
+    memset(_settingIndex, 0, sizeof(_settingIndex));
+    for (size_t i=0; i<SETTING_TABLE_SIZE; i++) {
+        if (settingTable[i].key == nullptr) continue; // Skip empty entries
+        uint32_t slot = getKeySlot(settingTable[i].hash);
+        while (_settingIndex[slot] != 0) slot = (slot + 1) & (XIOAPI_KEY_SLOTS - 1);
+        _settingIndex[slot] = i + 1;
+    }
+    _settingIndexed = true;
+}
+
+/**
+ * @return `true` if the setting changed
+*/
+template <typename Value>
+static bool applySetting(const settingTableEntry* entry, const Value& newValue) {
     bool* boolPtr;
     uint8_t* uint8Ptr;
     char* charPtr;
@@ -234,43 +482,53 @@ void updateSetting(const settingTableEntry* entry, JsonVariant newValue) {
     int* intPtr;
     xioVector* vectorPtr;
     xioMatrix* matrixPtr;
+    bool changed = false;
 
     switch (entry->type) {
         case BOOL: 
             boolPtr = static_cast<bool*>(entry->value); // Cast the value pointer to bool*
-            *boolPtr = newValue.as<bool>(); // Assign the new value to the setting value
-            break;
+            return assignSetting(boolPtr, newValue.template as<bool>()); // Assign the new value to the setting value
         case CHAR: 
             uint8Ptr = static_cast<uint8_t*>(entry->value); // Cast the value pointer to uint8_t*
-            *uint8Ptr = newValue.as<uint8_t>(); // Assign the new value to the setting value
-            break;
+            return assignSetting(uint8Ptr, newValue.template as<uint8_t>()); // Assign the new value to the setting value
         case FLOAT: 
             floatPtr = static_cast<float*>(entry->value); // Cast the value pointer to float*
-            *floatPtr = newValue.as<float>(); // Assign the new value to the setting value
-            break;
+            return assignSetting(floatPtr, newValue.template as<float>()); // Assign the new value to the setting value
         case INT: 
             intPtr = static_cast<int*>(entry->value); // Cast the value pointer to int*
-            *intPtr = newValue.as<int>(); // Assign the new value to the setting value
-            break;
+            return assignSetting(intPtr, newValue.template as<int>()); // Assign the new value to the setting value
         case VECTOR:
             vectorPtr = static_cast<xioVector*>(entry->value); // Cast the value pointer to float*
             for (size_t i=0; i<3; i++) { // Copy the new array values to the setting value
-                vectorPtr->array[i] = newValue[i];
+                changed |= assignSetting(&vectorPtr->array[i], newValue[i].template as<float>());
             }
-            break;
+            return changed;
         case MATRIX:
             matrixPtr = static_cast<xioMatrix*>(entry->value); // Cast the value pointer to float*
             for (size_t i=0; i<9; i++) { // Copy the new array values to the setting value
-                matrixPtr->array[i/3][i%3] = newValue[i];
+                changed |= assignSetting(&matrixPtr->array[i/3][i%3], newValue[i].template as<float>());
             }
-            break;
+            return changed;
         case CHAR_ARRAY:
+            if (newValue.template as<const char*>() == nullptr) return false; // Not a string
             charPtr = static_cast<char*>(entry->value); // Cast the value pointer to char*
-            strncpy(charPtr, newValue, entry->len - 1); // Copy the new value to the setting value
+            if (strncmp(charPtr, newValue.template as<const char*>(), entry->len - 1) == 0) return false;
+            strncpy(charPtr, newValue.template as<const char*>(), entry->len - 1); // Copy the new value to the setting value
             charPtr[entry->len - 1] = '\0'; // Null-terminate the string
-            break;
+            return true;
         default:
-            return;
+            return false;
     }
 }
 
+void updateSetting(const settingTableEntry* entry, JsonVariant newValue) {
+    if (applySetting(entry, newValue)) markSettingDirty(entry);
+}
+
+/**
+ * @brief Updates a setting from a command value (`xioAPI_Command::parseCommand()`) without going through ArduinoJson
+*/
+void updateSetting(const settingTableEntry* entry, const xioAPI_Command::CommandValue& newValue) {
+    if (applySetting(entry, newValue)) markSettingDirty(entry);
+}
+
@@ -31,12 +31,15 @@
 #include "xioAPI_Types.h"
 #include "xioAPI_Protocol.h"
 #include "xioAPI_Utility.h"
+#include "xioAPI_Command.h"
+#include "xioAPI_Snapshot.h"
+#include "xioAPI_SettingJSON.h"
 
 using namespace xioAPI_Types;
 using namespace xioAPI_Protocol;
 
 #define SETTING_TABLE_SIZE 256
-#define NUM_BASE_SETTINGS 79
+#define NUM_BASE_SETTINGS 82
 
 
 // ===================================
@@ -46,7 +49,7 @@ using namespace xioAPI_Protocol;
 
 #define XIOAPI_USE_SPIFFS   // Use SPIFFS (SPI Flash File System) to store configuration data (default)
 // #define XIOAPI_USE_SD       // Use SD flash storage to store configuration data
-#define XIOAPI_USE_EEPROM   // Use EEPROM (Electronically Eraseable Programmable Read-Only Memory) to store configuration data
+// #define XIOAPI_USE_EEPROM   // Use EEPROM (Electronically Eraseable Programmable Read-Only Memory) to store a binary snapshot of the configuration data
 
 
 #ifdef XIOAPI_USE_SPIFFS
@@ -60,23 +63,20 @@ using namespace xioAPI_Protocol;
 #if defined(XIOAPI_USE_SPIFFS) || defined(XIOAPI_USE_SD)
 #define CONFIG_FILE_NAME "/config.json"
 #define DEFAULT_CONFIG_FILE_NAME "/default.json"
-#define CONFIG_FILE_BUFFER_SIZE 6144 // Bytes - as recommended by the ArduinoJson helper (minimum: 3200)
+#define CONFIG_TEMP_FILE_NAME "/config.tmp" // Written by `saveConfigurations()`, then renamed to `CONFIG_FILE_NAME`
+#ifndef XIOAPI_CONFIG_SAVE_DELAY
+#define XIOAPI_CONFIG_SAVE_DELAY 0 // ms - saves requested within this time of each other are written once
+#endif // XIOAPI_CONFIG_SAVE_DELAY
+#define XIOAPI_CONFIG_CHUNK_SIZE 64 // Bytes - read from the configuration file at a time by `loadConfigurations()`
 #endif // defined(XIOAPI_USE_SPIFFS) || defined(XIOAPI_USE_SD)
 
+#if defined(XIOAPI_USE_EEPROM) && !defined(XIOAPI_SNAPSHOT_EEPROM_ADDRESS)
+#define XIOAPI_SNAPSHOT_EEPROM_ADDRESS 0 // The EEPROM address of the settings snapshot, which takes `XIOAPI_SNAPSHOT_MAX_SIZE` bytes
+#endif // defined(XIOAPI_USE_EEPROM) && !defined(XIOAPI_SNAPSHOT_EEPROM_ADDRESS)
+
 extern File _file; // Create an object to hold the information for the JSON configuration file
-extern StaticJsonDocument<6144> _jsonConfigDoc; // Allocate a buffer to hold the JSON data
 extern bool _factoryMode;
 
-typedef enum {
-    BOOL,
-    CHAR,
-    FLOAT,
-    INT,
-    MATRIX,
-    VECTOR,
-    CHAR_ARRAY
-} SettingType;
-
 
 // ============================
 // === SETTINGS DEFINITIONS ===
@@ -163,32 +163,54 @@ typedef struct device_settings_t {
     int temperatureMessageRateDivisor;
     int batteryMessageRateDivisor;
     int rssiMessageRateDivisor;
+    int inertialDecimationFilterOrder; // 0 drops samples, 1-3 applies a CIC filter of that order before rate division
+    int magnetometerDecimationFilterOrder;
+    int highGAccelerometerDecimationFilterOrder;
 } device_settings_t;
 
 extern device_settings_t settings;
 
-struct settingTableEntry {
-    const char* key;
-    unsigned long hash;
-    void* value;
-    SettingType type;
-    size_t len;
-};
-
 extern settingTableEntry settingTable[SETTING_TABLE_SIZE];
 
 bool loadConfigurationsFromJSON(bool checkFile=false, const char* filename=CONFIG_FILE_NAME);
+bool loadConfigurations(const char* filename=CONFIG_FILE_NAME);
 bool saveConfigurations();
+void requestSaveConfigurations(uint32_t delay=XIOAPI_CONFIG_SAVE_DELAY);
+bool serviceConfigurations();
+
+void setSnapshotStorage(xioAPI_Snapshot::SnapshotStorage* storage);
+bool loadConfigurationsFromSnapshot();
+bool saveConfigurationsToSnapshot();
+
+void markSettingDirty(const settingTableEntry* entry);
+bool isSettingDirty(const settingTableEntry* entry);
+size_t getDirtySettingCount();
 
 settingTableEntry* getSettingEntry(const char* key);
 settingTableEntry* getSettingEntry(unsigned long hash);
+void indexSettingTable();
 
+/**
+ * @brief Reads a scalar setting by its key
+*/
 template <typename T>
 inline T getSetting(const char* key) {
-    if (_jsonConfigDoc.containsKey(key)) {
-        return _jsonConfigDoc[key].as<T>();
+    settingTableEntry* entry = getSettingEntry(key);
+    if (entry == nullptr) return T();
+
+    switch (entry->type) {
+        case BOOL:  return (T) *(bool*) entry->value;
+        case CHAR:  return (T) *(uint8_t*) entry->value;
+        case FLOAT: return (T) *(float*) entry->value;
+        case INT:   return (T) *(int*) entry->value;
+        default:    return T();
     }
-    return T();
+}
+
+template <>
+inline const char* getSetting<const char*>(const char* key) {
+    settingTableEntry* entry = getSettingEntry(key);
+    return entry != nullptr && entry->type == CHAR_ARRAY ? (const char*) entry->value : nullptr;
 }
 
 template<typename T>
@@ -199,12 +221,28 @@ inline bool getSetting<bool>(unsigned long hash) {
     return false;
 }
 
+/**
+ * @brief Assigns a new value to a setting
+ * 
+ * @return `true` if the value changed
+*/
+template<typename T>
+inline bool assignSetting(T* setting, T newValue) {
+    if (*setting == newValue) return false;
+    *setting = newValue;
+    return true;
+}
+
 void updateSetting(const settingTableEntry* entry, JsonVariant newValue);
+void updateSetting(const settingTableEntry* entry, const xioAPI_Command::CommandValue& newValue);
 
+/**
+ * @brief Updates a setting by its key. The key is hashed at run time; for a constant key, pass its
+ * `APIKeyHashASCII` constant or `XIOAPI_KEY_HASH("key")` instead, which are hashed at compile time.
+*/
 template<typename T>
 inline void updateSetting(const char* key, T newValue) {
-    unsigned long _hash = hash(key);
-    updateSetting<T>(_hash, newValue);
+    updateSetting<T>(hash(key), newValue);
 }
 
 template<typename T>
@@ -218,7 +256,7 @@ inline void updateSetting<bool>(unsigned long hash, bool newValue) {
     bool* boolPtr;
     if (_entryPtr->type == BOOL) {
         boolPtr = static_cast<bool*>(_entryPtr->value); // Cast the value pointer to bool*
-        *boolPtr = newValue; // Assign the new value to the setting valueQ
+        if (assignSetting(boolPtr, newValue)) markSettingDirty(_entryPtr);
     }
 }
 
@@ -230,7 +268,7 @@ inline void updateSetting<uint8_t>(unsigned long hash, uint8_t newValue) {
     uint8_t* uint8Ptr;
     if (_entryPtr->type == CHAR) {
         uint8Ptr = static_cast<uint8_t*>(_entryPtr->value); // Cast the value pointer to bool*
-        *uint8Ptr = newValue; // Assign the new value to the setting valueQ
+        if (assignSetting(uint8Ptr, newValue)) markSettingDirty(_entryPtr);
     }
 }
 
@@ -242,7 +280,7 @@ inline void updateSetting<float>(unsigned long hash, float newValue) {
     float* floatPtr;
     if (_entryPtr->type == FLOAT) {
         floatPtr = static_cast<float*>(_entryPtr->value); // Cast the value pointer to bool*
-        *floatPtr = newValue; // Assign the new value to the setting valueQ
+        if (assignSetting(floatPtr, newValue)) markSettingDirty(_entryPtr);
     }
 }
 
@@ -254,7 +292,7 @@ inline void updateSetting<int>(unsigned long hash, int newValue) {
     int* intPtr;
     if (_entryPtr->type == INT) {
         intPtr = static_cast<int*>(_entryPtr->value); // Cast the value pointer to bool*
-        *intPtr = newValue; // Assign the new value to the setting valueQ
+        if (assignSetting(intPtr, newValue)) markSettingDirty(_entryPtr);
     }
 }
 
@@ -264,7 +302,9 @@ inline void updateSetting<xioVector*>(unsigned long hash, xioVector* newValue) {
     if (_entryPtr == nullptr) return;
 
     if (_entryPtr->type == VECTOR) {
+        if (memcmp(_entryPtr->value, newValue, sizeof(xioVector)) == 0) return;
         memcpy(_entryPtr->value, newValue, sizeof(xioVector));
+        markSettingDirty(_entryPtr);
     }
 }
 
@@ -274,7 +314,9 @@ inline void updateSetting<xioMatrix*>(unsigned long hash, xioMatrix* newValue) {
     if (_entryPtr == nullptr) return;
     
     if (_entryPtr->type == MATRIX) {
+        if (memcmp(_entryPtr->value, newValue, sizeof(xioMatrix)) == 0) return;
         memcpy(_entryPtr->value, newValue, sizeof(xioMatrix));
+        markSettingDirty(_entryPtr);
     }
 }
 
@@ -286,8 +328,10 @@ inline void updateSetting<const char*>(unsigned long hash, const char* newValue)
     char* charPtr;
     if (_entryPtr->type == CHAR_ARRAY) {
         charPtr = static_cast<char*>(_entryPtr->value); // Cast the value pointer to char*
+        if (strncmp(charPtr, newValue, _entryPtr->len - 1) == 0) return;
         strncpy(charPtr, newValue, _entryPtr->len - 1); // Copy the new value to the setting value
         charPtr[_entryPtr->len - 1] = '\0'; // Null-terminate the string
+        markSettingDirty(_entryPtr);
     }
 }
 
@@ -0,0 +1,211 @@
+/******************************************************************
+    @file       xioAPI_Snapshot.cpp
+    @brief      Versioned binary snapshot of the device settings for fast loading at boot
+    @author     Braidan Duffy
+    @copyright  MIT License
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modified:   16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Original release
+******************************************************************/
+
+#include "xioAPI_Snapshot.h"
+#include "xioAPI_Log.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // ARDUINO
+
+namespace xioAPI_Snapshot {
+
+namespace {
+
+uint8_t* put16(uint8_t* p, uint16_t value) {
+    *p++ = (uint8_t) value;
+    *p++ = (uint8_t) (value >> 8);
+    return p;
+}
+
+uint8_t* put32(uint8_t* p, uint32_t value) {
+    for (size_t i=0; i<4; i++) {
+        *p++ = (uint8_t) (value >> (8*i));
+    }
+    return p;
+}
+
+uint16_t get16(const uint8_t* p) {
+    return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+uint32_t get32(const uint8_t* p) {
+    uint32_t value = 0;
+    for (size_t i=0; i<4; i++) {
+        value |= (uint32_t) p[i] << (8*i);
+    }
+    return value;
+}
+}
+
+
+// =======================
+// === SNAPSHOT FORMAT ===
+// =======================
+
+
+/**
+ * @brief Adds a field to the snapshot
+ *
+ * @param value The setting value as it is stored in memory
+ *
+ * @return `false` if the field does not fit in the buffer, which fails the snapshot
+*/
+bool SnapshotWriter::add(uint32_t hash, uint8_t type, const void* value, size_t size) {
+    if (size > UINT8_MAX || _count == UINT16_MAX || _len + XIOAPI_SNAPSHOT_FIELD_SIZE + size > _capacity) {
+        _overflow = true;
+        return false;
+    }
+    uint8_t* p = put32(_buffer + _len, hash);
+    *p++ = type;
+    *p++ = (uint8_t) size;
+    memcpy(p, value, size);
+    _len += XIOAPI_SNAPSHOT_FIELD_SIZE + size;
+    _count++;
+    return true;
+}
+
+/**
+ * @brief Writes the header
+ *
+ * @return The size of the snapshot, or 0 if a field did not fit
+*/
+size_t SnapshotWriter::finish() {
+    if (_overflow || _capacity < XIOAPI_SNAPSHOT_HEADER_SIZE) return 0;
+
+    const uint8_t* payload = _buffer + XIOAPI_SNAPSHOT_HEADER_SIZE;
+    uint32_t payloadSize = _len - XIOAPI_SNAPSHOT_HEADER_SIZE;
+    uint8_t* p = put32(_buffer, XIOAPI_SNAPSHOT_MAGIC);
+    p = put16(p, XIOAPI_SNAPSHOT_VERSION);
+    p = put16(p, _count);
+    p = put32(p, payloadSize);
+    p = put32(p, xioAPI_Log::crc32(payload, payloadSize));
+    p = put32(p, _sourceSize);
+    put32(p, _sourceStamp);
+    return _len;
+}
+
+/**
+ * @return `false` if the data is not a complete snapshot of a supported version
+*/
+bool SnapshotReader::open(const uint8_t* data, size_t size) {
+    _data = nullptr;
+    if (size < XIOAPI_SNAPSHOT_HEADER_SIZE || get32(data) != XIOAPI_SNAPSHOT_MAGIC) return false;
+    if (get16(data + 4) != XIOAPI_SNAPSHOT_VERSION) return false;
+
+    uint32_t payloadSize = get32(data + 8);
+    if (payloadSize > size - XIOAPI_SNAPSHOT_HEADER_SIZE) return false; // Truncated
+    if (xioAPI_Log::crc32(data + XIOAPI_SNAPSHOT_HEADER_SIZE, payloadSize) != get32(data + 12)) return false;
+
+    _data = data;
+    _count = get16(data + 6);
+    _sourceSize = get32(data + 16);
+    _sourceStamp = get32(data + 20);
+    _offset = XIOAPI_SNAPSHOT_HEADER_SIZE;
+    _end = XIOAPI_SNAPSHOT_HEADER_SIZE + payloadSize;
+    return true;
+}
+
+/**
+ * @param field The next field, which refers to the snapshot data
+ *
+ * @return `false` at the end of the snapshot
+*/
+bool SnapshotReader::next(SnapshotField* field) {
+    if (_data == nullptr || _offset + XIOAPI_SNAPSHOT_FIELD_SIZE > _end) return false;
+
+    const uint8_t* p = _data + _offset;
+    field->hash = get32(p);
+    field->type = p[4];
+    field->size = p[5];
+    field->value = p + XIOAPI_SNAPSHOT_FIELD_SIZE;
+    if (_offset + XIOAPI_SNAPSHOT_FIELD_SIZE + field->size > _end) return false;
+    _offset += XIOAPI_SNAPSHOT_FIELD_SIZE + field->size;
+    return true;
+}
+
+
+// ===============
+// === STORAGE ===
+// ===============
+
+
+#ifdef ARDUINO
+bool EEPROMSnapshotStorage::begin() {
+    if (!_begun) _begun = EEPROM.begin(_address + _capacity);
+    return _begun;
+}
+
+size_t EEPROMSnapshotStorage::read(uint8_t* data, size_t size) {
+    if (!begin()) return 0;
+    return EEPROM.readBytes(_address, data, size < _capacity ? size : _capacity);
+}
+
+bool EEPROMSnapshotStorage::write(const uint8_t* data, size_t size) {
+    if (size > _capacity || !begin()) return false;
+    return EEPROM.writeBytes(_address, data, size) == size && EEPROM.commit();
+}
+#else
+POSIXSnapshotStorage::POSIXSnapshotStorage(const char* path) {
+    strncpy(_path, path, sizeof(_path) - 1);
+    _path[sizeof(_path) - 1] = '\0';
+}
+
+size_t POSIXSnapshotStorage::read(uint8_t* data, size_t size) {
+    int fd = ::open(_path, O_RDONLY);
+    if (fd < 0) return 0;
+
+    size_t len = 0;
+    while (len < size) {
+        ssize_t n = ::read(fd, data + len, size - len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        len += n;
+    }
+    ::close(fd);
+    return len;
+}
+
+bool POSIXSnapshotStorage::write(const uint8_t* data, size_t size) {
+    char tempPath[XIOAPI_SNAPSHOT_MAX_PATH_LENGTH + 4];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", _path);
+
+    int fd = ::open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = ::write(fd, data + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        written += n;
+    }
+    bool ok = written == size && fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || rename(tempPath, _path) != 0) {
+        unlink(tempPath);
+        return false;
+    }
+    return true;
+}
+#endif // ARDUINO
+
+} // namespace xioAPI_Snapshot
@@ -0,0 +1,158 @@
+/******************************************************************
+    @file       xioAPI_Snapshot.h
+    @brief      Versioned binary snapshot of the device settings for fast loading at boot
+    @author     Braidan Duffy
+    @copyright  MIT license
+
+    Code:       Braidan Duffy
+    Version:    1.0.0
+    Date:       16/10/2026
+    Modifed:    16/10/2026
+
+    CHANGELOG:
+    v1.0.0 - Initial release
+
+******************************************************************/
+
+#ifndef XIOAPI_SNAPSHOT_H
+#define XIOAPI_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef ARDUINO
+#include <EEPROM.h>
+#endif // ARDUINO
+
+/**
+ * Snapshot layout (all fields little-endian):
+ *
+ * | HEADER | FIELD 0 | FIELD 1 | ... |
+ *
+ * Header (24 B): magic "XSET", version, field count, payload size, CRC-32 of the payload,
+ *                size and stamp (e.g. last write time) of the source
+ * Field (6 B + value): key hash, setting type, value size, value
+ *
+ * Fields are keyed by the hash of their API key, so a snapshot stays readable when settings are
+ * added or removed: unknown fields are skipped, and settings without a field are left as they are.
+ *
+ * The source is the file the settings were last loaded from or saved to. A snapshot is only a copy of
+ * its source, so it must not be used once the source has changed (e.g. a new file system image).
+*/
+
+#define XIOAPI_SNAPSHOT_VERSION         2
+#define XIOAPI_SNAPSHOT_MAGIC           0x54455358 // "XSET"
+#define XIOAPI_SNAPSHOT_HEADER_SIZE     24
+#define XIOAPI_SNAPSHOT_FIELD_SIZE      6 // Bytes - before the value
+#define XIOAPI_SNAPSHOT_MAX_SIZE        2048 // Bytes - the largest snapshot, and the EEPROM space reserved for it
+
+namespace xioAPI_Snapshot {
+
+struct SnapshotField {
+    uint32_t hash;
+    uint8_t type;
+    uint8_t size;
+    const uint8_t* value;
+};
+
+/**
+ * @brief Writes a snapshot into a buffer
+*/
+class SnapshotWriter {
+public:
+    SnapshotWriter(uint8_t* buffer, size_t capacity) : _buffer(buffer), _capacity(capacity) {}
+
+    void setSource(uint32_t size, uint32_t stamp) { _sourceSize = size; _sourceStamp = stamp; }
+    bool add(uint32_t hash, uint8_t type, const void* value, size_t size);
+    size_t finish();
+
+private:
+    uint8_t* _buffer;
+    size_t _capacity;
+    size_t _len = XIOAPI_SNAPSHOT_HEADER_SIZE;
+    uint16_t _count = 0;
+    bool _overflow = false;
+    uint32_t _sourceSize = 0;
+    uint32_t _sourceStamp = 0;
+};
+
+/**
+ * @brief Validates a snapshot and iterates over its fields
+*/
+class SnapshotReader {
+public:
+    bool open(const uint8_t* data, size_t size);
+    bool next(SnapshotField* field);
+
+    uint16_t getFieldCount() const { return _count; }
+    uint32_t getSourceSize() const { return _sourceSize; }
+    uint32_t getSourceStamp() const { return _sourceStamp; }
+
+private:
+    const uint8_t* _data = nullptr;
+    size_t _end = 0;
+    size_t _offset = 0;
+    uint16_t _count = 0;
+    uint32_t _sourceSize = 0;
+    uint32_t _sourceStamp = 0;
+};
+
+
+// ===============
+// === STORAGE ===
+// ===============
+
+
+/**
+ * @brief A place that a snapshot is kept, read and written whole
+*/
+class SnapshotStorage {
+public:
+    virtual ~SnapshotStorage() {}
+
+    /** @return The number of bytes read, up to `size`. 0 if there is no snapshot. */
+    virtual size_t read(uint8_t* data, size_t size) = 0;
+
+    virtual bool write(const uint8_t* data, size_t size) = 0;
+};
+
+#ifdef ARDUINO
+/**
+ * @brief Keeps the snapshot in `EEPROM`, which is emulated in flash on the ESP32
+*/
+class EEPROMSnapshotStorage : public SnapshotStorage {
+public:
+    EEPROMSnapshotStorage(size_t address=0, size_t capacity=XIOAPI_SNAPSHOT_MAX_SIZE) : _address(address), _capacity(capacity) {}
+
+    size_t read(uint8_t* data, size_t size) override;
+    bool write(const uint8_t* data, size_t size) override;
+
+private:
+    bool begin();
+
+    size_t _address;
+    size_t _capacity;
+    bool _begun = false;
+};
+#else
+#define XIOAPI_SNAPSHOT_MAX_PATH_LENGTH 128
+
+/**
+ * @brief Keeps the snapshot in a file using POSIX file I/O, for running on a host.
+ * The file is replaced through a temporary file, so a partly written snapshot is never read.
+*/
+class POSIXSnapshotStorage : public SnapshotStorage {
+public:
+    POSIXSnapshotStorage(const char* path);
+
+    size_t read(uint8_t* data, size_t size) override;
+    bool write(const uint8_t* data, size_t size) override;
+
+private:
+    char _path[XIOAPI_SNAPSHOT_MAX_PATH_LENGTH];
+};
+#endif // ARDUINO
+
+} // namespace xioAPI_Snapshot
+
+#endif // XIOAPI_SNAPSHOT_H
@@ -24,6 +24,8 @@
 #ifndef xioAPI_Types_h
 #define xioAPI_Types_h
 
+#include <stddef.h>
+
 namespace xioAPI_Types {
 
 
@@ -200,6 +202,18 @@ typedef enum ahrs_message_type_t {
     EARTH_ACCELERATION
 } ahrs_message_type_t;
 
+typedef enum DataMessageType {
+    INERTIAL_MESSAGE = 0,
+    MAGNETOMETER_MESSAGE,
+    QUATERNION_MESSAGE,
+    EULER_MESSAGE,
+    HIGHG_ACCELEROMETER_MESSAGE,
+    TEMPERATURE_MESSAGE,
+    BATTERY_MESSAGE,
+    RSSI_MESSAGE,
+    NUM_DATA_MESSAGE_TYPES
+} DataMessageType;
+
 typedef enum TokenState {
     START_JSON = 0,
     START_CMD,
@@ -222,6 +236,7 @@ typedef enum ValueType {
     JSON_NUMBER,
     JSON_BOOL,
     JSON_NULL,
+    JSON_ARRAY,
     JSON_UNDEFINED
 } ValueType;
 
@@ -257,5 +272,29 @@ typedef union {
         float zz;
     } element;
 } xioMatrix;
+
+
+// ================
+// === SETTINGS ===
+// ================
+
+
+typedef enum {
+    BOOL,
+    CHAR,
+    FLOAT,
+    INT,
+    MATRIX,
+    VECTOR,
+    CHAR_ARRAY
+} SettingType;
+
+struct settingTableEntry {
+    const char* key;
+    unsigned long hash;
+    void* value;
+    SettingType type;
+    size_t len;
+};
 }
 #endif // xioAPI_Types_h
\ No newline at end of file
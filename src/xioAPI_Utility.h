@@ -24,20 +24,20 @@
 #define XIOAPI_UTILITY_H
 
 /**
- * @brief Converts a string to an unsigned long via the DJB2 hash function
- * @note The hashing function changes depending on architecture.
- * Ensure that similar architectures are used to generate the keys being checked against.
+ * @brief Converts a string to a 32-bit value via the DJB2 hash function.
+ * The result is the same on every architecture and matches `xioAPI_Protocol::hashKey()`, which hashes
+ * constant keys at compile time.
  * 
  * @param str The string to be converted
  * 
- * @return The numerical representation of the given string as an unsigned long
+ * @return The numerical representation of the given string
 */
-inline unsigned long hash(const char *str) {
+inline uint32_t hash(const char *str) {
     //  djb2 Hash Function
-    unsigned long hash = 5381;  
-    int c;
+    uint32_t hash = 5381;
+    uint8_t c;
 
-    while ((c = *str++))
+    while ((c = (uint8_t) *str++))
         hash = ((hash << 5) + hash) + c;
     return hash;
 }